@@ -12,40 +12,117 @@
 #define TERMINAL_HEIGHT 35
 
 #define MEM_PLAYERSTAT 0
-#define MEM_SHOTPOS    25
 #define MEM_SHIPSTAT   60
 
+/* Shots are appended to a sector of their own, a slot each: a used mark and the coordinates */
+#define MEM_SHOTLOG   0x1000
+#define MEM_SHOTSLOT  8
+#define MEM_SHOTSLOTS (4096 / MEM_SHOTSLOT)
+#define MEM_SHOTUSED  0x00
+
+static uint16_t shotSlot = MEM_SHOTSLOTS; /* next free slot, the sector is erased at the first shot after start */
+
+/* Statistics are changed in the flash cache and synced right away, one program of the sector without erase
+ * where bits are only cleared */
 void memoryWriteShipStat(struct packageShip *shipStatistics, uint16_t datLen) {
-    FLASH_Erase(MEM_SHIPSTAT, datLen);
-    if (FLASH_Write((uint8_t *) shipStatistics, MEM_SHIPSTAT, datLen) == FLASH_OK) {
+    if (FLASH_CacheWrite((uint8_t *) shipStatistics, MEM_SHIPSTAT, datLen) == FLASH_OK && FLASH_Sync() == FLASH_OK) {
         LOG_Printf("\n  \033[0;33m>> Ship statistics write - OK!\033[0m");
+    } else {
+        LOG_Printf("\n  \033[0;31m>> Ship statistics write - FAILED!\033[0m");
     }
 }
 
-void memoryWriteShotPos(struct shootCoord *shootCoord, uint16_t datLen) {
-    FLASH_Erase(MEM_SHOTPOS, datLen);
-    if (FLASH_Write((uint8_t *) shootCoord, MEM_SHOTPOS, datLen) == FLASH_OK) {
+static void memoryShotPosWritten(flash_state_t state, void *arg) {
+    (void) arg;
+    if (state == FLASH_OK) {
         LOG_Printf("\n  \033[0;33m>> Coordinates write - OK!\033[0m\n");
+    } else {
+        LOG_Printf("\n  \033[0;31m>> Coordinates write - FAILED!\033[0m\n");
     }
 }
 
+/* Every shot is queued to the next slot, so the game does not wait for the flash and nothing is erased or
+ * rewritten per shot. A full sector gets one native sector erase */
+void memoryWriteShotPos(struct shootCoord *shootCoord, uint16_t datLen) {
+    uint8_t       slot[MEM_SHOTSLOT];
+    flash_state_t state = FLASH_OK;
+
+    if (datLen >= MEM_SHOTSLOT) {
+        LOG_Printf("\n  \033[0;31m>> Coordinates write - FAILED!\033[0m\n");
+        return;
+    }
+    if (shotSlot >= MEM_SHOTSLOTS) {
+        state = FLASH_EraseAsync(MEM_SHOTLOG, MEM_SHOTSLOTS * MEM_SHOTSLOT, NULL, NULL);
+        if (state == FLASH_OK) {
+            shotSlot = 0;
+        }
+    }
+
+    memset(slot, 0xFF, sizeof(slot));
+    slot[0] = MEM_SHOTUSED;
+    memcpy(&slot[1], shootCoord, datLen);
+    if (state == FLASH_OK) {
+        state = FLASH_WriteAsync(slot, MEM_SHOTLOG + shotSlot * MEM_SHOTSLOT, sizeof(slot), memoryShotPosWritten, NULL);
+    }
+    if (state == FLASH_OK) {
+        ++shotSlot;
+    } else {
+        LOG_Printf("\n  \033[0;31m>> Coordinates write - FAILED!\033[0m\n");
+    }
+}
+
+/* Used slots are a prefix of the sector, the first free one is found by its mark */
+static uint16_t memoryFindShotSlot(void) {
+    uint16_t lo = 0, hi = MEM_SHOTSLOTS;
+    uint8_t  mark;
+
+    while (lo < hi) {
+        uint16_t mid = (lo + hi) / 2;
+        if (FLASH_Read(&mark, MEM_SHOTLOG + mid * MEM_SHOTSLOT, 1) != FLASH_OK) {
+            return 0;
+        }
+        if (mark == MEM_SHOTUSED) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
 void memoryWriteStatPlayers(struct packagePlayers *Statistics, uint16_t datLen) {
-    FLASH_Erase(MEM_PLAYERSTAT, datLen);
-    if (FLASH_Write((uint8_t *) Statistics, MEM_PLAYERSTAT, datLen) == FLASH_OK) {
+    if (FLASH_CacheWrite((uint8_t *) Statistics, MEM_PLAYERSTAT, datLen) == FLASH_OK && FLASH_Sync() == FLASH_OK) {
         LOG_Printf("\n  \033[0;33m>> Statistics write - OK!\033[0m");
+    } else {
+        LOG_Printf("\n  \033[0;31m>> Statistics write - FAILED!\033[0m");
     }
 }
 
 void memoryReadShipStat(struct packageShip *shipStatistics, uint16_t datLen) {
-    FLASH_Read((uint8_t *) shipStatistics, MEM_SHIPSTAT, datLen);
+    FLASH_CacheRead((uint8_t *) shipStatistics, MEM_SHIPSTAT, datLen);
 }
 
 void memoryReadShotPos(struct shootCoord *shootCoord, uint16_t datLen) {
-    FLASH_Read((uint8_t *) shootCoord, MEM_SHOTPOS, datLen);
+    uint8_t  slot[MEM_SHOTSLOT];
+    uint16_t last;
+
+    if (FLASH_Flush() != FLASH_OK) {
+        LOG_Printf("\n  \033[0;31m>> Coordinates write - FAILED!\033[0m\n");
+    }
+    last = (shotSlot < MEM_SHOTSLOTS) ? shotSlot : memoryFindShotSlot();
+
+    memset(slot, 0xFF, sizeof(slot));
+    if (last > 0) {
+        FLASH_Read(slot, MEM_SHOTLOG + (last - 1) * MEM_SHOTSLOT, sizeof(slot));
+    }
+    if (slot[0] != MEM_SHOTUSED) {
+        memset(slot, 0xFF, sizeof(slot));
+    }
+    memcpy(shootCoord, &slot[1], (datLen < MEM_SHOTSLOT) ? datLen : MEM_SHOTSLOT - 1);
 }
 
 void memoryReadStatPlayers(struct packagePlayers *Statistics, uint16_t datLen) {
-    FLASH_Read((uint8_t *) Statistics, MEM_PLAYERSTAT, datLen);
+    FLASH_CacheRead((uint8_t *) Statistics, MEM_PLAYERSTAT, datLen);
 }
 
 void statCreate() {
@@ -9,6 +9,7 @@
 #ifndef WEATHER_APP_H_
 #define WEATHER_APP_H_
 
+#include <stdint.h>
 #include <stdio.h>
 
 /**
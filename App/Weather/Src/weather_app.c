@@ -140,15 +140,15 @@ void startWeatherTask(void *argument) {
 
     LOG_INFO("WEATHER APP IS READY");
 
-    FLASH_Read(&currCityArrayLen, 0x3E0000, sizeof(uint8_t));
+    FLASH_CacheRead(&currCityArrayLen, 0x3E0000, sizeof(uint8_t));
     // Check if data is corrupted
     if (currCityArrayLen > 3) {
         eraseWeather();
     }
 
     if (currCityArrayLen != 0) {
-        FLASH_Read((uint8_t *) WEATHER_CityArray, 0x3E0000 + sizeof(uint8_t),
-                   sizeof(struct weather_city_t) * MAX_ARRAY_CITY_SIZE);
+        FLASH_CacheRead((uint8_t *) WEATHER_CityArray, 0x3E0000 + sizeof(uint8_t),
+                        sizeof(struct weather_city_t) * MAX_ARRAY_CITY_SIZE);
         osDelay(100);
 
         viewCity(WEATHER_CityArray, currCityArrayLen);
@@ -463,10 +463,10 @@ void WEATHER_View(uint8_t argc, void **argv) {
 static void flashCity() {
     FLASH_ChangeProtectionStatus(FLASH_BLNONE);
 
-    FLASH_Erase(0x3E0000, sizeof(struct weather_city_t) * MAX_ARRAY_CITY_SIZE + sizeof(uint8_t));
-    FLASH_Write(&currCityArrayLen, 0x3E0000, sizeof(uint8_t));
-    FLASH_Write((uint8_t *) WEATHER_CityArray, 0x3E0000 + sizeof(uint8_t),
-                sizeof(struct weather_city_t) * MAX_ARRAY_CITY_SIZE);
+    /* The length and the array go to the sector in the cache, the protection change programs it */
+    FLASH_CacheWrite(&currCityArrayLen, 0x3E0000, sizeof(uint8_t));
+    FLASH_CacheWrite((uint8_t *) WEATHER_CityArray, 0x3E0000 + sizeof(uint8_t),
+                     sizeof(struct weather_city_t) * MAX_ARRAY_CITY_SIZE);
 
     FLASH_ChangeProtectionStatus(FLASH_BL62to63);
 }
@@ -484,8 +484,7 @@ static void eraseWeather() {
 
     FLASH_ChangeProtectionStatus(FLASH_BLNONE);
 
-    FLASH_Erase(0x3E0000, sizeof(uint8_t));
-    FLASH_Write(&currCityArrayLen, 0x3E0000, sizeof(uint8_t));
+    FLASH_CacheWrite(&currCityArrayLen, 0x3E0000, sizeof(uint8_t));
 
     FLASH_ChangeProtectionStatus(FLASH_BL62to63);
 }
\ No newline at end of file
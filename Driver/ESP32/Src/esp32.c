@@ -296,7 +296,7 @@ esp32_status_t ESP32_httpsClientByURL(char *url, esp32_http_method_t method, esp
         return ESP32_S_ERR_GENERAL;
     }
     tx_mutex_get(&ESP32_FunctionMutex, TX_WAIT_FOREVER);
-    sprintf(bufferAT, "AT+HTTPURLCFG=%d\r\n", strlen(url));
+    sprintf(bufferAT, "AT+HTTPURLCFG=%d\r\n", (int) strlen(url));
     ESP32_SendATCommand(bufferAT);
     if (tx_semaphore_get(&ESP32_PromptSemaphore, 5000) == TX_SUCCESS) {
         ESP32_SendATCommand(url);
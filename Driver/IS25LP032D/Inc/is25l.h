@@ -42,6 +42,11 @@
 
 /**@}*/
 
+/* Page data of IS25L_WritePPQ() by DMA, the interface needs a DMA channel linked (0 - by interrupts) */
+#ifndef IS25L_DMA
+#define IS25L_DMA 0U
+#endif    // IS25L_DMA
+
 /**
  * @defgroup IS25L Flags
  * @brief Flag definitions
@@ -138,6 +143,13 @@ is25l_state_t IS25L_WriteStatusReg(uint8_t reg_buffer);
  **/
 is25l_state_t IS25L_EraseSector(uint32_t RAW_SectorAddress);
 
+/**
+ * @brief Function for erasing 64 KB block
+ * @param RAW_BlockAddress : Block address (hex)
+ * @note This function requires the start address of selected block
+ **/
+is25l_state_t IS25L_EraseBlock(uint32_t RAW_BlockAddress);
+
 /**
  * @brief Function for erasing the whole chip
  **/
@@ -160,6 +172,18 @@ is25l_state_t IS25L_FastReadQUADOperation(uint8_t *FR_Dat_Ptr, uint32_t Addr_sta
  **/
 is25l_state_t IS25L_WritePPQ(uint8_t *buffer, uint32_t RAW_PageAddress, uint16_t data_lenght);
 
+/**
+ * @brief Function for switching the controller to memory-mapped mode, the flash is read by loads
+ * @param base : Address of the flash start in the memory map
+ * @note Other functions fail while the controller is in this mode
+ **/
+is25l_state_t IS25L_MemoryMappedEnable(const uint8_t **base);
+
+/**
+ * @brief Function for switching the controller back to commands
+ **/
+is25l_state_t IS25L_MemoryMappedDisable(void);
+
 /**
  * @brief IS25L Status Callback
  */
@@ -30,4 +30,7 @@
 /* Sector Erase Operation */
 #define IS25L_ERASE_SECTOR_CMD 0x20
 
+/* Block Erase Operation (64 KB) */
+#define IS25L_ERASE_BLOCK_CMD 0xD8
+
 #endif /* CORE_INC_IS25L_REGISTERS_H_ */
\ No newline at end of file
@@ -140,6 +140,7 @@ is25l_state_t IS25L_Init(void) {
 
     if (tx_event_flags_create(&flagIS25L, "IS25L Flag") != TX_SUCCESS) {
         LOG_DEBUG("%s, %d", __FILE__, __LINE__);
+        tx_mutex_delete(&muxIS25L);
         return IS25L_TX_ERR;
     }
 
@@ -147,12 +148,14 @@ is25l_state_t IS25L_Init(void) {
     uint8_t status_reg;
     if (IS25L_ReadStatusReg(&status_reg) != IS25L_OK) {
         LOG_DEBUG("%s, %d", __FILE__, __LINE__);
+        IS25L_Deinit();
         return IS25L_SPI_ERR;
     }
     if (!(status_reg & IS25L_STATUS_QE)) {
         status_reg |= IS25L_STATUS_QE;
         if (IS25L_WriteStatusReg(status_reg) != IS25L_OK) {
             LOG_DEBUG("%s, %d", __FILE__, __LINE__);
+            IS25L_Deinit();
             return IS25L_SPI_ERR;
         }
     }
@@ -339,6 +342,8 @@ is25l_state_t IS25L_WriteStatusReg(uint8_t reg_buffer) {
         goto quit;
     }
 
+    state = IS25L_OK;
+
 quit:
     tx_mutex_put(&muxIS25L);
     return state;
@@ -406,11 +411,11 @@ quit:
     return state;
 }
 
-/* Function for erasing selected sector */
-is25l_state_t IS25L_EraseSector(uint32_t RAW_SectorAddress) {
+/* Sector or block erase, waits for the end of it */
+static is25l_state_t IS25L_EraseOperation(uint8_t instruction, uint32_t RAW_Address) {
     is25l_state_t state = IS25L_SPI_ERR;
 
-    if (RAW_SectorAddress > 0x3FFFFF) {
+    if (RAW_Address > 0x3FFFFF) {
         LOG_DEBUG("%s, %d", __FILE__, __LINE__);
         return IS25L_PARAM_ERR;
     }
@@ -434,10 +439,10 @@ is25l_state_t IS25L_EraseSector(uint32_t RAW_SectorAddress) {
 
     OSPI_RegularCmdTypeDef command = {
         .InstructionMode = HAL_OSPI_INSTRUCTION_1_LINE,
-        .Instruction = IS25L_ERASE_SECTOR_CMD,    // Sector Erase Operation (0x20)
+        .Instruction = instruction,    // Sector (0x20) or Block (0xD8) Erase Operation
         .AddressSize = HAL_OSPI_ADDRESS_24_BITS,
         .AddressMode = HAL_OSPI_ADDRESS_1_LINE,
-        .Address = RAW_SectorAddress,
+        .Address = RAW_Address,
         .AlternateBytesMode = HAL_OSPI_ALTERNATE_BYTES_NONE,
         .AlternateBytes = HAL_OSPI_ALTERNATE_BYTES_NONE,
         .AlternateBytesSize = HAL_OSPI_ALTERNATE_BYTES_NONE,
@@ -466,6 +471,16 @@ quit:
     return state;
 }
 
+/* Function for erasing selected sector */
+is25l_state_t IS25L_EraseSector(uint32_t RAW_SectorAddress) {
+    return IS25L_EraseOperation(IS25L_ERASE_SECTOR_CMD, RAW_SectorAddress);
+}
+
+/* Function for erasing selected 64 KB block */
+is25l_state_t IS25L_EraseBlock(uint32_t RAW_BlockAddress) {
+    return IS25L_EraseOperation(IS25L_ERASE_BLOCK_CMD, RAW_BlockAddress);
+}
+
 is25l_state_t IS25L_FastReadQUADOperation(uint8_t *FR_Dat_Ptr, uint32_t Addr_start, uint16_t data_size) {
     is25l_state_t state = IS25L_SPI_ERR;
 
@@ -568,7 +583,11 @@ is25l_state_t IS25L_WritePPQ(uint8_t *buffer, uint32_t RAW_PageAddress, uint16_t
         goto quit;
     }
 
+#if IS25L_DMA
+    if (HAL_OSPI_Transmit_DMA(&FLASH_QSPI, buffer) != HAL_OK) {
+#else
     if (HAL_OSPI_Transmit_IT(&FLASH_QSPI, buffer) != HAL_OK) {
+#endif
         LOG_DEBUG("%s, %d", __FILE__, __LINE__);
         goto quit;
     }
@@ -582,6 +601,79 @@ quit:
     return state;
 }
 
+/* Function for entering memory-mapped mode, the controller reads by the FRQIO instruction */
+is25l_state_t IS25L_MemoryMappedEnable(const uint8_t **base) {
+    is25l_state_t state = IS25L_SPI_ERR;
+
+    tx_mutex_get(&muxIS25L, TX_WAIT_FOREVER);
+
+    /* Reads of a busy chip return its status */
+    if (IS25L_WaitForStatus(IS25L_STATUS_WIP, 0) != IS25L_OK) {
+        LOG_DEBUG("%s, %d", __FILE__, __LINE__);
+        goto quit;
+    }
+
+    OSPI_RegularCmdTypeDef command = {
+        .OperationType = HAL_OSPI_OPTYPE_READ_CFG,
+        .InstructionMode = HAL_OSPI_INSTRUCTION_1_LINE,
+        .Instruction = IS25L_INOUT_FAST_READ_CMD,
+        .InstructionSize = HAL_OSPI_INSTRUCTION_8_BITS,
+        .InstructionDtrMode = HAL_OSPI_INSTRUCTION_DTR_DISABLE,
+        .Address = 0x0U,
+        .AddressMode = HAL_OSPI_ADDRESS_4_LINES,
+        .AddressSize = HAL_OSPI_ADDRESS_24_BITS,
+        .AddressDtrMode = HAL_OSPI_ADDRESS_DTR_DISABLE,
+        .AlternateBytesMode = HAL_OSPI_ALTERNATE_BYTES_NONE,
+        .AlternateBytes = HAL_OSPI_ALTERNATE_BYTES_NONE,
+        .AlternateBytesSize = HAL_OSPI_ALTERNATE_BYTES_NONE,
+        .AlternateBytesDtrMode = HAL_OSPI_ALTERNATE_BYTES_DTR_DISABLE,
+        .DataMode = HAL_OSPI_DATA_4_LINES,
+        .DummyCycles = 6,
+        .NbData = 0,
+        .SIOOMode = HAL_OSPI_SIOO_INST_EVERY_CMD,
+        .DQSMode = HAL_OSPI_DQS_DISABLE,
+        .DataDtrMode = HAL_OSPI_DATA_DTR_DISABLE,
+    };
+
+    if (HAL_OSPI_Command(&FLASH_QSPI, &command, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK) {
+        LOG_DEBUG("%s, %d", __FILE__, __LINE__);
+        goto quit;
+    }
+
+    /* Chip select is released after idle time, so the chip does not stay selected between loads */
+    OSPI_MemoryMappedTypeDef mapped_config = {
+        .TimeOutActivation = HAL_OSPI_TIMEOUT_COUNTER_ENABLE,
+        .TimeOutPeriod = 0x20,
+    };
+
+    if (HAL_OSPI_MemoryMapped(&FLASH_QSPI, &mapped_config) != HAL_OK) {
+        LOG_DEBUG("%s, %d", __FILE__, __LINE__);
+        goto quit;
+    }
+
+    *base = (const uint8_t *) OCTOSPI1_BASE;
+    state = IS25L_OK;
+
+quit:
+    tx_mutex_put(&muxIS25L);
+    return state;
+}
+
+/* Function for leaving memory-mapped mode */
+is25l_state_t IS25L_MemoryMappedDisable(void) {
+    is25l_state_t state = IS25L_OK;
+
+    tx_mutex_get(&muxIS25L, TX_WAIT_FOREVER);
+
+    if (HAL_OSPI_Abort(&FLASH_QSPI) != HAL_OK) {
+        LOG_DEBUG("%s, %d", __FILE__, __LINE__);
+        state = IS25L_SPI_ERR;
+    }
+
+    tx_mutex_put(&muxIS25L);
+    return state;
+}
+
 uint32_t PageToAddress(uint32_t PageNumber, uint8_t PageShift) {
     return PageNumber * IS25L_MEMORY_PAGE_SIZE + PageShift;
 }
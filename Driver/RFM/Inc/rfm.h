@@ -0,0 +1,93 @@
+/**
+ * @file rfm.h
+ * @brief Interface of RFM transceivers.
+ *        Chip drivers and the simulated radio of HOST target implement it with
+ *        a table of operations, so users of the radio (GEODE) are not built for
+ *        one chip and get the backend at run time:
+ *            + RFM66_Ops  - RFM66 (SX1231 family), HUB
+ *            + RFM66A_Ops - RFM66A (Si4463), DEVBOARD
+ *            + SIM_RFM_Ops - simulated RFM66A on the virtual medium, HOST
+ *        ### How to use the interface ###
+ *     + init() once, then config() with rfm_settings_t
+ *     + Settings changed together (hop and sync word, rate) go between
+ *       config_begin() and config_commit()
+ *     + Packets go by blocking tx()/rx() or by async operations:
+ *         * tx_load() fills FIFO, tx_start() or tx_async() sends it
+ *         * rx_async() listens till the packet or rx_abort()
+ *         * completions are called in interrupt context
+ *     + Settings the chips do not share (RX filter of RFM66A, AGC, ...) come
+ *       with configuration of the chip driver
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#ifndef RFM_H
+#define RFM_H
+
+#include <stdint.h>
+
+#define RFM_FIFO_SIZE (64U) /* length byte of variable length packet included */
+#define RFM_SYNC_MAX  (4U)
+
+typedef enum {
+    RFM_OK,
+    RFM_ERR = 1 << 0,
+    RFM_ERR_SPI = 1 << 1,
+    RFM_ERR_TIMEOUT = 1 << 2,
+    RFM_ERR_BUSY = 1 << 3,
+    RFM_ERR_CRC = 1 << 4
+} rfm_stat_t;
+
+/* completion of async operation, called in interrupt context */
+typedef void (*rfm_cb_t)(rfm_stat_t stat);
+
+/**
+ * @brief radio settings common to the chips
+ *
+ */
+typedef struct {
+    uint32_t frequency;    /* kHz */
+    uint32_t deviation;    /* Hz */
+    uint32_t baud_rate;
+    uint32_t bandwidth;    /* RX filter, Hz, the narrowest one of the chip not below it */
+    uint16_t preamble_len; /* bytes */
+    uint8_t  payload_len;  /* max one in variable length mode */
+    uint8_t  sync_word[RFM_SYNC_MAX];
+    uint8_t  sync_len;
+    uint8_t  output_power; /* dBm */
+    uint8_t  gfsk : 1;
+    uint8_t  variable : 1; /* length byte precedes the payload */
+} rfm_settings_t;
+
+/**
+ * @brief operations of a backend, blocking ones wait for ThreadX objects so they are called from threads.
+ * tx_async() can be called from interrupt, so the packet leaves at a timer edge
+ *
+ */
+typedef struct {
+    rfm_stat_t (*init)(void);
+    rfm_stat_t (*config)(const rfm_settings_t *set);
+    rfm_stat_t (*set_freq)(uint32_t frequency); /* kHz */
+    rfm_stat_t (*set_sync)(const uint8_t *sync_word, uint8_t sync_len);
+    rfm_stat_t (*set_rate)(uint32_t baud_rate, uint32_t deviation, uint32_t bandwidth);
+    /* settings between them go to the chip together at commit, ones of the values it holds are skipped */
+    rfm_stat_t (*config_begin)(void);
+    rfm_stat_t (*config_commit)(void);
+    /* header and data go in row, buffers are not changed so structures can be sent in place */
+    rfm_stat_t (*tx_load)(const void *hdr, uint8_t hdr_size, const void *data, uint8_t size);
+    rfm_stat_t (*tx_start)(void); /* returns when the loaded packet is sent */
+    rfm_stat_t (*tx_async)(rfm_cb_t cb);
+    rfm_stat_t (*tx)(const void *data, uint8_t size);
+    rfm_stat_t (*rx)(void *data, uint8_t *size, uint32_t timeout); /* timeout in ticks */
+    /* data takes RFM_FIFO_SIZE, size is valid in cb. no other calls till cb or rx_abort() */
+    rfm_stat_t (*rx_async)(void *data, uint8_t *size, rfm_cb_t cb);
+    rfm_stat_t (*rx_abort)(void); /* RFM_ERR if the packet is being read already and cb is going to be called */
+    rfm_stat_t (*standby)(void);  /* oscillator on, ready to tune */
+    rfm_stat_t (*sleep)(void);    /* registers kept, FIFO may be lost */
+    rfm_stat_t (*get_rssi)(int16_t *rssi); /* latched on the last packet, dBm */
+} rfm_ops_t;
+
+#endif    // RFM_H
@@ -1,7 +1,8 @@
-#ifndef RFM_H
-#define RFM_H
+#ifndef RFM66_H
+#define RFM66_H
 
 #include "main.h"
+#include "rfm.h"
 
 #define _RFM_RADIO_SLEEP   (0x00)
 #define _RFM_RADIO_STANDBY (0x01)
@@ -46,15 +47,6 @@ typedef enum {
     RFM_BW2_6kHz
 } rfm_bandwidth_t;
 
-typedef enum {
-    RFM_OK,
-    RFM_ERR = 1 << 0,
-    RFM_ERR_SPI = 1 << 1,
-    RFM_ERR_TIMEOUT = 1 << 2,
-    RFM_ERR_BUSY = 1 << 3,
-    RFM_ERR_CRC = 1 << 4
-} rfm_stat_t;
-
 typedef enum {
     RFM_MOD_FSK = _RFM_MOD_FSK,
     RFM_MOD_GFSK = _RFM_MOD_FSK | _RFM_SHAPING
@@ -89,6 +81,9 @@ typedef struct {
     uint8_t         crc_ibm : 1;
 } rfm_config_t;
 
+/* rfm.h interface of the driver */
+extern const rfm_ops_t RFM66_Ops;
+
 rfm_stat_t RFM_Init(void);
 rfm_stat_t RFM_Config(rfm_config_t *config);
 rfm_stat_t RFM_SetFrequency(uint32_t frequency);
@@ -98,13 +93,19 @@ rfm_stat_t RFM_SetBaudRate(uint32_t baud_rate);
 rfm_stat_t RFM_SetOutputPower(uint8_t output_power);
 rfm_stat_t RFM_SetModulation(rfm_mod_t mod);
 rfm_stat_t RFM_SetSyncWord(uint8_t *sync_word, uint8_t sync_len);
-rfm_stat_t RFM_Tx(uint8_t *data, uint8_t size);
-rfm_stat_t RFM_Rx(uint8_t *data, uint8_t *size, uint32_t timeout);
+rfm_stat_t RFM_TxLoad(const void *hdr, uint8_t hdr_size, const void *data, uint8_t size);
+rfm_stat_t RFM_TxStart(void);
+rfm_stat_t RFM_Tx(const void *data, uint8_t size);
+rfm_stat_t RFM_Rx(void *data, uint8_t *size, uint32_t timeout);
+rfm_stat_t RFM_TxAsync(rfm_cb_t cb);
+rfm_stat_t RFM_RxAsync(void *data, uint8_t *size, rfm_cb_t cb);
+rfm_stat_t RFM_RxAbort(void);
 rfm_stat_t RFM_SetMode(rfm_mode_t mode);
 void       RFM_Reset();
 rfm_stat_t RFM_IsCrcOk();
+rfm_stat_t RFM_GetRssi(int16_t *rssi);
 
 void RFM_SPI_CpltCallback(SPI_HandleTypeDef *);
 void RFM_GPIO_EXTI_Callback(uint16_t);
 
-#endif    // RFM_H
+#endif    // RFM66_H
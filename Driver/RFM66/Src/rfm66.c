@@ -4,6 +4,8 @@
 #include "main.h"
 #include "tx_api.h"
 
+#include <string.h>
+
 #include "extm.h"
 
 #define MODE_MASK (0x07)
@@ -43,35 +45,77 @@ extern SPI_HandleTypeDef RFM_SPI;
 
 static TX_SEMAPHORE semRFM;
 
+/* SPI rx side of FIFO writes */
+static uint8_t dump[RFM_FIFO_SIZE + 1];
+
+/* address byte and data of one transaction, the whole frame goes in one transfer */
+static uint8_t spiBuf[RFM_FIFO_SIZE + 1];
+
+/* REG_OP_MODE as last written, async mode changes are single writes */
+static uint8_t opMode;
+
+typedef enum {
+    ASYNC_IDLE,
+    ASYNC_TX_MODE, /* TX mode is being set */
+    ASYNC_TX,      /* waiting PacketSent */
+    ASYNC_RX_MODE, /* RX mode is being set */
+    ASYNC_RX,      /* waiting PayloadReady */
+    ASYNC_RX_LEN,  /* reading length byte */
+    ASYNC_RX_DATA, /* reading payload */
+    ASYNC_FS,      /* FS mode is being set after tx/rx */
+    ASYNC_ABORT,   /* RFM_RxAbort() waits RX mode write */
+} rfm_async_state_t;
+
+static struct {
+    volatile rfm_async_state_t state;
+    rfm_cb_t                   cb;
+    rfm_stat_t                 stat;
+    uint8_t                   *data;
+    uint8_t                   *size;
+} async;
+
+static rfm_stat_t syncStat;
+
 struct {
     uint16_t payload_length;
     uint8_t  variable_pkt_length : 1;
 } static _config;
 
-/* can be inlined */
-static rfm_stat_t _rfm_spi_xch_data(uint8_t *data, uint16_t size,
-                                    HAL_StatusTypeDef (*fn)(SPI_HandleTypeDef *, uint8_t *, uint8_t *, uint16_t)) {
-    if (fn(&RFM_SPI, data, data, size) != HAL_OK) {
+/* starts transaction of spiBuf, completion comes to RFM_SPI_CpltCallback() */
+static rfm_stat_t _rfm_spi_start(uint8_t *rx, uint16_t size) {
+    HAL_StatusTypeDef (*fn)(SPI_HandleTypeDef *, uint8_t *, uint8_t *, uint16_t) =
+        (size > MIN_SPI_DMA_MSG_SIZE) ? HAL_SPI_TransmitReceive_DMA : HAL_SPI_TransmitReceive_IT;
+
+    HAL_GPIO_WritePin(RFM01_NSS_GPIO_Port, RFM01_NSS_Pin, GPIO_PIN_RESET);
+    if (fn(&RFM_SPI, spiBuf, rx, size) != HAL_OK) {
         /* Error transmiting data to rfm via SPI */
+        HAL_GPIO_WritePin(RFM01_NSS_GPIO_Port, RFM01_NSS_Pin, GPIO_PIN_SET);
         return RFM_ERR_SPI;
     }
-    tx_semaphore_get(&semRFM, TX_WAIT_FOREVER);
+
     return RFM_OK;
 }
 
+/* blocking transaction of spiBuf */
+static rfm_stat_t _rfm_spi_xch(uint8_t *rx, uint16_t size) {
+    rfm_stat_t status = _rfm_spi_start(rx, size);
+    if (status == RFM_OK) {
+        tx_semaphore_get(&semRFM, TX_WAIT_FOREVER);
+        HAL_GPIO_WritePin(RFM01_NSS_GPIO_Port, RFM01_NSS_Pin, GPIO_PIN_SET);
+    }
+    return status;
+}
+
 /* NOTE: to chose direction add | with 'SPI_READ' or 'SPI_WRITE' to address
  *  example: rfm_spi_TxRx(SPI_WRITE|SomeReg, data, 3);
  */
 static rfm_stat_t rfm_spi_TxRx(uint8_t addr, uint8_t *data, uint16_t size) {
     rfm_stat_t status = RFM_OK;
 
-    HAL_GPIO_WritePin(RFM01_NSS_GPIO_Port, RFM01_NSS_Pin, GPIO_PIN_RESET);
-
-    status |= _rfm_spi_xch_data(&addr, 1, HAL_SPI_TransmitReceive_IT);
-    status |= _rfm_spi_xch_data(
-        data, size, (size > MIN_SPI_DMA_MSG_SIZE ? HAL_SPI_TransmitReceive_DMA : HAL_SPI_TransmitReceive_IT));
-
-    HAL_GPIO_WritePin(RFM01_NSS_GPIO_Port, RFM01_NSS_Pin, GPIO_PIN_SET);
+    spiBuf[0] = addr;
+    memcpy(spiBuf + 1, data, size);
+    status |= _rfm_spi_xch(spiBuf, size + 1);
+    memcpy(data, spiBuf + 1, size);
 
     return status;
 }
@@ -80,44 +124,145 @@ static rfm_stat_t rfm_spi_TxRx(uint8_t addr, uint8_t *data, uint16_t size) {
  *   we work only in packet mode
  *   all txrx data packets are max 64 bytes (no controling of fifo overflow)
  *   after Tx/Rx corresponding FS mode is set
+ *   packet goes to FIFO in one burst: length byte, header and data, caller buffers are not changed
+ *   Tx/Rx is driven by SPI and DIO0 interrupts, blocking calls wait the async ones
  */
 
+/* completion of the async operation for blocking calls */
+static void _rfm_sync_cb(rfm_stat_t stat) {
+    syncStat = stat;
+    tx_semaphore_put(&semRFM);
+}
+
+static void _rfm_async_done(rfm_stat_t stat) {
+    rfm_cb_t cb = async.cb;
+    async.state = ASYNC_IDLE;
+    cb(stat);
+}
+
+/* single write of REG_OP_MODE */
+static rfm_stat_t _rfm_async_mode(rfm_async_state_t state, rfm_mode_t mode) {
+    opMode = (opMode & ~MODE_MASK) | mode;
+    spiBuf[0] = SPI_WRITE | REG_OP_MODE;
+    spiBuf[1] = opMode;
+    async.state = state;
+
+    return _rfm_spi_start(dump, 2);
+}
+
+static rfm_stat_t _rfm_async_start(rfm_async_state_t state, rfm_mode_t mode, rfm_cb_t cb) {
+    TX_INTERRUPT_SAVE_AREA
+
+    TX_DISABLE
+    if (async.state != ASYNC_IDLE) {
+        TX_RESTORE
+        return RFM_ERR;
+    }
+    async.state = state;
+    TX_RESTORE
+    async.cb = cb;
+    if (_rfm_async_mode(state, mode) != RFM_OK) {
+        async.state = ASYNC_IDLE;
+        return RFM_ERR_SPI;
+    }
+
+    return RFM_OK;
+}
+
 /* see RFM TX/RX note */
-rfm_stat_t RFM_Tx(uint8_t *data, uint8_t size) {
-    rfm_stat_t status = RFM_OK;
+rfm_stat_t RFM_TxLoad(const void *hdr, uint8_t hdr_size, const void *data, uint8_t size) {
+    uint8_t  len = hdr_size + size;
+    uint8_t *ptr = spiBuf;
 
+    if (len + _config.variable_pkt_length > RFM_FIFO_SIZE) {
+        return RFM_ERR;
+    }
+    if (async.state != ASYNC_IDLE) {
+        return RFM_ERR_BUSY;
+    }
+    *ptr++ = SPI_WRITE | REG_FIFO;
     if (_config.variable_pkt_length) {
-        status |= rfm_spi_TxRx(SPI_WRITE | REG_FIFO, &size, 1);
+        *ptr++ = len;
+    }
+    if (hdr_size) {
+        memcpy(ptr, hdr, hdr_size);
     }
+    if (size) {
+        memcpy(ptr + hdr_size, data, size);
+    }
+
+    return _rfm_spi_xch(dump, 1 + _config.variable_pkt_length + len);
+}
+
+/* see RFM TX/RX note */
+rfm_stat_t RFM_TxAsync(rfm_cb_t cb) {
+    return _rfm_async_start(ASYNC_TX_MODE, _RFM_MODE_TX, cb);
+}
 
-    status |= rfm_spi_TxRx(SPI_WRITE | REG_FIFO, data, size);
-    RFM_SetMode(_RFM_MODE_TX);
+/* see RFM TX/RX note */
+rfm_stat_t RFM_TxStart(void) {
+    rfm_stat_t status = RFM_TxAsync(_rfm_sync_cb);
+    if (status != RFM_OK) {
+        return status;
+    }
     tx_semaphore_get(&semRFM, TX_WAIT_FOREVER);
 
-    RFM_SetMode(RFM_MODE_FSTX);
+    return syncStat;
+}
 
-    return status;
+/* see RFM TX/RX note */
+rfm_stat_t RFM_Tx(const void *data, uint8_t size) {
+    return RFM_TxLoad(data, size, NULL, 0) | RFM_TxStart();
 }
 
 /* see RFM TX/RX note */
-rfm_stat_t RFM_Rx(uint8_t *data, uint8_t *size, uint32_t timeout) {
-    rfm_stat_t status = RFM_OK;
+rfm_stat_t RFM_RxAsync(void *data, uint8_t *size, rfm_cb_t cb) {
+    async.data = data;
+    async.size = size;
+    return _rfm_async_start(ASYNC_RX_MODE, _RFM_MODE_RX, cb);
+}
+
+/* see RFM TX/RX note */
+rfm_stat_t RFM_RxAbort(void) {
+    TX_INTERRUPT_SAVE_AREA
+    rfm_async_state_t state;
+
+    TX_DISABLE
+    state = async.state;
+    if (state == ASYNC_RX) {
+        async.state = ASYNC_IDLE;
+    } else if (state == ASYNC_RX_MODE) {
+        async.state = ASYNC_ABORT;
+    }
+    TX_RESTORE
+    switch (state) {
+        case ASYNC_RX_MODE:
+            tx_semaphore_get(&semRFM, TX_WAIT_FOREVER);
+            /* fall through */
+        case ASYNC_RX:
+            return RFM_SetMode(RFM_MODE_FSRX);
+        case ASYNC_IDLE:
+            return RFM_OK;
+        default:
+            return RFM_ERR;
+    }
+}
 
-    RFM_SetMode(_RFM_MODE_RX);
+/* see RFM TX/RX note */
+rfm_stat_t RFM_Rx(void *data, uint8_t *size, uint32_t timeout) {
+    rfm_stat_t status = RFM_RxAsync(data, size, _rfm_sync_cb);
+    if (status != RFM_OK) {
+        return status;
+    }
     if (tx_semaphore_get(&semRFM, timeout) != TX_SUCCESS) {
-        status |= RFM_ERR_TIMEOUT;
-    } else {
-        if (_config.variable_pkt_length) {
-            status |= rfm_spi_TxRx(SPI_READ | REG_FIFO, size, 1);
-        } else {
-            *size = _config.payload_length;
+        if (RFM_RxAbort() != RFM_ERR) {
+            return RFM_ERR_TIMEOUT;
         }
-        status |= rfm_spi_TxRx(SPI_READ | REG_FIFO, data, *size);
+        /* packet came in right before the timeout */
+        tx_semaphore_get(&semRFM, TX_WAIT_FOREVER);
     }
 
-    RFM_SetMode(RFM_MODE_FSRX);
-
-    return status;
+    return syncStat;
 }
 
 static uint8_t rfm_select_ramping(uint32_t baud_rate) {
@@ -284,12 +429,8 @@ rfm_stat_t RFM_Config(rfm_config_t *config) {
         return RFM_ERR_SPI;
     }
 
-    /* Payload length */
-    if (config->variable_pkt_length) {
-        tmp = 0x40;
-    } else {
-        tmp = (uint8_t) (config->payload_length);
-    }
+    /* Payload length, max one to receive in variable length mode */
+    tmp = (uint8_t) (config->payload_length);
     if (rfm_spi_TxRx(SPI_WRITE | REG_PAYLOAD_LENGTH, &tmp, 1) != RFM_OK) {
         return RFM_ERR_SPI;
     }
@@ -330,6 +471,7 @@ static rfm_stat_t _rfm_set_mode_reg(uint8_t data, uint8_t mask) {
     tmp |= data;
 
     status |= rfm_spi_TxRx(SPI_WRITE | REG_OP_MODE, &tmp, 1);
+    opMode = tmp;
     /* wait mode ready flag? */
 
     return status;
@@ -430,14 +572,171 @@ rfm_stat_t RFM_IsCrcOk() {
     return status;
 }
 
+/* RSSI of the last packet, the register holds it till the next reception */
+rfm_stat_t RFM_GetRssi(int16_t *rssi) {
+    uint8_t    tmp;
+    rfm_stat_t status = rfm_spi_TxRx(SPI_READ | REG_RSSI_VALUE, &tmp, 1);
+
+    *rssi = -(int16_t) (tmp >> 1);
+    return status;
+}
+
 void RFM_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
-    if (GPIO_Pin == RFM01_RDIO0_Pin) {
-        tx_semaphore_put(&semRFM);
+    if (GPIO_Pin != RFM01_RDIO0_Pin) {
+        return;
+    }
+    switch (async.state) {
+        case ASYNC_TX:
+            async.stat = RFM_OK;
+            if (_rfm_async_mode(ASYNC_FS, RFM_MODE_FSTX) != RFM_OK) {
+                _rfm_async_done(RFM_ERR_SPI);
+            }
+            break;
+        case ASYNC_RX:
+            spiBuf[0] = SPI_READ | REG_FIFO;
+            if (_config.variable_pkt_length) {
+                async.state = ASYNC_RX_LEN;
+                async.stat = _rfm_spi_start(spiBuf, 2);
+            } else {
+                *async.size = _config.payload_length;
+                async.state = ASYNC_RX_DATA;
+                async.stat = _rfm_spi_start(spiBuf, *async.size + 1);
+            }
+            if (async.stat != RFM_OK) {
+                _rfm_async_done(async.stat);
+            }
+            break;
+        default:
+            tx_semaphore_put(&semRFM);
+            break;
     }
 }
 
 void RFM_SPI_CpltCallback(SPI_HandleTypeDef *hspi) {
-    if (hspi == &RFM_SPI) {
-        tx_semaphore_put(&semRFM);
+    if (hspi != &RFM_SPI) {
+        return;
+    }
+    switch (async.state) {
+        case ASYNC_TX_MODE:
+            HAL_GPIO_WritePin(RFM01_NSS_GPIO_Port, RFM01_NSS_Pin, GPIO_PIN_SET);
+            async.state = ASYNC_TX;
+            break;
+        case ASYNC_RX_MODE:
+            HAL_GPIO_WritePin(RFM01_NSS_GPIO_Port, RFM01_NSS_Pin, GPIO_PIN_SET);
+            async.state = ASYNC_RX;
+            break;
+        case ASYNC_RX_LEN:
+            HAL_GPIO_WritePin(RFM01_NSS_GPIO_Port, RFM01_NSS_Pin, GPIO_PIN_SET);
+            *async.size = (spiBuf[1] < RFM_FIFO_SIZE) ? (spiBuf[1]) : (RFM_FIFO_SIZE - 1);
+            async.state = ASYNC_RX_DATA;
+            spiBuf[0] = SPI_READ | REG_FIFO;
+            if (_rfm_spi_start(spiBuf, *async.size + 1) != RFM_OK) {
+                _rfm_async_done(RFM_ERR_SPI);
+            }
+            break;
+        case ASYNC_RX_DATA:
+            HAL_GPIO_WritePin(RFM01_NSS_GPIO_Port, RFM01_NSS_Pin, GPIO_PIN_SET);
+            memcpy(async.data, spiBuf + 1, *async.size);
+            if (_rfm_async_mode(ASYNC_FS, RFM_MODE_FSRX) != RFM_OK) {
+                _rfm_async_done(RFM_ERR_SPI);
+            }
+            break;
+        case ASYNC_FS:
+            HAL_GPIO_WritePin(RFM01_NSS_GPIO_Port, RFM01_NSS_Pin, GPIO_PIN_SET);
+            _rfm_async_done(async.stat);
+            break;
+        case ASYNC_ABORT:
+            HAL_GPIO_WritePin(RFM01_NSS_GPIO_Port, RFM01_NSS_Pin, GPIO_PIN_SET);
+            async.state = ASYNC_IDLE;
+            tx_semaphore_put(&semRFM);
+            break;
+        default:
+            tx_semaphore_put(&semRFM);
+            break;
     }
 }
+
+/* RX filters of the chip, Hz */
+static const struct {
+    uint32_t        hz;
+    rfm_bandwidth_t bw;
+} bwTable[] = {
+    { 2600, RFM_BW2_6kHz },     { 3100, RFM_BW3_1kHz },     { 3900, RFM_BW3_9kHz },     { 5200, RFM_BW5_2kHz },
+    { 6300, RFM_BW6_3kHz },     { 7800, RFM_BW7_8kHz },     { 10400, RFM_BW10_4kHz },   { 12500, RFM_BW12_5kHz },
+    { 15600, RFM_BW15_6kHz },   { 20800, RFM_BW20_8kHz },   { 25000, RFM_BW25kHz },     { 31300, RFM_BW31_3kHz },
+    { 41700, RFM_BW41_7kHz },   { 50000, RFM_BW50kHz },     { 62500, RFM_BW62_5kHz },   { 83300, RFM_BW83_3kHz },
+    { 100000, RFM_BW100kHz },   { 125000, RFM_BW125kHz },   { 166700, RFM_BW166_7kHz }, { 200000, RFM_BW200kHz },
+    { 250000, RFM_BW250kHz },
+};
+
+/* the narrowest filter not below hz, the widest one above all */
+static rfm_bandwidth_t _rfm_bandwidth(uint32_t hz) {
+    uint8_t i = 0;
+    while (i < sizeof(bwTable) / sizeof(bwTable[0]) - 1U && bwTable[i].hz < hz) {
+        ++i;
+    }
+    return bwTable[i].bw;
+}
+
+static rfm_stat_t _rfm_ops_config(const rfm_settings_t *set) {
+    rfm_config_t config = {
+        .modulation = set->gfsk ? RFM_MOD_GFSK : RFM_MOD_FSK,
+        .bandwidth = _rfm_bandwidth(set->bandwidth),
+        .frequency = set->frequency,
+        .deviation = set->deviation,
+        .sync_length = set->sync_len,
+        .output_power = set->output_power,
+        .payload_length = set->payload_len,
+        .preamble_length = set->preamble_len,
+        .baud_rate = set->baud_rate,
+        .variable_pkt_length = set->variable,
+        .crc_enable = 1,
+        .agc_auto_on = 1,
+    };
+    memcpy(config.sync_word, set->sync_word, set->sync_len);
+    return RFM_Config(&config);
+}
+
+/* registers are written back with what SPI read, so the sync word goes from a copy */
+static rfm_stat_t _rfm_ops_set_sync(const uint8_t *sync_word, uint8_t sync_len) {
+    uint8_t buf[RFM_SYNC_MAX];
+    memcpy(buf, sync_word, sync_len);
+    return RFM_SetSyncWord(buf, sync_len);
+}
+
+static rfm_stat_t _rfm_ops_set_rate(uint32_t baud_rate, uint32_t deviation, uint32_t bandwidth) {
+    return RFM_SetBaudRate(baud_rate) | RFM_SetDeviation(deviation) | RFM_SetBandwidth(_rfm_bandwidth(bandwidth));
+}
+
+/* registers are written by the setters at once, there is nothing to collect */
+static rfm_stat_t _rfm_ops_config_nop(void) {
+    return RFM_OK;
+}
+
+static rfm_stat_t _rfm_ops_standby(void) {
+    return RFM_SetMode(RFM_MODE_STANDBY);
+}
+
+static rfm_stat_t _rfm_ops_sleep(void) {
+    return RFM_SetMode(RFM_MODE_SLEEP);
+}
+
+const rfm_ops_t RFM66_Ops = {
+    .init = RFM_Init,
+    .config = _rfm_ops_config,
+    .set_freq = RFM_SetFrequency,
+    .set_sync = _rfm_ops_set_sync,
+    .set_rate = _rfm_ops_set_rate,
+    .config_begin = _rfm_ops_config_nop,
+    .config_commit = _rfm_ops_config_nop,
+    .tx_load = RFM_TxLoad,
+    .tx_start = RFM_TxStart,
+    .tx_async = RFM_TxAsync,
+    .tx = RFM_Tx,
+    .rx = RFM_Rx,
+    .rx_async = RFM_RxAsync,
+    .rx_abort = RFM_RxAbort,
+    .standby = _rfm_ops_standby,
+    .sleep = _rfm_ops_sleep,
+    .get_rssi = RFM_GetRssi,
+};
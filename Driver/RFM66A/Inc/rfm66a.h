@@ -11,15 +11,9 @@
 #define RFM66A_H
 
 #include "main.h"
+#include "rfm.h"
 #include "rfm66a_defs.h"
 
-typedef enum {
-    RFM_OK,
-    RFM_ERR = 1 << 0,
-    RFM_ERR_SPI = 1 << 1,
-    RFM_ERR_TIMEOUT = 1 << 2,
-} rfm_stat_t;
-
 typedef enum {
     RFM_MODE_STANDBY = 0x03,
     RFM_MODE_SLEEP = 0x01,
@@ -66,6 +60,9 @@ typedef struct {
     uint8_t   variablePkt : 1;
 } rfm_config_t;
 
+/* rfm.h interface of the driver */
+extern const rfm_ops_t RFM66A_Ops;
+
 /**
  * @brief Function for initialization and set default configuration
  * @return Status
@@ -78,6 +75,20 @@ rfm_stat_t RFM_Init();
  */
 rfm_stat_t RFM_Config(rfm_config_t *config);
 
+/**
+ * @brief Function for opening configuration transaction. Setters called till RFM_ConfigCommit() are collected
+ * and properties changed by them are sent together, unchanged ones are not sent at all
+ * @note transactions can nest, the outer commit sends
+ * @return Status
+ */
+rfm_stat_t RFM_ConfigBegin(void);
+
+/**
+ * @brief Function for sending properties changed since RFM_ConfigBegin()
+ * @return Status, RFM_ERR without open transaction
+ */
+rfm_stat_t RFM_ConfigCommit(void);
+
 /**
  * @brief Function for set frequency
  * @param frequency  (Hz)
@@ -130,7 +141,7 @@ rfm_stat_t RFM_SelectCRC(rfm_crc_t crc);
  * @param sync_len sync word length
  * @return Status
  */
-rfm_stat_t RFM_SetSyncWord(uint8_t *sync_word, uint8_t sync_len);
+rfm_stat_t RFM_SetSyncWord(const uint8_t *sync_word, uint8_t sync_len);
 
 /**
  * @brief Function for enable variable length packet
@@ -138,13 +149,38 @@ rfm_stat_t RFM_SetSyncWord(uint8_t *sync_word, uint8_t sync_len);
  */
 rfm_stat_t RFM_SetVarPktMode();
 
+/**
+ * @brief Function for loading packet to Tx FIFO, header and data go in row.
+ * Buffers are not changed, so structures can be sent in place
+ * @param hdr Pointer to header (can be NULL if hdr_size is 0)
+ * @param hdr_size Size of header
+ * @param data Pointer to data (can be NULL if size is 0)
+ * @param size Size of data
+ * @return Status
+ */
+rfm_stat_t RFM_TxLoad(const void *hdr, uint8_t hdr_size, const void *data, uint8_t size);
+
+/**
+ * @brief Function for Tx of packet loaded by RFM_TxLoad(), returns when it is sent
+ * @return Status
+ */
+rfm_stat_t RFM_TxStart(void);
+
+/**
+ * @brief Function for starting Tx of packet loaded by RFM_TxLoad(), returns at once.
+ * Can be called from interrupt, so the packet leaves at a timer edge
+ * @param cb Called when the packet is sent
+ * @return Status, RFM_ERR if another async operation is in progress
+ */
+rfm_stat_t RFM_TxAsync(rfm_cb_t cb);
+
 /**
  * @brief Function for Tx data
  * @param data Pointer to data
  * @param size Size of data
  * @return Status
  */
-rfm_stat_t RFM_Tx(void *data, uint8_t size);
+rfm_stat_t RFM_Tx(const void *data, uint8_t size);
 
 /**
  * @brief Function for Rx data
@@ -155,6 +191,22 @@ rfm_stat_t RFM_Tx(void *data, uint8_t size);
  */
 rfm_stat_t RFM_Rx(void *data, uint8_t *size, uint32_t timeout);
 
+/**
+ * @brief Function for starting Rx, returns at once. The packet is read from FIFO in interrupts
+ * @note No other driver calls until cb or RFM_RxAbort()
+ * @param data Memory for received data (RFM_FIFO_SIZE)
+ * @param size Size of received data, valid in cb
+ * @param cb Called when the packet is received
+ * @return Status, RFM_ERR if another async operation is in progress
+ */
+rfm_stat_t RFM_RxAsync(void *data, uint8_t *size, rfm_cb_t cb);
+
+/**
+ * @brief Function for stopping Rx started by RFM_RxAsync(), cb is not called then
+ * @return Status, RFM_ERR if the packet is being read already and cb is going to be called
+ */
+rfm_stat_t RFM_RxAbort(void);
+
 /**
  * @brief Function for change state
  * @return Status
@@ -168,6 +220,13 @@ rfm_stat_t RFM_SetMode(rfm_mode_t mode);
  */
 rfm_stat_t RFM_GetChipStatus(uint8_t *status);
 
+/**
+ * @brief Get RSSI latched on the last packet
+ * @param rssi dBm
+ * @return Status
+ */
+rfm_stat_t RFM_GetRssi(int16_t *rssi);
+
 void RFM_SPI_SemRelease();
 void RFM_SemRelease();
 
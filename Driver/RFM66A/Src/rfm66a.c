@@ -23,6 +23,55 @@ static TX_SEMAPHORE      semRFM_SPI;
 
 static uint8_t rfmconf[] = RADIO_CONFIGURATION_DATA_ARRAY;
 
+#define RSSI_OFFSET_DBM (134)
+
+static uint8_t txLen; /* loaded to FIFO, length byte included */
+
+/* command/address byte and data of one transaction, the whole frame goes by a single DMA */
+static uint8_t spiBuf[RFM_FIFO_SIZE + 1];
+
+typedef enum {
+    ASYNC_IDLE,
+    ASYNC_TX_CMD,  /* START_TX is being sent */
+    ASYNC_TX_CTS,  /* waiting CTS of START_TX */
+    ASYNC_TX,      /* waiting packet sent */
+    ASYNC_RX_CMD,  /* START_RX is being sent */
+    ASYNC_RX_CTS,  /* waiting CTS of START_RX */
+    ASYNC_RX,      /* waiting packet */
+    ASYNC_RX_LEN,  /* reading length byte */
+    ASYNC_RX_DATA, /* reading payload */
+    ASYNC_ABORT,   /* RFM_RxAbort() waits CTS of START_RX */
+} rfm_async_state_t;
+
+static struct {
+    volatile rfm_async_state_t state;
+    rfm_cb_t                   cb;
+    uint8_t                   *data;
+    uint8_t                   *size;
+} async;
+
+static rfm_tx_rx_t asyncCmd;
+static rfm_stat_t  syncStat;
+
+/* NOTE: property shadow
+ * properties the driver writes are kept in the shadow, a write of the value the chip holds is skipped. writes mark
+ * changed properties dirty and are sent at once, between RFM_ConfigBegin() and RFM_ConfigCommit() they are collected
+ * and go in one SET_PROPERTY per run of a group (up to 12 properties, valid clean ones in short gaps go along).
+ * configuration array of RFM_Init() is not tracked, the shadow starts empty after it.
+ */
+#define SHADOW_PROPS (16U) /* offsets of a group */
+#define SHADOW_GAP   (3U)  /* clean properties sent to join two runs, cheaper than header and CTS of a command */
+
+static const uint8_t shadowGroup[] = { PROP_GROUP_PREAMBLE, PROP_GROUP_SYNC, PROP_GROUP_PKT, PROP_GROUP_MODEM,
+                                       PROP_GROUP_FREQ_CONTROL };
+
+static struct {
+    uint8_t  val[countof(shadowGroup)][SHADOW_PROPS];
+    uint16_t valid[countof(shadowGroup)];
+    uint16_t dirty[countof(shadowGroup)];
+    uint8_t  open; /* nesting of RFM_ConfigBegin() */
+} shadow;
+
 static _rfm_gen_conf_t genConf = {
     .f_xtal = 0x01C9C380,
     .outdiv = 0x04,
@@ -41,12 +90,34 @@ static rfm_stat_t _rfm_spi_xch(void *data, uint16_t size,
     return RFM_OK;
 }
 
+/* starts transaction of spiBuf, completion comes to RFM_SPI_SemRelease() */
+static rfm_stat_t _rfm_spi_start(uint16_t size, uint8_t read) {
+    HAL_StatusTypeDef st;
+    HAL_GPIO_WritePin(ISM_NSS_GPIO_Port, ISM_NSS_Pin, GPIO_PIN_RESET);
+    st = (read) ? (HAL_SPI_TransmitReceive_DMA(&RFM_SPI, spiBuf, spiBuf, size))
+                : (HAL_SPI_Transmit_DMA(&RFM_SPI, spiBuf, size));
+    if (st != HAL_OK) {
+        HAL_GPIO_WritePin(ISM_NSS_GPIO_Port, ISM_NSS_Pin, GPIO_PIN_SET);
+        return RFM_ERR_SPI;
+    }
+
+    return RFM_OK;
+}
+
 static rfm_stat_t rfm_spi_RW(rfm_spi_rw_t rw, uint8_t addr, void *data, uint8_t size) {
     rfm_stat_t stat = RFM_OK;
-    HAL_GPIO_WritePin(ISM_NSS_GPIO_Port, ISM_NSS_Pin, GPIO_PIN_RESET);
-    stat |= _rfm_spi_xch(&addr, 1, HAL_SPI_Transmit_DMA);
-    stat |= _rfm_spi_xch(data, size, (rw) ? HAL_SPI_Transmit_DMA : HAL_SPI_Receive_DMA);
+    spiBuf[0] = addr;
+    if (rw) {
+        memcpy(spiBuf + 1, data, size);
+    }
+    stat |= _rfm_spi_start(size + 1, !rw);
+    if (stat == RFM_OK) {
+        tx_semaphore_get(&semRFM_SPI, TX_WAIT_FOREVER);
+    }
     HAL_GPIO_WritePin(ISM_NSS_GPIO_Port, ISM_NSS_Pin, GPIO_PIN_SET);
+    if (!rw) {
+        memcpy(data, spiBuf + 1, size);
+    }
 
     return stat;
 }
@@ -69,9 +140,97 @@ static rfm_stat_t rfm_spi_rx(void *cmd, uint8_t cmd_size, void *data, uint8_t si
     return stat;
 }
 
-rfm_stat_t RFM_Rx(void *data, uint8_t *size, uint32_t timeout) {
-    rfm_stat_t  stat = RFM_OK;
-    rfm_tx_rx_t cmd = {
+/* sends dirty properties, a run takes dirty ones and gaps of valid ones up to SHADOW_GAP */
+static rfm_stat_t _rfm_shadow_flush(void) {
+    rfm_stat_t   stat = RFM_OK;
+    rfm_sp_cmd_t cmd = { .cmd = SET_PROPERTY };
+
+    for (uint8_t g = 0; g < countof(shadowGroup); ++g) {
+        while (shadow.dirty[g]) {
+            const uint8_t first = ctz(shadow.dirty[g]);
+            uint8_t       last = first;
+            for (uint8_t i = first + 1; i < SHADOW_PROPS && i - first < sizeof(cmd.arg); ++i) {
+                if (shadow.dirty[g] & (1U << i)) {
+                    last = i;
+                } else if (!(shadow.valid[g] & (1U << i)) || i - last > SHADOW_GAP) {
+                    break;
+                }
+            }
+            const uint16_t run = (uint16_t) (((1U << (last + 1U)) - 1U) & ~((1U << first) - 1U));
+            cmd.group = shadowGroup[g];
+            cmd.num_byte = last - first + 1U;
+            cmd.offset = first;
+            memcpy(cmd.arg, &shadow.val[g][first], cmd.num_byte);
+            if (rfm_spi_tx(&cmd, cmd.num_byte + 4) != RFM_OK) {
+                /* the chip may hold anything there */
+                shadow.valid[g] &= ~run;
+                stat |= RFM_ERR_SPI;
+            }
+            shadow.dirty[g] &= ~run;
+        }
+    }
+
+    return stat;
+}
+
+/* SET_PROPERTY through the shadow */
+static rfm_stat_t _rfm_set_prop(uint8_t group, uint8_t offset, const uint8_t *arg, uint8_t num) {
+    uint8_t g = 0;
+    while (g < countof(shadowGroup) && shadowGroup[g] != group) {
+        ++g;
+    }
+    if (g == countof(shadowGroup) || offset + num > SHADOW_PROPS) {
+        rfm_sp_cmd_t cmd = { .cmd = SET_PROPERTY, .group = group, .num_byte = num, .offset = offset };
+        memcpy(cmd.arg, arg, num);
+        return rfm_spi_tx(&cmd, num + 4);
+    }
+    for (uint8_t i = 0; i < num; ++i) {
+        const uint16_t bit = 1U << (offset + i);
+        if (!(shadow.valid[g] & bit) || shadow.val[g][offset + i] != arg[i]) {
+            shadow.val[g][offset + i] = arg[i];
+            shadow.valid[g] |= bit;
+            shadow.dirty[g] |= bit;
+        }
+    }
+
+    return (shadow.open) ? (RFM_OK) : (_rfm_shadow_flush());
+}
+
+/* completion of the async operation for blocking calls */
+static void _rfm_sync_cb(rfm_stat_t stat) {
+    syncStat = stat;
+    tx_semaphore_put(&semRFM);
+}
+
+static void _rfm_async_done(rfm_stat_t stat) {
+    rfm_cb_t cb = async.cb;
+    async.state = ASYNC_IDLE;
+    cb(stat);
+}
+
+/* sends asyncCmd, next steps are driven by SPI and EXTI interrupts */
+static rfm_stat_t _rfm_async_cmd(rfm_async_state_t state, uint8_t size, rfm_cb_t cb) {
+    TX_INTERRUPT_SAVE_AREA
+
+    TX_DISABLE
+    if (async.state != ASYNC_IDLE) {
+        TX_RESTORE
+        return RFM_ERR;
+    }
+    async.state = state;
+    TX_RESTORE
+    async.cb = cb;
+    memcpy(spiBuf, &asyncCmd, size);
+    if (_rfm_spi_start(size, 0) != RFM_OK) {
+        async.state = ASYNC_IDLE;
+        return RFM_ERR_SPI;
+    }
+
+    return RFM_OK;
+}
+
+rfm_stat_t RFM_RxAsync(void *data, uint8_t *size, rfm_cb_t cb) {
+    asyncCmd = (rfm_tx_rx_t) {
         .cmd = START_RX,
         .channel = 0x00,
         .condition = 0x00,
@@ -81,43 +240,115 @@ rfm_stat_t RFM_Rx(void *data, uint8_t *size, uint32_t timeout) {
         .TxRep_RxVS = 0x03,
         .RxIVs = 0x08,
     };
+    async.data = data;
+    async.size = size;
 
-    stat |= rfm_spi_tx(&cmd, 8);
+    return _rfm_async_cmd(ASYNC_RX_CMD, 8, cb);
+}
+
+rfm_stat_t RFM_RxAbort(void) {
+    TX_INTERRUPT_SAVE_AREA
+    rfm_async_state_t state;
+
+    TX_DISABLE
+    state = async.state;
+    if (state == ASYNC_RX) {
+        async.state = ASYNC_IDLE;
+    } else if ((state == ASYNC_RX_CMD) || (state == ASYNC_RX_CTS)) {
+        async.state = ASYNC_ABORT;
+    }
+    TX_RESTORE
+    switch (state) {
+        case ASYNC_RX_CMD:
+        case ASYNC_RX_CTS:
+            tx_semaphore_get(&semRFM, TX_WAIT_FOREVER);
+            /* fall through */
+        case ASYNC_RX:
+            return RFM_SetMode(RFM_MODE_READY);
+        case ASYNC_IDLE:
+            return RFM_OK;
+        default:
+            return RFM_ERR;
+    }
+}
+
+rfm_stat_t RFM_Rx(void *data, uint8_t *size, uint32_t timeout) {
+    rfm_stat_t stat = RFM_OK;
+
+    stat |= RFM_RxAsync(data, size, _rfm_sync_cb);
+    if (stat != RFM_OK) {
+        return stat;
+    }
     if (tx_semaphore_get(&semRFM, timeout) != TX_SUCCESS) {
-        stat |= RFM_SetMode(RFM_MODE_READY);
-        tx_semaphore_get(&semRFM, timeout);
-        stat |= RFM_ERR_TIMEOUT;
-    } else {
-        if (genConf.variablePkt) {
-            stat |= rfm_spi_RW(rfm_Read, READ_RX_FIFO, size, 1);
-        } else {
-            *size = genConf.payloadLen;
+        if (RFM_RxAbort() == RFM_ERR) {
+            /* packet came in right before the timeout */
+            tx_semaphore_get(&semRFM, TX_WAIT_FOREVER);
+            return syncStat;
         }
-        stat |= rfm_spi_RW(rfm_Read, READ_RX_FIFO, data, *size);
+        tx_semaphore_get(&semRFM, timeout);
+        return stat | RFM_ERR_TIMEOUT;
     }
 
-    return stat;
+    return syncStat;
 }
 
-rfm_stat_t RFM_Tx(void *data, uint8_t size) {
+/* one WRITE_TX_FIFO transaction, buffers are only read */
+rfm_stat_t RFM_TxLoad(const void *hdr, uint8_t hdr_size, const void *data, uint8_t size) {
     rfm_stat_t stat = RFM_OK;
+    uint8_t    len = hdr_size + size;
+    uint8_t   *ptr = spiBuf;
+    if (len + genConf.variablePkt > RFM_FIFO_SIZE) {
+        return RFM_ERR;
+    }
+    if (async.state != ASYNC_IDLE) {
+        return RFM_ERR;
+    }
+    *ptr++ = WRITE_TX_FIFO;
     if (genConf.variablePkt) {
-        rfm_spi_RW(rfm_Write, WRITE_TX_FIFO, &size, 1);
+        *ptr++ = len;
     }
-    rfm_spi_RW(rfm_Write, WRITE_TX_FIFO, data, size);
-    rfm_tx_rx_t cmd = {
+    if (hdr_size) {
+        memcpy(ptr, hdr, hdr_size);
+    }
+    if (size) {
+        memcpy(ptr + hdr_size, data, size);
+    }
+    stat |= _rfm_spi_start(1 + genConf.variablePkt + len, 0);
+    if (stat == RFM_OK) {
+        tx_semaphore_get(&semRFM_SPI, TX_WAIT_FOREVER);
+    }
+    HAL_GPIO_WritePin(ISM_NSS_GPIO_Port, ISM_NSS_Pin, GPIO_PIN_SET);
+    txLen = len + genConf.variablePkt;
+
+    return stat;
+}
+
+rfm_stat_t RFM_TxAsync(rfm_cb_t cb) {
+    asyncCmd = (rfm_tx_rx_t) {
         .cmd = START_TX,
         .channel = 0x00,
         .condition = 0x30,
         .LenMsb = 0x00,
-        .LenLsb = size + genConf.variablePkt,
+        .LenLsb = txLen,
         .TxD_RxTO = 0x00,
         .TxRep_RxVS = 0x00,
     };
-    stat |= rfm_spi_tx(&cmd, 7);
+
+    return _rfm_async_cmd(ASYNC_TX_CMD, 7, cb);
+}
+
+rfm_stat_t RFM_TxStart(void) {
+    rfm_stat_t stat = RFM_TxAsync(_rfm_sync_cb);
+    if (stat != RFM_OK) {
+        return stat;
+    }
     tx_semaphore_get(&semRFM, TX_WAIT_FOREVER);
 
-    return stat;
+    return syncStat;
+}
+
+rfm_stat_t RFM_Tx(const void *data, uint8_t size) {
+    return RFM_TxLoad(data, size, NULL, 0) | RFM_TxStart();
 }
 
 static rfm_stat_t _rfm_conf(uint32_t timeout) {
@@ -136,6 +367,7 @@ static rfm_stat_t _rfm_conf(uint32_t timeout) {
 }
 
 rfm_stat_t RFM_Init() {
+    memset(&shadow, 0, sizeof(shadow));
     if ((tx_semaphore_create(&semRFM, NULL, 0) != TX_SUCCESS) ||
         (tx_semaphore_create(&semRFM_SPI, NULL, 0) != TX_SUCCESS)) {
         LOG_ERROR("Semaphore create error");
@@ -159,6 +391,7 @@ rfm_stat_t RFM_Config(rfm_config_t *config) {
     } else if (config->frequency > 142000) {
         genConf.outdiv = 24;
     }
+    stat |= RFM_ConfigBegin();
     stat |= RFM_SetFrequency(config->frequency);
     stat |= RFM_SetDeviation(config->deviation);
     stat |= (config->variablePkt) ? (RFM_SetVarPktMode()) : (RFM_SetPayloadLen(config->payload_len));
@@ -168,129 +401,86 @@ rfm_stat_t RFM_Config(rfm_config_t *config) {
     stat |= RFM_SetModulation(config->modulation);
     stat |= RFM_SetSyncWord(config->sync_word, config->sync_len);
     stat |= RFM_SelectCRC(config->crc);
+    stat |= RFM_ConfigCommit();
 
     return stat;
 }
 
+rfm_stat_t RFM_ConfigBegin(void) {
+    ++shadow.open;
+    return RFM_OK;
+}
+
+rfm_stat_t RFM_ConfigCommit(void) {
+    if (!shadow.open) {
+        return RFM_ERR;
+    }
+    return (--shadow.open) ? (RFM_OK) : (_rfm_shadow_flush());
+}
+
 rfm_stat_t RFM_SetFrequency(uint32_t frequency) {
     uint32_t f_int = ((frequency * 1000) / (genConf.n_presc * genConf.f_xtal / genConf.outdiv)) - 1;
     uint32_t f_frac =
         ((((frequency * 1000) - f_int * (genConf.n_presc * genConf.f_xtal / genConf.outdiv)) / 100000) * (1 << 19)) /
         ((genConf.n_presc * genConf.f_xtal / genConf.outdiv) / 100000);
-    rfm_sp_cmd_t cmd = {
-        .cmd = SET_PROPERTY,
-        .group = PROP_GROUP_FREQ_CONTROL,
-        .num_byte = 0x04,
-        .offset = 0x00,
-        .arg = {f_int, EXT_GET_REG_BYTE(f_frac, 2), EXT_GET_REG_BYTE(f_frac, 1), EXT_GET_REG_BYTE(f_frac, 0)}
-    };
+    const uint8_t arg[] = { f_int, EXT_GET_REG_BYTE(f_frac, 2), EXT_GET_REG_BYTE(f_frac, 1),
+                            EXT_GET_REG_BYTE(f_frac, 0) };
 
-    return rfm_spi_tx(&cmd, cmd.num_byte + 4);
+    return _rfm_set_prop(PROP_GROUP_FREQ_CONTROL, 0x00, arg, sizeof(arg));
 }
 
 rfm_stat_t RFM_SetDeviation(uint32_t deviation) {
-    uint32_t     dev = (((1LLU << 19) * (uint64_t) deviation * genConf.outdiv) / (genConf.n_presc * genConf.f_xtal));
-    rfm_sp_cmd_t cmd = {
-        .cmd = SET_PROPERTY,
-        .group = PROP_GROUP_MODEM,
-        .num_byte = 0x03,
-        .offset = 0x0A,
-        .arg = {EXT_GET_REG_BYTE(dev, 2), EXT_GET_REG_BYTE(dev, 1), EXT_GET_REG_BYTE(dev, 0)}
-    };
+    uint32_t      dev = (((1LLU << 19) * (uint64_t) deviation * genConf.outdiv) / (genConf.n_presc * genConf.f_xtal));
+    const uint8_t arg[] = { EXT_GET_REG_BYTE(dev, 2), EXT_GET_REG_BYTE(dev, 1), EXT_GET_REG_BYTE(dev, 0) };
 
-    return rfm_spi_tx(&cmd, cmd.num_byte + 4);
+    return _rfm_set_prop(PROP_GROUP_MODEM, 0x0A, arg, sizeof(arg));
 }
 
 rfm_stat_t RFM_SetBaudRate(uint32_t baud_rate) {
     uint32_t NCO = genConf.f_xtal | 0x04000000;
     baud_rate *= 40;
-    rfm_sp_cmd_t cmd = {
-        .cmd = SET_PROPERTY,
-        .group = PROP_GROUP_MODEM,
-        .num_byte = 0x07,
-        .offset = 0x03,
-        .arg = {EXT_GET_REG_BYTE(baud_rate, 2), EXT_GET_REG_BYTE(baud_rate, 1), EXT_GET_REG_BYTE(baud_rate, 0),
-                EXT_GET_REG_BYTE(NCO, 3), EXT_GET_REG_BYTE(NCO, 2), EXT_GET_REG_BYTE(NCO, 1),
-                EXT_GET_REG_BYTE(NCO, 0)}
-    };
+    const uint8_t arg[] = { EXT_GET_REG_BYTE(baud_rate, 2), EXT_GET_REG_BYTE(baud_rate, 1),
+                            EXT_GET_REG_BYTE(baud_rate, 0), EXT_GET_REG_BYTE(NCO, 3),
+                            EXT_GET_REG_BYTE(NCO, 2),       EXT_GET_REG_BYTE(NCO, 1),
+                            EXT_GET_REG_BYTE(NCO, 0) };
 
-    return rfm_spi_tx(&cmd, cmd.num_byte + 4);
+    return _rfm_set_prop(PROP_GROUP_MODEM, 0x03, arg, sizeof(arg));
 }
 
 rfm_stat_t RFM_SetModulation(rfm_mod_t mod) {
-    rfm_sp_cmd_t cmd = {
-        .cmd = SET_PROPERTY,
-        .group = PROP_GROUP_MODEM,
-        .num_byte = 0x01,
-        .offset = 0x00,
-        .arg = { mod & 0x07 },
-    };
-
-    return rfm_spi_tx(&cmd, cmd.num_byte + 4);
+    const uint8_t arg = mod & 0x07;
+    return _rfm_set_prop(PROP_GROUP_MODEM, 0x00, &arg, 1);
 }
 
-rfm_stat_t RFM_SetSyncWord(uint8_t *sync_word, uint8_t sync_len) {
-    rfm_sp_cmd_t cmd = {
-        .cmd = SET_PROPERTY,
-        .group = PROP_GROUP_SYNC,
-        .num_byte = 0x05,
-        .offset = 0x00,
-        .arg = { 0 },
-    };
-    cmd.arg[0] = (sync_len - 1) & 0x03;
-    memcpy(cmd.arg + 1, sync_word, sync_len);
+rfm_stat_t RFM_SetSyncWord(const uint8_t *sync_word, uint8_t sync_len) {
+    uint8_t arg[5] = { 0 };
+    arg[0] = (sync_len - 1) & 0x03;
+    memcpy(arg + 1, sync_word, sync_len);
 
-    return rfm_spi_tx(&cmd, cmd.num_byte + 4);
+    return _rfm_set_prop(PROP_GROUP_SYNC, 0x00, arg, sizeof(arg));
 }
 
 rfm_stat_t RFM_SetPreambleLen(uint8_t len) {
-    rfm_sp_cmd_t cmd = {
-        .cmd = SET_PROPERTY,
-        .group = PROP_GROUP_PREAMBLE,
-        .num_byte = 0x01,
-        .offset = 0x00,
-        .arg = { len },
-    };
-
-    return rfm_spi_tx(&cmd, cmd.num_byte + 4);
+    return _rfm_set_prop(PROP_GROUP_PREAMBLE, 0x00, &len, 1);
 }
 
 rfm_stat_t RFM_SelectCRC(rfm_crc_t crc) {
-    rfm_sp_cmd_t cmd = {
-        .cmd = SET_PROPERTY,
-        .group = PROP_GROUP_PKT,
-        .num_byte = 0x01,
-        .offset = 0x00,
-        .arg = { crc & 0x0f },
-    };
-
-    return rfm_spi_tx(&cmd, cmd.num_byte + 4);
+    const uint8_t arg = crc & 0x0f;
+    return _rfm_set_prop(PROP_GROUP_PKT, 0x00, &arg, 1);
 }
 
 rfm_stat_t RFM_SetPayloadLen(uint8_t payload_len) {
     genConf.payloadLen = payload_len;
-    rfm_sp_cmd_t cmd = {
-        .cmd = SET_PROPERTY,
-        .group = PROP_GROUP_PKT,
-        .num_byte = 0x03,
-        .offset = 0x0C,
-        .arg = {payload_len, 0x00, payload_len},
-    };
+    const uint8_t arg[] = { payload_len, 0x00, payload_len };
 
-    return rfm_spi_tx(&cmd, cmd.num_byte + 4);
+    return _rfm_set_prop(PROP_GROUP_PKT, 0x0C, arg, sizeof(arg));
 }
 
 rfm_stat_t RFM_SetVarPktMode() {
     genConf.variablePkt = 1;
-    rfm_sp_cmd_t cmd = {
-        .cmd = SET_PROPERTY,
-        .group = PROP_GROUP_PKT,
-        .num_byte = 0x04,
-        .offset = 0x06,
-        .arg = {0x00, 0x00, 0x0A, 0x01}
-    };
+    const uint8_t arg[] = { 0x00, 0x00, 0x0A, 0x01 };
 
-    return rfm_spi_tx(&cmd, cmd.num_byte + 4);
+    return _rfm_set_prop(PROP_GROUP_PKT, 0x06, arg, sizeof(arg));
 }
 
 rfm_stat_t RFM_SetMode(rfm_mode_t mode) {
@@ -303,10 +493,131 @@ rfm_stat_t RFM_GetChipStatus(uint8_t *status) {
     return rfm_spi_rx(&cmd, 1, status, 5) != RFM_OK;
 }
 
+rfm_stat_t RFM_GetRssi(int16_t *rssi) {
+    uint8_t    cmd[2] = { GET_MODEM_STATUS, 0xFF }; /* pending interrupts are kept */
+    uint8_t    status[5];
+    rfm_stat_t stat = rfm_spi_rx(cmd, sizeof(cmd), status, sizeof(status));
+
+    /* CTS, MODEM_PEND, MODEM_STATUS, CURR_RSSI, LATCH_RSSI. half dB steps, offset of the chip */
+    *rssi = (int16_t) (status[4] >> 1) - RSSI_OFFSET_DBM;
+    return stat;
+}
+
 void RFM_SPI_SemRelease() {
-    tx_semaphore_put(&semRFM_SPI);
+    switch (async.state) {
+        case ASYNC_TX_CMD:
+            HAL_GPIO_WritePin(ISM_NSS_GPIO_Port, ISM_NSS_Pin, GPIO_PIN_SET);
+            async.state = ASYNC_TX_CTS;
+            break;
+        case ASYNC_RX_CMD:
+            HAL_GPIO_WritePin(ISM_NSS_GPIO_Port, ISM_NSS_Pin, GPIO_PIN_SET);
+            async.state = ASYNC_RX_CTS;
+            break;
+        case ASYNC_RX_LEN:
+            HAL_GPIO_WritePin(ISM_NSS_GPIO_Port, ISM_NSS_Pin, GPIO_PIN_SET);
+            *async.size = (spiBuf[1] < RFM_FIFO_SIZE) ? (spiBuf[1]) : (RFM_FIFO_SIZE - 1);
+            async.state = ASYNC_RX_DATA;
+            spiBuf[0] = READ_RX_FIFO;
+            if (_rfm_spi_start(*async.size + 1, 1) != RFM_OK) {
+                _rfm_async_done(RFM_ERR_SPI);
+            }
+            break;
+        case ASYNC_RX_DATA:
+            HAL_GPIO_WritePin(ISM_NSS_GPIO_Port, ISM_NSS_Pin, GPIO_PIN_SET);
+            memcpy(async.data, spiBuf + 1, *async.size);
+            _rfm_async_done(RFM_OK);
+            break;
+        case ASYNC_ABORT:
+            HAL_GPIO_WritePin(ISM_NSS_GPIO_Port, ISM_NSS_Pin, GPIO_PIN_SET);
+            break;
+        default:
+            tx_semaphore_put(&semRFM_SPI);
+            break;
+    }
 }
 
 void RFM_SemRelease() {
-    tx_semaphore_put(&semRFM);
-}
\ No newline at end of file
+    switch (async.state) {
+        case ASYNC_TX_CTS:
+            async.state = ASYNC_TX;
+            break;
+        case ASYNC_RX_CTS:
+            async.state = ASYNC_RX;
+            break;
+        case ASYNC_TX:
+            _rfm_async_done(RFM_OK);
+            break;
+        case ASYNC_RX:
+            spiBuf[0] = READ_RX_FIFO;
+            if (genConf.variablePkt) {
+                async.state = ASYNC_RX_LEN;
+                if (_rfm_spi_start(2, 1) != RFM_OK) {
+                    _rfm_async_done(RFM_ERR_SPI);
+                }
+            } else {
+                *async.size = genConf.payloadLen;
+                async.state = ASYNC_RX_DATA;
+                if (_rfm_spi_start(*async.size + 1, 1) != RFM_OK) {
+                    _rfm_async_done(RFM_ERR_SPI);
+                }
+            }
+            break;
+        case ASYNC_ABORT:
+            async.state = ASYNC_IDLE;
+            tx_semaphore_put(&semRFM);
+            break;
+        default:
+            tx_semaphore_put(&semRFM);
+            break;
+    }
+}
+
+static rfm_stat_t _rfm_ops_config(const rfm_settings_t *set) {
+    rfm_config_t config = {
+        .frequency = set->frequency,
+        .deviation = set->deviation,
+        .baud_rate = set->baud_rate,
+        .preamble_len = set->preamble_len,
+        .payload_len = set->payload_len,
+        .sync_len = set->sync_len,
+        .modulation = set->gfsk ? RFM_MOD_2GFSK : RFM_MOD_2FSK,
+        .crc = CCITT_16,
+        .variablePkt = set->variable,
+    };
+    memcpy(config.sync_word, set->sync_word, set->sync_len);
+    return RFM_Config(&config);
+}
+
+/* RX filter comes with the configuration array */
+static rfm_stat_t _rfm_ops_set_rate(uint32_t baud_rate, uint32_t deviation, uint32_t bandwidth) {
+    UNUSED(bandwidth);
+    return RFM_ConfigBegin() | RFM_SetBaudRate(baud_rate) | RFM_SetDeviation(deviation) | RFM_ConfigCommit();
+}
+
+static rfm_stat_t _rfm_ops_standby(void) {
+    return RFM_SetMode(RFM_MODE_READY);
+}
+
+static rfm_stat_t _rfm_ops_sleep(void) {
+    return RFM_SetMode(RFM_MODE_SLEEP);
+}
+
+const rfm_ops_t RFM66A_Ops = {
+    .init = RFM_Init,
+    .config = _rfm_ops_config,
+    .set_freq = RFM_SetFrequency,
+    .set_sync = RFM_SetSyncWord,
+    .set_rate = _rfm_ops_set_rate,
+    .config_begin = RFM_ConfigBegin,
+    .config_commit = RFM_ConfigCommit,
+    .tx_load = RFM_TxLoad,
+    .tx_start = RFM_TxStart,
+    .tx_async = RFM_TxAsync,
+    .tx = RFM_Tx,
+    .rx = RFM_Rx,
+    .rx_async = RFM_RxAsync,
+    .rx_abort = RFM_RxAbort,
+    .standby = _rfm_ops_standby,
+    .sleep = _rfm_ops_sleep,
+    .get_rssi = RFM_GetRssi,
+};
@@ -13,9 +13,19 @@
 #define countof(_a) (sizeof(_a) / sizeof(*(_a)))
 
 #ifndef clz
+#if defined(__ARM_ARCH)
 #define clz __builtin_clz
+#else
+/* CLZ of ARM gives 32 for zero, the builtin is undefined there on other hosts */
+#define clz(_v) ((_v) ? __builtin_clz(_v) : 32)
+#endif
 #endif    // clz
 
+#ifndef ctz
+/* undefined for zero */
+#define ctz __builtin_ctz
+#endif    // ctz
+
 #define EXT_GET_REG_BYTE(_v, _n) (((_v) >> (_n << 3)) & 0xFFU)
 
 #if defined(__BYTE_ORDER__)
@@ -57,7 +67,11 @@
 #define EXT_device_header   "stm32u5xx_hal.h"
 #define EXT_core_header     "core_cm33.h"
 #define EXT_ll_utils_header "stm32u5xx_ll_utils.h"
-#elif
+#elif defined(TARGET_HOST)
+#define EXT_device_header   "host_hal.h"
+#define EXT_core_header     "host_core.h"
+#define EXT_ll_utils_header "host_ll_utils.h"
+#else
 #error "Current MCU target not supported (see `extm.h' file)"
 #endif
 
@@ -84,5 +98,6 @@
 #include "tx_api.h"
 #endif    // 0
 #define EXT_MS_TO_TICKS(_ms) ((uint32_t) ((_ms) *TX_TIMER_TICKS_PER_SECOND / 1000))
+#define EXT_TICKS_TO_MS(_t)  ((uint32_t) ((uint64_t) (_t) * 1000 / TX_TIMER_TICKS_PER_SECOND))
 
 #endif    // EXTM_H
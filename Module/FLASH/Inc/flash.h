@@ -14,6 +14,30 @@
 #include "is25l.h"
 #include <stdbool.h>
 
+/* Slots of the write-behind queue, a page of data or an erase each */
+#ifndef FLASH_ASYNC_SLOTS
+#define FLASH_ASYNC_SLOTS (8U)
+#endif    // FLASH_ASYNC_SLOTS
+
+/* of the flash worker thread doing queued requests */
+#ifndef FLASH_ASYNC_PRIORITY
+#define FLASH_ASYNC_PRIORITY (12U)
+#endif    // FLASH_ASYNC_PRIORITY
+
+/* Lines of the RAM cache, taken by the least recent use: pages of data read, 256 bytes each */
+#ifndef FLASH_CACHE_PAGES
+#define FLASH_CACHE_PAGES (8U)
+#endif    // FLASH_CACHE_PAGES
+
+/* and sectors of FLASH_CacheWrite() data kept until FLASH_Sync(), 4 KB each */
+#ifndef FLASH_CACHE_SECTORS
+#define FLASH_CACHE_SECTORS (2U)
+#endif    // FLASH_CACHE_SECTORS
+
+#if (FLASH_CACHE_PAGES < 1U) || (FLASH_CACHE_SECTORS < 1U)
+#error "FLASH_CACHE_PAGES and FLASH_CACHE_SECTORS: a line of each at least"
+#endif
+
 /**
  * @defgroup FLASH blocks
  * @brief Block bits defines for block protection
@@ -52,6 +76,28 @@ typedef enum {
     FLASH_TX_ERR
 } flash_state_t;    // Usless items will be deleted after writing all the functions
 
+/**
+ * @brief Completion of a queued request, called by the flash worker thread
+ * @param state : Result of the request
+ * @param arg : Argument given with the request
+ * @note Called with no FLASH function in progress, may set an event flag or post to a queue. Queueing more
+ *       requests and FLASH_Flush() fail with FLASH_BUSY here
+ */
+typedef void (*flash_done_t)(flash_state_t state, void *arg);
+
+/**
+ * @struct flash_cache_stats_t
+ * @brief Counters of the RAM cache since FLASH_Init(), by pages of 256 bytes
+ */
+typedef struct {
+    uint32_t read_hits;    /* pages of FLASH_CacheRead() found in RAM */
+    uint32_t read_misses;  /* read from the flash */
+    uint32_t write_hits;   /* pages of FLASH_CacheWrite() in a sector line already */
+    uint32_t write_misses; /* needed the sector read to a line */
+    uint32_t synced;       /* dirty sectors programmed */
+    uint32_t erased;       /* of them needed the sector erase */
+} flash_cache_stats_t;
+
 /**
  * @struct flash_IDinfo_t
  * @brief Struct for remember info from Read_ID
@@ -83,6 +129,7 @@ flash_state_t FLASH_Write(uint8_t *wrBuffer, uint32_t startAddr, uint16_t datLen
 
 /**
  * @brief Function for read smth from chip
+ * @note Data that is in the RAM cache comes from there, no pages are kept by this read
  * @param rdBuffer : Buffer for read data
  * @param startAddr : Read start address
  * @param datLen : Length of data to be read
@@ -91,16 +138,106 @@ flash_state_t FLASH_Read(uint8_t *rdBuffer, uint32_t startAddr, uint16_t datLen)
 
 /**
  * @brief Function for erase smth from chip
- * @param startAddr : Read start address
+ * @note Whole 64 KB blocks and sectors of the range get the native erase, partial sectors at the edges are
+ *       read, erased and written back. Sectors that are empty already are not erased
+ * @param startAddr : Erase start address
  * @param datLen : Length of data to be erased
  */
-flash_state_t FLASH_Erase(uint32_t startAddr, uint16_t datLen);
+flash_state_t FLASH_Erase(uint32_t startAddr, uint32_t datLen);
+
+/**
+ * @brief Function for erase of a whole sector, without read and rewrite of FLASH_Erase()
+ * @param sectorAddr : Start address of the sector
+ */
+flash_state_t FLASH_EraseSector(uint32_t sectorAddr);
+
+/**
+ * @brief Function for read-only access to the flash by pointer, for assets as fonts, images and tables
+ * @note The controller is switched to memory-mapped mode, so the data is read by loads. Commands wait for
+ *       FLASH_Unmap() of all pointers and switch it back, new pointers wait for the command
+ * @attention A thread holding a pointer may read, but must not map again or call the functions that change the
+ *            flash: writes, erases, FLASH_CacheWrite(), FLASH_Sync(), FLASH_Flush(), FLASH_ChangeProtectionStatus()
+ *            and FLASH_Deinit(). They wait for its own FLASH_Unmap() forever
+ * @param startAddr : Start address
+ * @param datLen : Length of data to be accessed
+ * @param ptr : Pointer to the data, valid until FLASH_Unmap()
+ * @note Data of FLASH_CacheWrite() is seen by the pointer after FLASH_Sync()
+ */
+flash_state_t FLASH_Map(uint32_t startAddr, uint32_t datLen, const uint8_t **ptr);
+
+/**
+ * @brief Function for release of a pointer of FLASH_Map()
+ */
+flash_state_t FLASH_Unmap(void);
 
 /**
  * @brief Function for erase all from chip
  */
 flash_state_t FLASH_Erase_Chip(void);
 
+/**
+ * @brief Function for write by the flash worker thread, returns once the data is queued
+ * @note The data is copied, the buffer may be reused right away. The call waits only for a free slot of the
+ *       queue. Queued requests are done in order, other FLASH functions do not wait for them: FLASH_Flush()
+ *       first where the order matters
+ * @param wrBuffer : Buffer for write data
+ * @param startAddr : Write start address
+ * @param datLen : Length of data to be written
+ * @param done : Completion of the write (can be NULL)
+ * @param arg : Argument of done
+ */
+flash_state_t FLASH_WriteAsync(const uint8_t *wrBuffer, uint32_t startAddr, uint16_t datLen, flash_done_t done,
+                               void *arg);
+
+/**
+ * @brief Function for erase by the flash worker thread, as FLASH_Erase() and FLASH_WriteAsync()
+ * @param startAddr : Erase start address
+ * @param datLen : Length of data to be erased
+ * @param done : Completion of the erase (can be NULL)
+ * @param arg : Argument of done
+ */
+flash_state_t FLASH_EraseAsync(uint32_t startAddr, uint32_t datLen, flash_done_t done, void *arg);
+
+/**
+ * @brief Function for waiting until requests queued before are programmed to the flash
+ * @return First failure of queued requests since the last flush, FLASH_OK if none
+ */
+flash_state_t FLASH_Flush(void);
+
+/**
+ * @brief Function for read through the RAM cache, for small reads of neighbouring data
+ * @note Pages missed are read whole and kept in lines, reads longer than half of the page lines are not kept
+ * @param rdBuffer : Buffer for read data
+ * @param startAddr : Read start address
+ * @param datLen : Length of data to be read
+ */
+flash_state_t FLASH_CacheRead(uint8_t *rdBuffer, uint32_t startAddr, uint16_t datLen);
+
+/**
+ * @brief Function for write to the RAM cache, the data replaces what is there without erase by the caller
+ * @note Writes to a sector are collected in its line and programmed by FLASH_Sync() with one read, erase and
+ *       rewrite of the sector at most, and no erase if bits are only cleared. A sector line taken for another
+ *       sector, FLASH_ChangeProtectionStatus() and FLASH_Deinit() program it as well. FLASH_Read() sees the data
+ *       right away, other FLASH functions sync sectors they overlap before they change the flash
+ * @param wrBuffer : Buffer for write data
+ * @param startAddr : Write start address
+ * @param datLen : Length of data to be written
+ */
+flash_state_t FLASH_CacheWrite(const uint8_t *wrBuffer, uint32_t startAddr, uint16_t datLen);
+
+/**
+ * @brief Function for programming all data of FLASH_CacheWrite() to the flash
+ * @return First failure, sectors that failed stay in RAM for the next sync. FLASH_PARAM_ERR for a sector under
+ *         block protection, it is not programmed until FLASH_ChangeProtectionStatus() lifts it
+ */
+flash_state_t FLASH_Sync(void);
+
+/**
+ * @brief Function for getting counters of the RAM cache
+ * @param stats : Counters
+ */
+flash_state_t FLASH_GetCacheStats(flash_cache_stats_t *stats);
+
 /**
  * @brief Function for check block status
  */
@@ -108,6 +245,8 @@ uint8_t FLASH_CheckProtectionStatus(void);
 
 /**
  * @brief Function for change block protection
+ * @note Data of FLASH_CacheWrite() is synced first, so it is programmed under the protection it was written with.
+ *       Data of protected sectors stays in RAM and is programmed by a sync after the change
  * @param rdBuffer : Buffer for write blocks to change protection status
  */
 flash_state_t FLASH_ChangeProtectionStatus(uint8_t blockBuff);
@@ -8,6 +8,8 @@
  */
 
 /* Includes */
+#include <string.h>
+#include "main.h"
 #include "flash.h"
 #define LOG_DEFAULT_MODULE LOG_M_FLASH
 #include "loglib.h"
@@ -17,67 +19,441 @@ static flash_IDinfo_t ID = { 0x00, 0x00, 0x00 };
 /* Mutex */
 static TX_MUTEX muxFLASH;
 
+/* Flag for the last FLASH_Unmap() */
+#define FLASH_FLAG_UNMAPPED 1U
+
+/* Memory-mapped mode: window of the flash, NULL - commands. The controller stays mapped after the last user
+ * until a command is needed */
+static const uint8_t       *mapBase = NULL;
+static volatile uint32_t    mapUsers = 0;
+static volatile bool        mapWaiting = false; /* a command waits for the users, new ones wait for muxFLASH */
+static TX_EVENT_FLAGS_GROUP flagFLASH;
+
+/* Write-behind queue: requests are split to slots of a page, the worker does them in order */
+#define FLASH_STACK_SIZE (2048U)
+
+typedef enum {
+    FLASH_OP_WRITE,
+    FLASH_OP_ERASE,
+    FLASH_OP_FLUSH
+} flash_op_t;
+
+typedef struct {
+    flash_op_t    op;
+    uint32_t      addr;
+    uint32_t      len;
+    bool          last;    /* slot of the request */
+    flash_done_t  done;
+    void         *arg;
+    TX_SEMAPHORE *flushed; /* FLASH_OP_FLUSH */
+    uint8_t       data[IS25L_MEMORY_PAGE_SIZE];
+} flash_slot_t;
+
+static flash_slot_t  slotsFLASH[FLASH_ASYNC_SLOTS];
+static uint32_t      slotHead = 0;
+static uint32_t      slotTail = 0;
+static flash_state_t asyncError = FLASH_OK; /* first failure since FLASH_Flush() */
+static TX_SEMAPHORE  semFree;
+static TX_SEMAPHORE  semUsed;
+static TX_MUTEX      muxAsync; /* keeps slots of a request together */
+static TX_THREAD     taskFLASH;
+static ULONG         stackFLASH[FLASH_STACK_SIZE / sizeof(ULONG)];
+
+static void FLASH_AsyncTask(ULONG arg);
+
+#define FLASH_SECTOR (IS25L_MEMORY_SECTOR_SIZE * 1024U)
+#define FLASH_BLOCK  (IS25L_MEMORY_BBLOCK_SIZE * 1024U)
+/* a block erase takes as long as 4 sector erases, fewer sectors with data are erased one by one */
+#define FLASH_BLOCK_ERASE_MIN 4U
+
+/* Buffer to store the sector data, words for the blank check */
+static uint32_t EraseBUF[FLASH_SECTOR / sizeof(uint32_t)];
+
+/* Check that all bytes are 0xFF (empty by flash logic) */
+static bool FLASH_IsBlank(const uint8_t *data, uint32_t len) {
+    for (; len && ((uintptr_t) data % sizeof(uint32_t)); --len) {
+        if (*data++ != 0xFF) {
+            return false;
+        }
+    }
+    for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t), data += sizeof(uint32_t)) {
+        if (*(const uint32_t *) data != UINT32_MAX) {
+            return false;
+        }
+    }
+    for (; len; --len) {
+        if (*data++ != 0xFF) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Leave memory-mapped mode for a command once all users unmap, called with muxFLASH */
+static flash_state_t FLASH_Indirect(void) {
+    ULONG actual_events;
+
+    if (mapBase == NULL) {
+        return FLASH_OK;
+    }
+    /* New users wait for muxFLASH, so readers coming one after another do not keep the command waiting */
+    mapWaiting = true;
+    while (mapUsers) {
+        tx_event_flags_get(&flagFLASH, FLASH_FLAG_UNMAPPED, TX_OR_CLEAR, &actual_events, TX_WAIT_FOREVER);
+    }
+    mapWaiting = false;
+    if (IS25L_MemoryMappedDisable() != IS25L_OK) {
+        return FLASH_CHIP_ERR;
+    }
+    mapBase = NULL;
+    return FLASH_OK;
+}
+
+/* RAM cache, changed with muxFLASH. A sector line is looked up before page lines, so pages of a sector line are
+ * dropped when it is taken */
+#define FLASH_LINE_EMPTY UINT32_MAX
+
+typedef struct {
+    uint32_t addr;  /* of the page or sector, FLASH_LINE_EMPTY - free */
+    uint32_t used;  /* clock of the last use, the least is taken for another address */
+    uint32_t dirty; /* pages of a sector line changed since the sync */
+} flash_line_t;
+
+static flash_line_t        linesPage[FLASH_CACHE_PAGES];
+static flash_line_t        linesSector[FLASH_CACHE_SECTORS];
+static uint8_t             cachePage[FLASH_CACHE_PAGES][IS25L_MEMORY_PAGE_SIZE];
+static uint32_t            cacheSector[FLASH_CACHE_SECTORS][FLASH_SECTOR / sizeof(uint32_t)];
+static uint32_t            cacheClock = 0;
+static flash_cache_stats_t cacheStats;
+
+/* Read from the chip by commands or by loads while the controller is mapped, called with muxFLASH */
+static flash_state_t FLASH_ReadChip(uint8_t *rdBuffer, uint32_t startAddr, uint16_t datLen) {
+    if (mapBase != NULL) {
+        memcpy(rdBuffer, mapBase + startAddr, datLen);
+        return FLASH_OK;
+    }
+    return (IS25L_FastReadQUADOperation(rdBuffer, startAddr, datLen) == IS25L_OK) ? FLASH_OK : FLASH_CHIP_ERR;
+}
+
+/* Index of the line of the address, count if none. A line found is used */
+static uint32_t FLASH_LineFind(flash_line_t *lines, uint32_t count, uint32_t addr) {
+    for (uint32_t i = 0; i < count; ++i) {
+        if (lines[i].addr == addr) {
+            lines[i].used = ++cacheClock;
+            return i;
+        }
+    }
+    return count;
+}
+
+/* Index of a free line or of the least recently used one */
+static uint32_t FLASH_LineVictim(const flash_line_t *lines, uint32_t count) {
+    uint32_t victim = 0;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (lines[i].addr == FLASH_LINE_EMPTY) {
+            return i;
+        }
+        if ((int32_t) (lines[i].used - lines[victim].used) < 0) {
+            victim = i;
+        }
+    }
+    return victim;
+}
+
+/* Blocks the BP bits of the status register protect, TBS of the default top: the first and the one after the last */
+static const uint8_t protectBlocks[16][2] = {
+    { 0, 0 },  { 63, 64 }, { 62, 64 }, { 60, 64 }, { 56, 64 }, { 48, 64 }, { 32, 64 }, { 0, 64 },
+    { 0, 64 }, { 0, 32 },  { 0, 16 },  { 0, 8 },   { 0, 4 },   { 0, 2 },   { 0, 1 },   { 0, 64 },
+};
+
+/* The chip ignores programs of a protected block without an error, it is checked before. Called with muxFLASH */
+static flash_state_t FLASH_Writable(uint32_t sectorAddr) {
+    const uint8_t *blocks;
+    uint8_t        status;
+
+    if (IS25L_ReadStatusReg(&status) != IS25L_OK) {
+        return FLASH_CHIP_ERR;
+    }
+    blocks = protectBlocks[(status & FLASH_SAVEBITS) >> 2];
+    if (blocks[0] <= sectorAddr / FLASH_BLOCK && sectorAddr / FLASH_BLOCK < blocks[1]) {
+        return FLASH_PARAM_ERR;
+    }
+    return FLASH_OK;
+}
+
+/* Program a dirty sector line: pages are programmed over the flash if bits are only cleared, else the sector is
+ * erased and all its pages with data are programmed back. A protected sector fails with FLASH_PARAM_ERR and its
+ * line stays dirty. Called with muxFLASH */
+static flash_state_t FLASH_SyncLine(uint32_t i) {
+    const uint8_t *data = (const uint8_t *) cacheSector[i];
+    uint8_t *const flash = (uint8_t *) EraseBUF;
+    uint32_t       sectorAddr = linesSector[i].addr;
+    uint32_t       dirty = linesSector[i].dirty;
+    uint32_t       first = 0;
+    uint32_t       last = FLASH_SECTOR / IS25L_MEMORY_PAGE_SIZE - 1U;
+    bool           erase = false;
+    flash_state_t  state;
+
+    if (!dirty) {
+        return FLASH_OK;
+    }
+    while (!(dirty & (1U << first))) {
+        ++first;
+    }
+    while (!(dirty & (1U << last))) {
+        --last;
+    }
+    /* The flash under the dirty pages, words for the compare */
+    first *= IS25L_MEMORY_PAGE_SIZE;
+    last = (last + 1U) * IS25L_MEMORY_PAGE_SIZE;
+    if (FLASH_Indirect() != FLASH_OK) {
+        return FLASH_CHIP_ERR;
+    }
+    if ((state = FLASH_Writable(sectorAddr)) != FLASH_OK) {
+        return state;
+    }
+    if (IS25L_FastReadQUADOperation(flash + first, sectorAddr + first, last - first) != IS25L_OK) {
+        return FLASH_CHIP_ERR;
+    }
+    for (uint32_t w = first / sizeof(uint32_t); w < last / sizeof(uint32_t) && !erase; ++w) {
+        erase = (EraseBUF[w] & cacheSector[i][w]) != cacheSector[i][w];
+    }
+
+    if (erase) {
+        if (IS25L_EraseSector(sectorAddr) != IS25L_OK) {
+            return FLASH_CHIP_ERR;
+        }
+        ++cacheStats.erased;
+        /* All pages are to program now, also for a retry after a failure */
+        dirty = linesSector[i].dirty = (1U << (FLASH_SECTOR / IS25L_MEMORY_PAGE_SIZE)) - 1U;
+    }
+    for (uint32_t page = 0; page < FLASH_SECTOR; page += IS25L_MEMORY_PAGE_SIZE) {
+        if (!(dirty & (1U << (page / IS25L_MEMORY_PAGE_SIZE)))) {
+            continue;
+        }
+        /* An erased page takes data, else only a page that differs */
+        if (erase ? !FLASH_IsBlank(data + page, IS25L_MEMORY_PAGE_SIZE)
+                  : memcmp(data + page, flash + page, IS25L_MEMORY_PAGE_SIZE) != 0) {
+            if (IS25L_WritePPQ((uint8_t *) data + page, sectorAddr + page, IS25L_MEMORY_PAGE_SIZE) != IS25L_OK) {
+                return FLASH_CHIP_ERR;
+            }
+        }
+    }
+    linesSector[i].dirty = 0;
+    ++cacheStats.synced;
+    return FLASH_OK;
+}
+
+/* Sync of all sector lines, called with muxFLASH. Returns the first failure */
+static flash_state_t FLASH_SyncAll(void) {
+    flash_state_t state = FLASH_OK;
+
+    for (uint32_t i = 0; i < FLASH_CACHE_SECTORS; ++i) {
+        flash_state_t line = FLASH_SyncLine(i);
+
+        if (state == FLASH_OK) {
+            state = line;
+        }
+    }
+    return state;
+}
+
+/* Drop lines of a range a command changes on the flash, called with muxFLASH. Dirty sectors are synced first,
+ * but a sector the command erases whole has its data dropped */
+static flash_state_t FLASH_CacheDrop(uint32_t startAddr, uint32_t datLen, bool erase) {
+    uint32_t      endAddr = startAddr + datLen;
+    flash_state_t state;
+
+    for (uint32_t i = 0; i < FLASH_CACHE_PAGES; ++i) {
+        if (linesPage[i].addr != FLASH_LINE_EMPTY && linesPage[i].addr < endAddr &&
+            startAddr < linesPage[i].addr + IS25L_MEMORY_PAGE_SIZE) {
+            linesPage[i].addr = FLASH_LINE_EMPTY;
+        }
+    }
+    for (uint32_t i = 0; i < FLASH_CACHE_SECTORS; ++i) {
+        uint32_t sectorAddr = linesSector[i].addr;
+
+        if (sectorAddr == FLASH_LINE_EMPTY || sectorAddr >= endAddr || startAddr >= sectorAddr + FLASH_SECTOR) {
+            continue;
+        }
+        if (!(erase && startAddr <= sectorAddr && sectorAddr + FLASH_SECTOR <= endAddr) &&
+            (state = FLASH_SyncLine(i)) != FLASH_OK) {
+            return state;
+        }
+        linesSector[i].addr = FLASH_LINE_EMPTY;
+        linesSector[i].dirty = 0;
+    }
+    return FLASH_OK;
+}
+
 /* Function for init flash */
 flash_state_t FLASH_Init(void) {
-    flash_state_t state = FLASH_OK;
+    flash_state_t state = FLASH_TX_ERR;
 
     if (tx_mutex_create(&muxFLASH, "FLASH Common Mutex", TX_NO_INHERIT) != TX_SUCCESS) {
-        return IS25L_TX_ERR;
+        return FLASH_TX_ERR;
+    }
+    if (tx_event_flags_create(&flagFLASH, "FLASH Flag") != TX_SUCCESS) {
+        goto deleteMux;
+    }
+
+    slotHead = slotTail = 0;
+    asyncError = FLASH_OK;
+    for (uint32_t i = 0; i < FLASH_CACHE_PAGES; ++i) {
+        linesPage[i].addr = FLASH_LINE_EMPTY;
+    }
+    for (uint32_t i = 0; i < FLASH_CACHE_SECTORS; ++i) {
+        linesSector[i].addr = FLASH_LINE_EMPTY;
+        linesSector[i].dirty = 0;
+    }
+    memset(&cacheStats, 0, sizeof(cacheStats));
+    if (tx_mutex_create(&muxAsync, "FLASH Async Mutex", TX_NO_INHERIT) != TX_SUCCESS) {
+        goto deleteFlag;
+    }
+    if (tx_semaphore_create(&semFree, "FLASH Free Slots", FLASH_ASYNC_SLOTS) != TX_SUCCESS) {
+        goto deleteAsync;
+    }
+    if (tx_semaphore_create(&semUsed, "FLASH Used Slots", 0) != TX_SUCCESS) {
+        goto deleteFree;
+    }
+    if (tx_thread_create(&taskFLASH, "FLASH Worker", FLASH_AsyncTask, 0, stackFLASH, sizeof(stackFLASH),
+                         FLASH_ASYNC_PRIORITY, FLASH_ASYNC_PRIORITY, TX_NO_TIME_SLICE, TX_AUTO_START) != TX_SUCCESS) {
+        goto deleteUsed;
     }
 
     tx_mutex_get(&muxFLASH, TX_WAIT_FOREVER);
 
+    state = FLASH_CHIP_ERR;
     if (IS25L_Init() != IS25L_OK) {
-        state = FLASH_CHIP_ERR;
         goto quit;
     }
 
     uint8_t Buf_ID[3];
 
-    if (IS25L_ReadID(Buf_ID) != IS25L_OK) {
-        state = FLASH_CHIP_ERR;
-        goto quit;
-    }
-
-    ID.Manufacturer = Buf_ID[0];
-    ID.Type = Buf_ID[1];
-
-    if (Buf_ID[2] == 0x16) {
+    if (IS25L_ReadID(Buf_ID) == IS25L_OK && Buf_ID[2] == 0x16) {
+        ID.Manufacturer = Buf_ID[0];
+        ID.Type = Buf_ID[1];
         ID.Capacity = IS25L_MEMORY_SIZE;
+        state = FLASH_OK;
     } else {
-        state = FLASH_CHIP_ERR;
+        IS25L_Deinit();
     }
 quit:
     tx_mutex_put(&muxFLASH);
+    if (state == FLASH_OK) {
+        return state;
+    }
+
+    /* Objects created before a failure are deleted, so FLASH_Init() can be called again */
+    tx_thread_terminate(&taskFLASH);
+    tx_thread_delete(&taskFLASH);
+deleteUsed:
+    tx_semaphore_delete(&semUsed);
+deleteFree:
+    tx_semaphore_delete(&semFree);
+deleteAsync:
+    tx_mutex_delete(&muxAsync);
+deleteFlag:
+    tx_event_flags_delete(&flagFLASH);
+deleteMux:
+    tx_mutex_delete(&muxFLASH);
     return state;
 }
 
 /* Function for Deinit flash */
 flash_state_t FLASH_Deinit(void) {
+    FLASH_Flush();
+    tx_thread_terminate(&taskFLASH);
+
     tx_mutex_get(&muxFLASH, TX_WAIT_FOREVER);
 
-    if (IS25L_Deinit() != IS25L_OK) {
+    if (FLASH_SyncAll() != FLASH_OK || FLASH_Indirect() != FLASH_OK || IS25L_Deinit() != IS25L_OK) {
+        tx_mutex_put(&muxFLASH);
         return FLASH_CHIP_ERR;
     }
 
     tx_mutex_put(&muxFLASH);
 
-    if (tx_mutex_delete(&muxFLASH) != TX_SUCCESS) {
+    if (tx_mutex_delete(&muxFLASH) != TX_SUCCESS || tx_event_flags_delete(&flagFLASH) != TX_SUCCESS ||
+        tx_thread_delete(&taskFLASH) != TX_SUCCESS || tx_semaphore_delete(&semFree) != TX_SUCCESS ||
+        tx_semaphore_delete(&semUsed) != TX_SUCCESS || tx_mutex_delete(&muxAsync) != TX_SUCCESS) {
         return FLASH_TX_ERR;
     }
 
     return FLASH_OK;
 }
 
+/* Read through lines of the cache, called with muxFLASH. Pages missed are kept in lines for a cache read,
+ * a long one does not take lines of short ones */
+static flash_state_t FLASH_ReadLines(uint8_t *rdBuffer, uint32_t startAddr, uint16_t datLen, bool cache) {
+    bool     keep = cache && datLen <= FLASH_CACHE_PAGES * IS25L_MEMORY_PAGE_SIZE / 2U;
+    /* Pages missed in a row are read at once */
+    uint8_t *missBuffer = rdBuffer;
+    uint32_t missAddr = startAddr;
+    uint16_t missLen = 0;
+
+    while (datLen) {
+        uint32_t       shift = startAddr % IS25L_MEMORY_PAGE_SIZE;
+        uint16_t       currentDataLenght = IS25L_MEMORY_PAGE_SIZE - shift;
+        const uint8_t *line = NULL;
+        uint32_t       i;
+
+        if (currentDataLenght > datLen) {
+            currentDataLenght = datLen;
+        }
+        i = FLASH_LineFind(linesSector, FLASH_CACHE_SECTORS, startAddr - startAddr % FLASH_SECTOR);
+        if (i < FLASH_CACHE_SECTORS) {
+            line = (const uint8_t *) cacheSector[i] + startAddr % FLASH_SECTOR - shift;
+        } else if ((i = FLASH_LineFind(linesPage, FLASH_CACHE_PAGES, startAddr - shift)) < FLASH_CACHE_PAGES) {
+            line = cachePage[i];
+        }
+
+        if (cache && line != NULL) {
+            ++cacheStats.read_hits;
+        } else if (cache) {
+            ++cacheStats.read_misses;
+        }
+        if (line == NULL && keep) {
+            i = FLASH_LineVictim(linesPage, FLASH_CACHE_PAGES);
+            linesPage[i].addr = FLASH_LINE_EMPTY;
+            if (FLASH_ReadChip(cachePage[i], startAddr - shift, IS25L_MEMORY_PAGE_SIZE) != FLASH_OK) {
+                return FLASH_CHIP_ERR;
+            }
+            linesPage[i].addr = startAddr - shift;
+            linesPage[i].used = ++cacheClock;
+            line = cachePage[i];
+        }
+
+        if (line != NULL) {
+            if (missLen && FLASH_ReadChip(missBuffer, missAddr, missLen) != FLASH_OK) {
+                return FLASH_CHIP_ERR;
+            }
+            memcpy(rdBuffer, line + shift, currentDataLenght);
+            missLen = 0;
+        } else {
+            if (!missLen) {
+                missBuffer = rdBuffer;
+                missAddr = startAddr;
+            }
+            missLen += currentDataLenght;
+        }
+
+        rdBuffer += currentDataLenght;
+        startAddr += currentDataLenght;
+        datLen -= currentDataLenght;
+    }
+    return (missLen && FLASH_ReadChip(missBuffer, missAddr, missLen) != FLASH_OK) ? FLASH_CHIP_ERR : FLASH_OK;
+}
+
 /* Function for information read */
 flash_state_t FLASH_Read(uint8_t *rdBuffer, uint32_t startAddr, uint16_t datLen) {
+    flash_state_t state;
 
     tx_mutex_get(&muxFLASH, TX_WAIT_FOREVER);
-    if (IS25L_FastReadQUADOperation(rdBuffer, startAddr, datLen) != IS25L_OK) {
-        return FLASH_CHIP_ERR;
-    }
+    state = FLASH_ReadLines(rdBuffer, startAddr, datLen, false);
     tx_mutex_put(&muxFLASH);
-    return FLASH_OK;
+    return state;
 }
 
 /* Function for information write */
@@ -86,6 +462,11 @@ flash_state_t FLASH_Write(uint8_t *wrBuffer, uint32_t startAddr, uint16_t datLen
 
     tx_mutex_get(&muxFLASH, TX_WAIT_FOREVER);
 
+    if (FLASH_Indirect() != FLASH_OK || FLASH_CacheDrop(startAddr, datLen, false) != FLASH_OK) {
+        state = FLASH_CHIP_ERR;
+        goto quit;
+    }
+
     /* Counter: how many bytes there is to write */
     uint16_t bytesCounter = datLen;
     /* Current address of the flash memory */
@@ -133,87 +514,462 @@ quit:
 
 /* Function for full Flash erase */
 flash_state_t FLASH_Erase_Chip(void) {
+    flash_state_t state = FLASH_OK;
+
     tx_mutex_get(&muxFLASH, TX_WAIT_FOREVER);
-    if (IS25L_EraseChip() != IS25L_OK) {
-        return FLASH_CHIP_ERR;
+    if (FLASH_Indirect() != FLASH_OK || FLASH_CacheDrop(0, IS25L_EDGE + 1U, true) != FLASH_OK ||
+        IS25L_EraseChip() != IS25L_OK) {
+        state = FLASH_CHIP_ERR;
     }
     tx_mutex_put(&muxFLASH);
+    return state;
+}
+
+/* Erase of a part of one sector: read, erase and program back only pages that keep data */
+static flash_state_t FLASH_EraseEdge(uint32_t startAddr, uint32_t datLen) {
+    uint8_t *const buf = (uint8_t *) EraseBUF;
+    uint32_t       sectorAddress = startAddr - startAddr % FLASH_SECTOR;
+    uint32_t       shift = startAddr - sectorAddress;
+
+    if (IS25L_FastReadQUADOperation(buf, sectorAddress, FLASH_SECTOR) != IS25L_OK) {
+        return FLASH_CHIP_ERR;
+    }
+    /* Nothing to do if the part is empty already */
+    if (FLASH_IsBlank(buf + shift, datLen)) {
+        return FLASH_OK;
+    }
+    memset(buf + shift, 0xFF, datLen);
+
+    if (IS25L_EraseSector(sectorAddress) != IS25L_OK) {
+        return FLASH_CHIP_ERR;
+    }
+    for (uint32_t page = 0; page < FLASH_SECTOR; page += IS25L_MEMORY_PAGE_SIZE) {
+        if (!FLASH_IsBlank(buf + page, IS25L_MEMORY_PAGE_SIZE) &&
+            IS25L_WritePPQ(buf + page, sectorAddress + page, IS25L_MEMORY_PAGE_SIZE) != IS25L_OK) {
+            return FLASH_CHIP_ERR;
+        }
+    }
+    return FLASH_OK;
+}
+
+/* Erase of whole sectors, a sector or a block, skips empty sectors */
+static flash_state_t FLASH_EraseWhole(uint32_t startAddr, uint32_t datLen) {
+    uint32_t dirty = 0;
+    uint32_t count = 0;
+
+    /* Mark sectors with data, the check stops on the first byte of data */
+    for (uint32_t i = 0; i < datLen / FLASH_SECTOR; ++i) {
+        for (uint32_t offset = 0; offset < FLASH_SECTOR; offset += IS25L_MEMORY_PAGE_SIZE * 4U) {
+            if (IS25L_FastReadQUADOperation((uint8_t *) EraseBUF, startAddr + i * FLASH_SECTOR + offset,
+                                            IS25L_MEMORY_PAGE_SIZE * 4U) != IS25L_OK) {
+                return FLASH_CHIP_ERR;
+            }
+            if (!FLASH_IsBlank((uint8_t *) EraseBUF, IS25L_MEMORY_PAGE_SIZE * 4U)) {
+                dirty |= 1U << i;
+                ++count;
+                break;
+            }
+        }
+    }
+
+    if (datLen == FLASH_BLOCK && count >= FLASH_BLOCK_ERASE_MIN) {
+        return (IS25L_EraseBlock(startAddr) == IS25L_OK) ? FLASH_OK : FLASH_CHIP_ERR;
+    }
+    for (uint32_t i = 0; dirty; ++i, dirty >>= 1) {
+        if ((dirty & 1U) && IS25L_EraseSector(startAddr + i * FLASH_SECTOR) != IS25L_OK) {
+            return FLASH_CHIP_ERR;
+        }
+    }
     return FLASH_OK;
 }
 
-/* Buffer to store the sector data */
-static uint8_t EraseBUF[4096];
+/* Erase of a range, called with muxFLASH.
+ * Plan: partial head sector, whole 64 KB blocks and sectors, partial tail sector */
+static flash_state_t FLASH_ErasePlan(uint32_t startAddr, uint32_t datLen) {
+    flash_state_t state = FLASH_OK;
+
+    while (datLen && state == FLASH_OK) {
+        /* Counter: queue for how many bytes will be erased during iteration */
+        uint32_t currentDataLenght;
+
+        if (!(startAddr % FLASH_BLOCK) && datLen >= FLASH_BLOCK) {
+            currentDataLenght = FLASH_BLOCK;
+            state = FLASH_EraseWhole(startAddr, currentDataLenght);
+        } else if (!(startAddr % FLASH_SECTOR) && datLen >= FLASH_SECTOR) {
+            currentDataLenght = FLASH_SECTOR;
+            state = FLASH_EraseWhole(startAddr, currentDataLenght);
+        } else {
+            /* Head and tail in one sector take one read and rewrite */
+            currentDataLenght = FLASH_SECTOR - startAddr % FLASH_SECTOR;
+            if (currentDataLenght > datLen) {
+                currentDataLenght = datLen;
+            }
+            state = FLASH_EraseEdge(startAddr, currentDataLenght);
+        }
+        startAddr += currentDataLenght;
+        datLen -= currentDataLenght;
+    }
+    return state;
+}
+
 /* Function for selective Flash erase */
-flash_state_t FLASH_Erase(uint32_t startAddr, uint16_t datLen) {
+flash_state_t FLASH_Erase(uint32_t startAddr, uint32_t datLen) {
+    flash_state_t state;
+
     /* Return error in case user erases data by address beyond flash's capacity */
-    if ((startAddr + (uint32_t) datLen) > IS25L_EDGE) {
+    if (startAddr > IS25L_EDGE || datLen > IS25L_EDGE + 1U - startAddr) {
         return FLASH_PARAM_ERR;
     }
     tx_mutex_get(&muxFLASH, TX_WAIT_FOREVER);
-    /* Get current sector number */
-    uint32_t sectorNumber = startAddr / (IS25L_MEMORY_SECTOR_SIZE * 1024U);
-    /* Get current sector address */
-    uint32_t sectorAddress = SectorToAddress(sectorNumber);
-    /* Current address of the flash memory */
-    uint32_t currentAddr = startAddr;
 
-    /* Get buffer element number relative to sector address */
-    uint16_t bufElementNumber = startAddr % (IS25L_MEMORY_SECTOR_SIZE * 1024U);
-    /* Counter: how many bytes there is to erase */
-    uint16_t bytesCounter = datLen;
-    /* Counter: queue for how many bytes will be erased during iteration */
-    uint16_t currentDataLenght = 0;
-    /* Flag to indicate if area for erase crosses sector's border */
-    uint8_t flagSequence = 0;
+    state = FLASH_Indirect();
+    if (state == FLASH_OK) {
+        state = FLASH_CacheDrop(startAddr, datLen, true);
+    }
+    if (state == FLASH_OK) {
+        state = FLASH_ErasePlan(startAddr, datLen);
+    }
 
-    while (1) {
-        /* Check if area of erase crosses sector's border */
-        if (((currentAddr % (IS25L_MEMORY_SECTOR_SIZE * 1024U)) + bytesCounter) > (IS25L_MEMORY_SECTOR_SIZE * 1024U)) {
-            flagSequence = 1;
-            currentDataLenght = (IS25L_MEMORY_SECTOR_SIZE * 1024U) - bufElementNumber;
-        } else {
-            currentDataLenght = bytesCounter;
+    tx_mutex_put(&muxFLASH);
+    return state;
+}
+
+/* Function for erase of one sector */
+flash_state_t FLASH_EraseSector(uint32_t sectorAddr) {
+    flash_state_t state = FLASH_OK;
+
+    if (sectorAddr > IS25L_EDGE || sectorAddr % FLASH_SECTOR) {
+        return FLASH_PARAM_ERR;
+    }
+    tx_mutex_get(&muxFLASH, TX_WAIT_FOREVER);
+    if (FLASH_Indirect() != FLASH_OK || FLASH_CacheDrop(sectorAddr, FLASH_SECTOR, true) != FLASH_OK ||
+        IS25L_EraseSector(sectorAddr) != IS25L_OK) {
+        state = FLASH_CHIP_ERR;
+    }
+    tx_mutex_put(&muxFLASH);
+    return state;
+}
+
+/* Function for read-only access by pointer */
+flash_state_t FLASH_Map(uint32_t startAddr, uint32_t datLen, const uint8_t **ptr) {
+    flash_state_t state = FLASH_OK;
+    TX_INTERRUPT_SAVE_AREA
+
+    if (ptr == NULL || startAddr > IS25L_EDGE || datLen > IS25L_EDGE + 1U - startAddr) {
+        return FLASH_PARAM_ERR;
+    }
+
+    /* Join pointers held already without muxFLASH, unless a command holding it waits for them */
+    TX_DISABLE
+    if (mapUsers && !mapWaiting) {
+        ++mapUsers;
+        *ptr = mapBase + startAddr;
+        TX_RESTORE
+        return FLASH_OK;
+    }
+    TX_RESTORE
+
+    tx_mutex_get(&muxFLASH, TX_WAIT_FOREVER);
+
+    if (mapBase == NULL && IS25L_MemoryMappedEnable(&mapBase) != IS25L_OK) {
+        mapBase = NULL;
+        state = FLASH_CHIP_ERR;
+        goto quit;
+    }
+
+    TX_DISABLE
+    ++mapUsers;
+    TX_RESTORE
+
+    *ptr = mapBase + startAddr;
+
+quit:
+    tx_mutex_put(&muxFLASH);
+    return state;
+}
+
+/* Function for release of FLASH_Map() pointer */
+flash_state_t FLASH_Unmap(void) {
+    uint32_t users;
+    TX_INTERRUPT_SAVE_AREA
+
+    /* Without muxFLASH, a command may hold it waiting for this */
+    TX_DISABLE
+    users = mapUsers;
+    if (users) {
+        mapUsers = users - 1U;
+    }
+    TX_RESTORE
+
+    if (!users) {
+        return FLASH_PARAM_ERR;
+    }
+    if (users == 1U) {
+        tx_event_flags_set(&flagFLASH, FLASH_FLAG_UNMAPPED, TX_OR);
+    }
+    return FLASH_OK;
+}
+
+/* Worker of the write-behind queue */
+static void FLASH_AsyncTask(ULONG arg) {
+    /* Of the request in progress, the rest of it is dropped after a failure */
+    flash_state_t state = FLASH_OK;
+    uint8_t       regist_buf;
+
+    UNUSED(arg);
+
+    while (tx_semaphore_get(&semUsed, TX_WAIT_FOREVER) == TX_SUCCESS) {
+        flash_slot_t *slot = &slotsFLASH[slotTail];
+
+        tx_mutex_get(&muxFLASH, TX_WAIT_FOREVER);
+        switch (slot->op) {
+            case FLASH_OP_WRITE:
+                if (state == FLASH_OK && (FLASH_Indirect() != FLASH_OK ||
+                                          FLASH_CacheDrop(slot->addr, slot->len, false) != FLASH_OK ||
+                                          IS25L_WritePPQ(slot->data, slot->addr, slot->len) != IS25L_OK)) {
+                    state = FLASH_CHIP_ERR;
+                }
+                break;
+            case FLASH_OP_ERASE:
+                if (state == FLASH_OK && (state = FLASH_Indirect()) == FLASH_OK &&
+                    (state = FLASH_CacheDrop(slot->addr, slot->len, true)) == FLASH_OK) {
+                    state = FLASH_ErasePlan(slot->addr, slot->len);
+                }
+                break;
+            default:
+                /* Programming is over once the chip is idle, a mapped chip is idle already */
+                if (mapBase == NULL && IS25L_ReadStatusReg(&regist_buf) != IS25L_OK) {
+                    state = FLASH_CHIP_ERR;
+                }
+                break;
         }
+        tx_mutex_put(&muxFLASH);
+
+        if (slot->last) {
+            if (state != FLASH_OK && asyncError == FLASH_OK) {
+                asyncError = state;
+            }
+            if (slot->done != NULL) {
+                slot->done(state, slot->arg);
+            }
+            if (slot->flushed != NULL) {
+                tx_semaphore_put(slot->flushed);
+            }
+            state = FLASH_OK;
+        }
+        slotTail = (slotTail + 1U) % FLASH_ASYNC_SLOTS;
+        tx_semaphore_put(&semFree);
+    }
+}
+
+/* Takes the next slot, called with muxAsync */
+static flash_slot_t *FLASH_SlotGet(flash_op_t op, flash_done_t done, void *arg) {
+    flash_slot_t *slot;
+
+    tx_semaphore_get(&semFree, TX_WAIT_FOREVER);
+    slot = &slotsFLASH[slotHead];
+    slot->op = op;
+    slot->last = true;
+    slot->done = done;
+    slot->arg = arg;
+    slot->flushed = NULL;
+    return slot;
+}
+
+/* Passes the slot to the worker, called with muxAsync */
+static void FLASH_SlotPut(void) {
+    slotHead = (slotHead + 1U) % FLASH_ASYNC_SLOTS;
+    tx_semaphore_put(&semUsed);
+}
+
+/* Function for queued write */
+flash_state_t FLASH_WriteAsync(const uint8_t *wrBuffer, uint32_t startAddr, uint16_t datLen, flash_done_t done,
+                               void *arg) {
+    if (wrBuffer == NULL || !datLen || startAddr > IS25L_EDGE || datLen > IS25L_EDGE + 1U - startAddr) {
+        return FLASH_PARAM_ERR;
+    }
+    /* The worker would wait for a slot it frees itself */
+    if (tx_thread_identify() == &taskFLASH) {
+        return FLASH_BUSY;
+    }
+    tx_mutex_get(&muxAsync, TX_WAIT_FOREVER);
 
-        /* Read sector to buffer */
-        FLASH_Read(EraseBUF, sectorAddress, sizeof(EraseBUF));
+    while (datLen) {
+        flash_slot_t *slot = FLASH_SlotGet(FLASH_OP_WRITE, done, arg);
+        /* Up to the page end, as FLASH_Write() */
+        uint16_t currentDataLenght = IS25L_MEMORY_PAGE_SIZE - startAddr % IS25L_MEMORY_PAGE_SIZE;
 
-        /* Erase (255 = empty by flash logic) chosen data */
-        for (int i = 0; i < currentDataLenght; i++) {
-            EraseBUF[bufElementNumber] = 255;
-            bufElementNumber++;
+        if (currentDataLenght > datLen) {
+            currentDataLenght = datLen;
         }
+        slot->addr = startAddr;
+        slot->len = currentDataLenght;
+        memcpy(slot->data, wrBuffer, currentDataLenght);
 
-        /* Erase sector in Flash memory */
-        IS25L_EraseSector(sectorAddress);
-        /* Perform write to flash memory. */
-        FLASH_Write(EraseBUF, sectorAddress, sizeof(EraseBUF));
-
-        if (flagSequence == 1) {
-            /* Memorize flash address after operation */
-            currentAddr = currentAddr + currentDataLenght;
-            /* Memorize how many bytes is left to erase */
-            bytesCounter = bytesCounter - currentDataLenght;
-            /* Change current sector address to the next one */
-            sectorAddress = sectorAddress + (IS25L_MEMORY_SECTOR_SIZE * 1024U);
-            /* Reset this counter because next data will be erased at the start of the sector */
-            bufElementNumber = 0;
-            /* Reset flag at the end of every iteration (if) in case if next iter will be final */
-            flagSequence = 0;
+        wrBuffer += currentDataLenght;
+        startAddr += currentDataLenght;
+        datLen -= currentDataLenght;
+        slot->last = !datLen;
+        FLASH_SlotPut();
+    }
+
+    tx_mutex_put(&muxAsync);
+    return FLASH_OK;
+}
+
+/* Function for queued erase */
+flash_state_t FLASH_EraseAsync(uint32_t startAddr, uint32_t datLen, flash_done_t done, void *arg) {
+    flash_slot_t *slot;
+
+    if (startAddr > IS25L_EDGE || datLen > IS25L_EDGE + 1U - startAddr) {
+        return FLASH_PARAM_ERR;
+    }
+    if (tx_thread_identify() == &taskFLASH) {
+        return FLASH_BUSY;
+    }
+    tx_mutex_get(&muxAsync, TX_WAIT_FOREVER);
+
+    slot = FLASH_SlotGet(FLASH_OP_ERASE, done, arg);
+    slot->addr = startAddr;
+    slot->len = datLen;
+    FLASH_SlotPut();
+
+    tx_mutex_put(&muxAsync);
+    return FLASH_OK;
+}
+
+/* Function for waiting for queued requests */
+flash_state_t FLASH_Flush(void) {
+    flash_state_t state;
+    flash_slot_t *slot;
+    TX_SEMAPHORE  flushed;
+
+    if (tx_thread_identify() == &taskFLASH) {
+        return FLASH_BUSY;
+    }
+    if (tx_semaphore_create(&flushed, "FLASH Flush", 0) != TX_SUCCESS) {
+        return FLASH_TX_ERR;
+    }
+    tx_mutex_get(&muxAsync, TX_WAIT_FOREVER);
+    slot = FLASH_SlotGet(FLASH_OP_FLUSH, NULL, NULL);
+    slot->flushed = &flushed;
+    FLASH_SlotPut();
+    tx_mutex_put(&muxAsync);
+
+    tx_semaphore_get(&flushed, TX_WAIT_FOREVER);
+    tx_semaphore_delete(&flushed);
+
+    state = asyncError;
+    asyncError = FLASH_OK;
+    return state;
+}
+
+/* Function for read through the cache */
+flash_state_t FLASH_CacheRead(uint8_t *rdBuffer, uint32_t startAddr, uint16_t datLen) {
+    flash_state_t state;
+
+    if (rdBuffer == NULL || startAddr > IS25L_EDGE || datLen > IS25L_EDGE + 1U - startAddr) {
+        return FLASH_PARAM_ERR;
+    }
+    tx_mutex_get(&muxFLASH, TX_WAIT_FOREVER);
+    state = FLASH_ReadLines(rdBuffer, startAddr, datLen, true);
+    tx_mutex_put(&muxFLASH);
+    return state;
+}
+
+/* Function for write to the cache */
+flash_state_t FLASH_CacheWrite(const uint8_t *wrBuffer, uint32_t startAddr, uint16_t datLen) {
+    flash_state_t state = FLASH_OK;
+
+    if (wrBuffer == NULL || startAddr > IS25L_EDGE || datLen > IS25L_EDGE + 1U - startAddr) {
+        return FLASH_PARAM_ERR;
+    }
+    tx_mutex_get(&muxFLASH, TX_WAIT_FOREVER);
+
+    while (datLen) {
+        uint32_t sectorAddr = startAddr - startAddr % FLASH_SECTOR;
+        uint32_t shift = startAddr % FLASH_SECTOR;
+        /* Up to the page end, pages are marked dirty */
+        uint16_t currentDataLenght = IS25L_MEMORY_PAGE_SIZE - startAddr % IS25L_MEMORY_PAGE_SIZE;
+        uint32_t i = FLASH_LineFind(linesSector, FLASH_CACHE_SECTORS, sectorAddr);
+        uint8_t *data;
+
+        if (currentDataLenght > datLen) {
+            currentDataLenght = datLen;
+        }
+        if (i < FLASH_CACHE_SECTORS) {
+            ++cacheStats.write_hits;
         } else {
-            break;
+            /* The least recent sector is synced for this one, read whole for a rewrite after an erase. A protected
+             * sector keeps its line while others can be taken */
+            ++cacheStats.write_misses;
+            for (uint32_t tries = 0; tries < FLASH_CACHE_SECTORS; ++tries) {
+                i = FLASH_LineVictim(linesSector, FLASH_CACHE_SECTORS);
+                if ((state = FLASH_SyncLine(i)) != FLASH_PARAM_ERR) {
+                    break;
+                }
+                linesSector[i].used = ++cacheClock;
+            }
+            if (state != FLASH_OK) {
+                goto quit;
+            }
+            linesSector[i].addr = FLASH_LINE_EMPTY;
+            if (FLASH_CacheDrop(sectorAddr, FLASH_SECTOR, false) != FLASH_OK ||
+                FLASH_ReadChip((uint8_t *) cacheSector[i], sectorAddr, FLASH_SECTOR) != FLASH_OK) {
+                state = FLASH_CHIP_ERR;
+                goto quit;
+            }
+            linesSector[i].addr = sectorAddr;
+            linesSector[i].used = ++cacheClock;
         }
+
+        /* Data that is there already does not make the page dirty */
+        data = (uint8_t *) cacheSector[i] + shift;
+        if (memcmp(data, wrBuffer, currentDataLenght) != 0) {
+            memcpy(data, wrBuffer, currentDataLenght);
+            linesSector[i].dirty |= 1U << (shift / IS25L_MEMORY_PAGE_SIZE);
+        }
+
+        wrBuffer += currentDataLenght;
+        startAddr += currentDataLenght;
+        datLen -= currentDataLenght;
     }
 
+quit:
+    tx_mutex_put(&muxFLASH);
+    return state;
+}
+
+/* Function for sync of the cache */
+flash_state_t FLASH_Sync(void) {
+    flash_state_t state;
+
+    tx_mutex_get(&muxFLASH, TX_WAIT_FOREVER);
+    state = FLASH_SyncAll();
+    tx_mutex_put(&muxFLASH);
+    return state;
+}
+
+/* Function for counters of the cache */
+flash_state_t FLASH_GetCacheStats(flash_cache_stats_t *stats) {
+    if (stats == NULL) {
+        return FLASH_PARAM_ERR;
+    }
+    tx_mutex_get(&muxFLASH, TX_WAIT_FOREVER);
+    *stats = cacheStats;
     tx_mutex_put(&muxFLASH);
     return FLASH_OK;
 }
 
 /* Check protection status based on registry state */
 uint8_t FLASH_CheckProtectionStatus(void) {
-    uint8_t regist_buf_r;
+    uint8_t regist_buf_r = 0;
 
-    IS25L_ReadStatusReg(&regist_buf_r);
+    tx_mutex_get(&muxFLASH, TX_WAIT_FOREVER);
+    if (FLASH_Indirect() == FLASH_OK) {
+        IS25L_ReadStatusReg(&regist_buf_r);
+    }
+    tx_mutex_put(&muxFLASH);
     regist_buf_r &= FLASH_SAVEBITS;
 
     switch (regist_buf_r) {
@@ -266,15 +1022,28 @@ uint8_t FLASH_CheckProtectionStatus(void) {
 /* Change block protection status */
 flash_state_t FLASH_ChangeProtectionStatus(uint8_t blockBuff) {
 
-    uint8_t regist_buf;
+    flash_state_t state = FLASH_OK;
+    uint8_t       regist_buf;
 
-    IS25L_ReadStatusReg(&regist_buf);
+    tx_mutex_get(&muxFLASH, TX_WAIT_FOREVER);
+
+    /* Data of the cache goes under the protection it was written with. Sectors protected already keep their
+     * data dirty for a sync after the change */
+    state = FLASH_SyncAll();
+    if ((state != FLASH_OK && state != FLASH_PARAM_ERR) || FLASH_Indirect() != FLASH_OK ||
+        IS25L_ReadStatusReg(&regist_buf) != IS25L_OK) {
+        state = FLASH_CHIP_ERR;
+        goto quit;
+    }
+    state = FLASH_OK;
 
     regist_buf &= FLASH_CLEANBLPROTECT;
     regist_buf = regist_buf | blockBuff;
 
     if (IS25L_WriteStatusReg(regist_buf) != IS25L_OK) {
-        return FLASH_CHIP_ERR;
+        state = FLASH_CHIP_ERR;
     };
-    return FLASH_OK;
+quit:
+    tx_mutex_put(&muxFLASH);
+    return state;
 }
\ No newline at end of file
@@ -10,8 +10,8 @@
  *     GEODE is designed to provide bit streams between master and slaves
  *     and can be used as follows:
  *     + Initialize protocol by calling the GOD_Init() API:
- *         * This API initialize and configures also driver for RFM
- *             by calling RFM_Init() and RFM_Config() API
+ *         * This API initialize and configures also the radio backend
+ *             (rfm_ops_t of rfm.h) by calling its init() and config()
  *     + Start network node by calling GOD_Start() API:
  *         * Creates corresponding task to handle specific node behavior
  *         * Allocates buffer used for bitstreams
@@ -20,6 +20,9 @@
  *             + GOD_Write()
  *             + GOD_Printf()
  *             + GOD_Read()
+ *         * Or whole messages by:
+ *             + GOD_SendMsg()
+ *             + GOD_RecvMsg()
  *         * With possibility to operate:
  *             + Blocking or non-bloking modes
  *             + Read from specific node or any one
@@ -28,7 +31,6 @@
  *          - de-initialization functions
  *          - Node closing (disconecting)
  *          - Protocol State functions
- *          * Slaves periodic synchronization
  *        Known:
  *          * Bugs:
  *              - read out from side node (pos flags does not cleared and |'ed so after 1 && 2 you get 3)
@@ -45,11 +47,42 @@
 #define GEODE_H
 
 #include "main.h"
+#include "rfm.h"
 
 #define GOD_THREAD_FLAG (0x80U)
 #define GOD_MAX_CONN    (128U)
 #define GOD_MBC         (0xFFU)
 
+/* GOD_SendMsg() max message */
+#define GOD_MSG_MAX_SIZE (128U)
+
+/* fragments in flight per slave. 1 - single bit ARQ, 2 - windowed, second fragment in the second slot of the frame.
+ * windowed nodes fall back to single bit with nodes built without it */
+#ifndef GOD_WND_SIZE
+#define GOD_WND_SIZE (2U)
+#endif    // GOD_WND_SIZE
+
+/* received data of all master slots, bytes. a slot takes up to 7 blocks of 60 bytes while it is read slower than
+ * filled, connected idle one holds none */
+#ifndef GOD_RX_POOL_SIZE
+#define GOD_RX_POOL_SIZE (8192U)
+#endif    // GOD_RX_POOL_SIZE
+
+/* slave radio sleeps between its windows in the period, 0 keeps it ready */
+#ifndef GOD_RADIO_SLEEP
+#define GOD_RADIO_SLEEP (1U)
+#endif    // GOD_RADIO_SLEEP
+
+/* node packs its stream (GOD_Write(), GOD_Printf(), GOD_SendMsg()) to records of a text or a delta codec where they
+ * are shorter. master announces it, slaves pack theirs for masters that announce it and tell so on connection.
+ * streams of peers are unpacked regardless of it */
+#ifndef GOD_COMPRESS
+#define GOD_COMPRESS (1U)
+#endif    // GOD_COMPRESS
+
+/* bins of latency histograms, bin 0 holds no delay, bin i - [2^(i-1), 2^i) ticks, the last one everything above */
+#define GOD_HIST_BINS (16U)
+
 typedef enum {
     GOD_OK,
     GOD_ERROR = -1,
@@ -57,6 +90,69 @@ typedef enum {
     GOD_BUF_FULL = -3
 } god_stat_t;
 
+/**
+ * @brief radio profile, nodes of a cell have to run the same one
+ *
+ */
+typedef enum {
+    GOD_PROFILE_DEFAULT,
+    GOD_PROFILE_FAST /* double rate, slots and guards follow from it */
+} god_profile_t;
+
+/**
+ * @brief rx storage usage, in blocks of blk_size bytes
+ *
+ */
+typedef struct {
+    uint16_t blk_size;
+    uint16_t blks;  /* in pool */
+    uint16_t used;  /* now */
+    uint16_t peak;  /* since GOD_Start() */
+    uint8_t  slots; /* connected */
+} god_mem_t;
+
+/**
+ * @brief counters of the link to a peer, GEODE task updates them without locking, so a copy of one that is being
+ * updated can be a packet behind in some fields.
+ * expected packets are headers on slave and answers to master data on master, the radio drops packets of bad CRC
+ * so they are lost ones too
+ *
+ */
+typedef struct {
+    uint32_t rx;   /* packets of the peer received */
+    uint32_t dup;  /* fragments of the peer received again, the ack was lost or it carried an ack only */
+    uint32_t lost;   /* expected packets of the peer not received */
+    uint32_t bytes;  /* stream of the peer delivered, unpacked */
+    uint32_t packed; /* the same as it came in fragments, bytes / packed is the goodput gain of packing */
+    int16_t  rssi;   /* of a recent packet of the peer, dBm */
+} god_link_stat_t;
+
+/**
+ * @brief counters of the own stream, fragments of master are broadcast and are delivered when every slave acks them
+ *
+ */
+typedef struct {
+    uint32_t tx;                      /* fragments sent */
+    uint32_t retx;                    /* fragments sent again */
+    uint32_t bytes;                   /* written */
+    uint32_t packed;                  /* put to the stream for them */
+    uint32_t queue[GOD_HIST_BINS];    /* GOD_Write() of the first byte to the first tx, ticks */
+    uint32_t delivery[GOD_HIST_BINS]; /* first tx to the ack, ticks */
+} god_tx_stat_t;
+
+/**
+ * @brief time the radio spent in its states since GOD_Init() and average supply current estimated from typical
+ * currents of the states
+ *
+ */
+typedef struct {
+    uint64_t rx_us;
+    uint64_t tx_us;
+    uint64_t idle_us;  /* ready between packets */
+    uint64_t sleep_us;
+    uint32_t current_ua;
+} god_radio_stat_t;
+
 /**
  * @brief node type whether master or slave.
  *
@@ -74,9 +170,10 @@ typedef enum {
 /**
  * @brief initialize stuff used by GOD
  * @note uses cmsis os flow control API
+ * @param ops Radio backend: RFM66_Ops, RFM66A_Ops or SIM_RFM_Ops
  * @return god_stat_t
  */
-god_stat_t GOD_Init();
+god_stat_t GOD_Init(const rfm_ops_t *ops);
 
 /**
  * @brief Function for collecting announcements from masters
@@ -88,7 +185,7 @@ uint8_t *GOD_Scan(uint32_t time);
 /**
  * @brief Function for transmission of announcements by the master
  * @param time Ticks
- * @param text Message (comment) to the announcement. (max_len = PKT_SIZE - (SYNC_WORD_LEN + 1))
+ * @param text Message (comment) to the announcement. (max_len = 10)
  * @return Status
  */
 god_stat_t GOD_Announce(uint32_t time, uint8_t *text);
@@ -99,14 +196,32 @@ god_stat_t GOD_Announce(uint32_t time, uint8_t *text);
  */
 god_stat_t GOD_DelAnnBuf();
 
+/**
+ * @brief Function for selecting radio profile. Slot and guard timings are derived from its rate
+ * @note call before GOD_Scan(), GOD_Announce() and GOD_Start()
+ * @param prof Profile
+ * @return Status, GOD_ERROR if node is already started
+ */
+god_stat_t GOD_SetProfile(god_profile_t prof);
+
 /**
  * @brief start radio node
  * @param nt created node type
  * @param args in case of GOD_NODE_SLAVE pass 3bytes of sync word and 1byte position to connect
+ * @note master started after GOD_Scan() hops over channels the masters found by it do not use, scan results are freed
  * @return god_stat_t
  */
 god_stat_t GOD_Start(god_node_t nt, void *args);
 
+/**
+ * @brief Function for offering the slave as a relay of its cell. Master grants one relay per cell, it repeats the
+ * header, announcements and master data to slaves out of master range and forwards their fragments. Slaves connected
+ * to its announcement are two hops away and run single bit ARQ
+ * @note link counters of a slave behind the relay are of the relay
+ * @return Status, GOD_ERROR on master, not started node or slave behind a relay
+ */
+god_stat_t GOD_Relay(void);
+
 /**
  * @brief Function for writing data to Tx buffer
  * @param data Pointer to data
@@ -136,6 +251,56 @@ god_stat_t GOD_Printf(char *data, ...);
  */
 god_stat_t GOD_Read(uint8_t slot, uint8_t *data, uint16_t size, god_mode_t mode);
 
+/**
+ * @brief Function for sending a message, it is received as a whole by GOD_RecvMsg()
+ * @note messages are length prefixed in the same stream as GOD_Write() data, do not mix them on a node
+ * @param data Pointer to message
+ * @param size Message size, up to GOD_MSG_MAX_SIZE
+ * @return Status
+ */
+god_stat_t GOD_SendMsg(uint8_t *data, uint16_t size);
+
+/**
+ * @brief Function for receiving a message sent by GOD_SendMsg().
+ * Blocking readers of different slots do not wait each other, reader is woken once per message.
+ * @param slot Sender slot from 0 to GOD_MAX_CONN-1 or GOD_MBC for a message from any sender
+ * @param data Array for the message
+ * @param size Array size, the rest of a longer message is dropped
+ * @param len Size of the received message (can be NULL)
+ * @param mode (GOD_BLOCK) wait for a message, (GOD_NON_BLOCK) return GOD_BUF_EMPTY if there is none
+ * @return Status or sender's slot number in case of GOD_MBC
+ */
+god_stat_t GOD_RecvMsg(uint8_t slot, uint8_t *data, uint16_t size, uint16_t *len, god_mode_t mode);
+
+/**
+ * @brief Function for getting usage of rx storage
+ * @param mem Usage
+ * @return Status, GOD_ERROR if node is not started
+ */
+god_stat_t GOD_MemUsage(god_mem_t *mem);
+
+/**
+ * @brief Function for getting counters of a link
+ * @param slot Slave slot on master, 0 on slave (link to master)
+ * @param stat Counters
+ * @return Status, GOD_ERROR if the slot is not connected
+ */
+god_stat_t GOD_GetLinkStat(uint8_t slot, god_link_stat_t *stat);
+
+/**
+ * @brief Function for getting counters and latency histograms of the own stream
+ * @param stat Counters
+ * @return Status, GOD_ERROR if node is not started
+ */
+god_stat_t GOD_GetTxStat(god_tx_stat_t *stat);
+
+/**
+ * @brief Function for getting time in radio states and the current estimate, radio duty cycle is (rx + tx) / total
+ * @param stat Counters
+ * @return Status, GOD_ERROR if node is not started
+ */
+god_stat_t GOD_GetRadioStat(god_radio_stat_t *stat);
+
 void GOD_TIM_Callback(TIM_HandleTypeDef *htim);
 
 #endif    // GEODE_H
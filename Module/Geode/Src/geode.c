@@ -9,15 +9,9 @@
 
 /* if undefined size passed to RFM_Tx thread will hang (no doi0 callback generated) */
 
-/*
- * !todo remove buffer coruption on rfm data tx
- * yet we copy data as it will be corrupted on Tx
- */
-
 /* !todecide mb remove size parameter from RFM_Rx & RFM_Tx and use configured size? */
 /* !todo make randomisation of broadcast in slot (take random segment) */
 /* !todo disconnect possibility & task kill */
-/* !todo make flexible macros for setting parameters && claculating tim parameters */
 /* !todo make bigger tim prescaler to reduce impact of crystal oscillator divergence */
 /* !todo commands processing state machine (master/slave reaction/production on/of commands) for flexibility and easy
  * maintenance */
@@ -29,12 +23,14 @@
  */
 
 #include <stdio.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
 #include <malloc.h>
 
 #include "geode.h"
+#include "parser.h"
 #include "tx_api.h"
 
 #define LOG_DEFAULT_MODULE LOG_M_RFM
@@ -43,46 +39,66 @@
 #include <memory.h>
 
 /* NOTE:
- * period consist of 131 slots (announcing & 2 masters & 128 slaves), each slot consist of few segments (1 packet time +
- * guard time) * x 2 master + 128 connections packets 18 bytes (with 16 bytes of data) !todecide each period ~1s or
- * 1+130*(18+preamble_len+syncword_len)*8/boudrate 2 master packets are treated as one (same slave ack) if we want cell
- * breathing we need packet sequence number (or packet window)
+ * period consist of up to 131 slots (announcing & 2 masters & 128 slaves), each slot consist of few segments (1 packet
+ * time + guard time) * x 2 master + 128 connections packets 18 bytes (with 16 bytes of data) !todecide each period ~1s
+ * or 1+130*(18+preamble_len+syncword_len)*8/boudrate 2 master packets are treated as one (same slave ack) if we want
+ * cell breathing we need packet sequence number (or packet window)
+ * slaves get slots from the lowest free one, so only the occupied front of the slot map (and the announced slot) is
+ * scheduled. master header carries its length, period shrinks to MCD_COUNT + frames.
+ * windowed slaves (msf_wnd on connection) run a second single bit channel in the second slot of their frame, its acks
+ * follow the header in the second slot of header frame. fragments carry 2 bit sequence, so master puts them in order.
+ * packets are of variable length: header and acks cover scheduled frames only, fragments carry as much data as there is.
+ * master announces data size of fragments (up to the radio FIFO), slot time follows from it.
  */
 
 #define BAUD_RATE       19200
 #define DEVIATION       25000
-#define START_FREQUENCY freqSet[0]
-#define BANDWIDTH       RFM_BW100kHz
+#define BAUD_RATE_FAST  38400 /* GOD_PROFILE_FAST */
+#define DEVIATION_FAST  25000
+#define START_FREQUENCY freqSet[FREQ_HOME]
+#define BANDWIDTH       100000
+#define BANDWIDTH_FAST  166700 /* RX filter of RFM66A comes with its configuration array */
 #define SYNC_WORD       DEFAULT_SYNC_WORD
 #define SYNC_LENGTH     SYNC_WORD_LEN
-#define PAYLOAD_LENGTH  PKT_SIZE
+#define PAYLOAD_LENGTH  PKT_MAX_SIZE /* max length in variable length mode */
 #define PREAMBLE_LENGTH 16
+#define CRC_LENGTH      2
 
 /* mb move those to special geodeConfig.h for every target */
+/* timing profile of target: GOD_TIM clock (APB timer clock / prescaler) and radio turnaround (mode change to TX/RX),
+ * wake-up from sleep and typical supply currents of radio states (datasheet, uA) for the power estimate. radio figures
+ * are of the chip of the board, guards are derived from them at compile time whatever backend GOD_Init() gets */
 #if defined(TARGET_HUB)
-#define GOD_TIM    (htim7)
-#define RFM_header "rfm66.h"
-#define RFM_CONFIG                                                                                           \
-    {                                                                                                        \
-        .modulation = RFM_MOD_GFSK, .frequency = freqSet[0], .baud_rate = BAUD_RATE, .deviation = DEVIATION, \
-        .bandwidth = BANDWIDTH, .sync_word = SYNC_WORD, .sync_length = SYNC_LENGTH, .output_power = 10,      \
-        .payload_length = PAYLOAD_LENGTH, .preamble_length = PREAMBLE_LENGTH, .variable_pkt_length = 0,      \
-        .crc_enable = 1, .crc_autoClearOff = 0, .crc_ibm = 0, .agc_auto_on = 1, .ocp_on = 0                  \
-    }
-#elif defined(TARGET_DEVBOARD)
-#define GOD_TIM    (htim7)
-#define RFM_header "rfm66a.h"
-#define RFM_CONFIG                                                                                                   \
-    {                                                                                                                \
-        .frequency = freqSet[0], .deviation = 25000, .baud_rate = 19200, .preamble_len = PREAMBLE_LENGTH,            \
-        .payload_len = PAYLOAD_LENGTH, .sync_len = SYNC_LENGTH, .sync_word = SYNC_WORD, .modulation = RFM_MOD_2GFSK, \
-        .crc = CCITT_16                                                                                              \
-    }
+#define GOD_TIM     (htim7)
+#define GOD_TIM_CLK (96000000U)
+#define GOD_TIM_PSC (60U)
+#define RFM_TURN_US (150U) /* FS to TX/RX */
+#define RFM_WAKE_US (500U) /* SLEEP to STANDBY, oscillator start */
+#define RFM_UA_SLEEP (1U)
+#define RFM_UA_IDLE  (1250U) /* STANDBY */
+#define RFM_UA_RX    (16000U)
+#define RFM_UA_TX    (33000U) /* +10 dBm */
+#elif defined(TARGET_DEVBOARD) || defined(TARGET_HOST)
+#define GOD_TIM     (htim7)
+#define GOD_TIM_CLK (160000000U)
+#define GOD_TIM_PSC (100U)
+#define RFM_TURN_US (200U) /* START_TX/START_RX, CTS and synthesizer tune */
+#define RFM_WAKE_US (440U) /* SLEEP to READY, crystal start */
+#define RFM_UA_SLEEP (1U)
+#define RFM_UA_IDLE  (1800U) /* READY */
+#define RFM_UA_RX    (13700U)
+#define RFM_UA_TX    (18000U) /* +10 dBm */
 #else
 #error "Current build target not supported"
 #endif
 
-#include RFM_header
+/* radio settings GOD_Init() configures the backend with */
+#define RFM_SETTINGS                                                                                               \
+    {                                                                                                              \
+        .frequency = START_FREQUENCY, .deviation = DEVIATION, .baud_rate = BAUD_RATE, .bandwidth = BANDWIDTH,      \
+        .preamble_len = PREAMBLE_LENGTH, .payload_len = PAYLOAD_LENGTH, .sync_word = SYNC_WORD,                    \
+        .sync_len = SYNC_LENGTH, .output_power = 10, .gfsk = 1, .variable = 1                                      \
+    }
 
 #define RFM_WAIT_FOREVER TX_WAIT_FOREVER
 
@@ -112,18 +128,104 @@
 #define FRAME_TO_SLOTS(_f) (FRAME_SIZE * (_f))
 #define PERIOD             (FRAME_TO_SLOTS(GOD_MAX_CONN + MCD_COUNT))
 
-#define MPDS_TO_SYN (10U)
+#define MPDS_TO_SYN (40U)
+/* periods without master header after which slave searches for master translation again */
+#define SPDS_TO_RESYN (3U)
+/* periods an announcement predicts channel and phase of master header for */
+#define SPDS_TO_CATCH (4U)
+/* headers after connection in which slave looks for acks of windowed mode */
+#define SPDS_TO_WND (8U)
+#define WND_ON      ((uint8_t) ~0U)
+
+#if GOD_WND_SIZE < 1 || GOD_WND_SIZE > FRAME_SIZE
+#error "GOD_WND_SIZE must be 1 or FRAME_SIZE"
+#endif
 
 #define GOD_TIM_POSFLAGS_MASK EXT_VALUE_MASK(PERIOD)
 
-/* !todo calculate TIM settings depending on rfm settings */
-/* one segment takes 0,0215s (46,5 pkts/s) */
-#define PKT_TIM_LEN       (26000U)
-#define PKT_GUARD_TIM_LEN (6400U)
-/* !todo make it more flexible and calculate from set boudrate and so on */
-#define PKT_TIM_CNT (PKT_TIM_LEN + PKT_GUARD_TIM_LEN)
-/* 96000000 / 60 = 1600000 Hz. to ms prescaler: 1600 */
-#define PKT_OFFSET(_n) (EXT_MS_TO_TICKS(PKT_TIM_CNT / 1600U * FRAME_TO_SLOTS(_n)))
+/* NOTE: frequency hopping
+ * nodes hop every period over set of HOP_CNT channels of freqSet, it is the mask in master header.
+ * master counts slots of active slaves it listened and got packets in per channel. when every channel of the set
+ * has CH_MIN_EXP slots, one that gets less than 3/4 of the best is blacklisted for CH_BAN_PERIODS and a spare channel
+ * takes its place. RSSI sampled of the packets is averaged per channel, one that comes CH_RSSI_GAP dB weaker than the
+ * best is blacklisted the same way before it starts to lose. spares are taken by the share they got the last time in
+ * the set, ones not tried yet first. announcements are always on FREQ_HOME, joining slaves scan it.
+ * masters in range of each other divide channels: a master started after GOD_Scan() leaves hop sets of the masters it
+ * heard to them and takes up to half of the rest, spares are taken only from these channels too. FREQ_HOME is shared,
+ * announcements are short and rare enough to collide with data of the first cell seldom.
+ */
+#define FREQ_CNT       (8U)
+#define FREQ_HOME      (0U)
+#define HOP_CNT        (3U)
+#define HOP_DEFAULT    ((1U << HOP_CNT) - 1U)
+#define FREQ_ALL       ((uint8_t) ((1U << FREQ_CNT) - 1U))
+#define CH_MIN_EXP     (32U)
+#define CH_BAN_PERIODS (1024U)
+#define CH_MIN_RSSI    (4U)  /* samples of a channel for its RSSI to count */
+#define CH_RSSI_GAP    (10)  /* dB */
+
+#if FREQ_CNT > 8 || HOP_CNT > FREQ_CNT
+#error "hop mask is a byte"
+#endif
+
+/* NOTE: timing model
+ * slot = time on air of the packet + guard, everything in GOD_TIM ticks.
+ * guard = radio turnaround + processing of the received packet + drift of two node clocks over the longest period
+ * (slaves resync on every master header). FIFO is loaded before the slot and tx starts from the timer irq, so there
+ * is no SPI time in it. rates must be multiples of 100 baud.
+ */
+#define TIM_FREQ       (GOD_TIM_CLK / GOD_TIM_PSC)
+#define US_TO_TIM(_us) ((_us) * (TIM_FREQ / 1000U) / 1000U)
+#define TIM_TO_MS(_t)  ((_t) / (TIM_FREQ / 1000U))
+#define TIM_TO_TICKS(_t) ((ULONG) ((uint64_t) (_t) *TX_TIMER_TICKS_PER_SECOND / TIM_FREQ))
+
+#define CLK_PPM     (20U)  /* crystal tolerance of a node */
+#define GOD_PROC_US (800U) /* FIFO read and processing of a packet till the next rx/tx is set up */
+
+/* time on air of _len bytes packet, length byte included */
+#define PKT_AIR_TIM(_len, _baud) \
+    (8U * (PREAMBLE_LENGTH + SYNC_LENGTH + 1U + (_len) + CRC_LENGTH) * (TIM_FREQ / 100U) / ((_baud) / 100U))
+#define PKT_DRIFT_TIM(_slot) ((_slot) * PERIOD * 2U * CLK_PPM / 1000000U)
+#define PKT_GUARD_TIM(_baud)                        \
+    (US_TO_TIM(RFM_TURN_US + GOD_PROC_US) +        \
+     PKT_DRIFT_TIM(PKT_AIR_TIM(PKT_MAX_SIZE, _baud) + US_TO_TIM(RFM_TURN_US + GOD_PROC_US)))
+/* guard of the cell with all slaves drift locked, the rest of drift is within PLL_LOCK_TIM */
+#define PKT_GUARD_LCK_TIM (US_TO_TIM(RFM_TURN_US + GOD_PROC_US) + 2U * PLL_LOCK_TIM)
+/* slot fits packet of _len bytes */
+#define PKT_TIM_CNT(_len) (PKT_AIR_TIM(_len, profile->baud_rate) + profile->guard)
+/* slaves run ahead of master slots by irq latencies and ~1.5ms (within preamble), set on end of master header */
+#define PKT_SYNC_TIM(_len) (PKT_AIR_TIM(_len, profile->baud_rate) + US_TO_TIM(1560U))
+#define PKT_OFFSET(_n)     (EXT_MS_TO_TICKS(TIM_TO_MS(slotTim) * FRAME_TO_SLOTS(_n)))
+#define PKT_SLOT_OFFSET    (EXT_MS_TO_TICKS(TIM_TO_MS(slotTim)))
+
+/* NOTE: drift PLL
+ * slave measures arrival of master header against its timer, error is how much later than expected it came.
+ * counter is set on every header (phase), error over the period trims auto-reload (frequency). trim is fixed point
+ * ticks per slot, the fraction is dithered over slots in GOD_TIM_Callback(). slaves locked for PLL_LOCK_CNT headers
+ * report it in their fragments (cmd_lck), master with all slaves locked shortens slots to PKT_GUARD_LCK_TIM guard.
+ */
+#define PLL_FRAC_SHIFT (8U)
+#define PLL_GAIN_SHIFT (1U) /* loop gain 1/2 */
+#define PLL_LOCK_TIM   (US_TO_TIM(100U))
+#define PLL_LOCK_CNT   (4U)
+
+/* NOTE: radio power
+ * slave radio sleeps through the gaps between its windows: master data, own frame and the next header. GOD_TIM is a
+ * basic timer without compare channel, so the radio is woken on the update of the slot before the window, that lead
+ * covers oscillator start and synthesizer tune. the FIFO is loaded after the wake-up, a relay does not sleep.
+ * time in radio states is counted in GOD_TIM ticks, average current is estimated from RFM_UA_* of the states.
+ */
+typedef enum {
+    PWR_IDLE,
+    PWR_RX,
+    PWR_TX,
+    PWR_SLEEP,
+    PWR_CNT
+} pwrState_t;
+
+#if US_TO_TIM(RFM_WAKE_US + RFM_TURN_US) > PKT_AIR_TIM(0, BAUD_RATE_FAST) + PKT_GUARD_LCK_TIM
+#error "radio does not wake up within a slot"
+#endif
 
 #define PKT_GUARD_RAND_MAX 255
 
@@ -133,16 +235,79 @@
 #define MHDC_TIM_POS (FRAME_TO_SLOTS(1))
 #define MDFC_TIM_POS (FRAME_TO_SLOTS(2))
 
-#define TX_OFFSET (6400 / 2)
-
-#define GOD_Tx(_p, _l) (RFM_Tx(_p, _l))
+/* packets are sent in place. FIFO is loaded before waiting for the slot, tx is started by the slot timer (waitTIMTx) */
+#define GOD_TxLoad(_h, _hl, _p, _l) (rfm->tx_load(_h, _hl, _p, _l))
+#define GOD_TxStart()               (rfm->tx_start())
 
-#define PKT_SIZE      (18)
-#define MAX_DATA_SIZE (PKT_SIZE - 2)
+#define PKT_MAX_SIZE  (RFM_FIFO_SIZE - 1U) /* length byte goes through FIFO too */
+#define MAX_DATA_SIZE (PKT_MAX_SIZE - 2U)
 #define BUF_TX_SIZE   (200)
-#define BUF_RX_SIZE   (200)
-#define BUF_ANN_SIZE  (PKT_SIZE * 12)
 #define STR_SIZE      (100)
+#define MSG_HDR_SIZE  (2U) /* length of GOD_SendMsg() message, little endian */
+
+/* NOTE: rx storage
+ * slot keeps received stream in a chain of blocks of the pool shared by all slots, so idle slot holds none and busy
+ * one takes up to RX_SLOT_MAX. the last RX_SLOT_BLKS blocks of the pool are taken by one slot at a time (rxOwner),
+ * it can complete a message whatever others hold. GEODE task is the only one taking blocks, readers give them back.
+ * chains are changed with interrupts disabled, a block copy at a time.
+ */
+#define RX_BLK_DATA      (60U)
+#define RX_SLOT_BLKS     (8U)
+#define RX_SLOT_MAX      ((RX_SLOT_BLKS - 1U) * RX_BLK_DATA) /* chain is a block longer with offsets of both ends */
+#define RX_POOL_BLKS(_n) (((_n) == GOD_NODE_MASTER) ? (GOD_RX_POOL_SIZE / RX_BLK_DATA) : RX_SLOT_BLKS)
+#define RX_OWNER_NONE    (0xFFU)
+
+/* message completes even if buffer holds the rest of previous one and a fragment of the next */
+#if GOD_MSG_MAX_SIZE + MSG_HDR_SIZE + MAX_DATA_SIZE > RX_SLOT_MAX
+#error "GOD_MSG_MAX_SIZE does not fit rx buffer"
+#endif
+#if GOD_RX_POOL_SIZE / RX_BLK_DATA <= RX_SLOT_BLKS
+#error "GOD_RX_POOL_SIZE does not fit reserve of a slot"
+#endif
+
+/* data of fragment master runs the cell with. bigger ones get longer slots */
+#ifndef GOD_DATA_SIZE
+#define GOD_DATA_SIZE MAX_DATA_SIZE
+#endif
+
+#if GOD_DATA_SIZE > MAX_DATA_SIZE || MAX_DATA_SIZE > 0x3F
+#error "GOD_DATA_SIZE does not fit radio FIFO or fragment length field"
+#endif
+
+/* announcement: sync word, slot, slot time, data size, channel, hop mask, frames, header offset, text.
+ * channel, hop set, period and header offset in slots let joining slave catch the header without searching */
+#define ANN_SIZE        (22U)
+#define ANN_TEXT_OFFSET (SYNC_WORD_LEN + 8U)
+#define ANN_TEXT_SIZE   (ANN_SIZE - ANN_TEXT_OFFSET)
+#define ANN_MAX         (12U)
+#define BUF_ANN_SIZE    (1U + ANN_SIZE * ANN_MAX)
+
+#define ANN_SLOT_TIM(_a) (*(uint16_t *) ((_a) + SYNC_WORD_LEN + 1))
+#define ANN_CHANNEL(_a)  ((_a)[SYNC_WORD_LEN + 4])
+#define ANN_HOP(_a)      ((_a)[SYNC_WORD_LEN + 5])
+#define ANN_FRAMES(_a)   ((_a)[SYNC_WORD_LEN + 6])
+#define ANN_HDR_SLOTS(_a) ((_a)[SYNC_WORD_LEN + 7])
+#define ANN_RELAYED       (0x80U) /* in ANN_HDR_SLOTS, header is repeated by a relay */
+#define ANN_PACK          (0x40U) /* in ANN_HDR_SLOTS, master packs its stream and unpacks ones of slaves */
+#define ANN_HDR_MASK      ((uint8_t) ~(ANN_RELAYED | ANN_PACK))
+
+/* NOTE: relay
+ * a slave asks master to relay by cmd_rly, master grants one per cell and appends relay region of RLY_FRAMES frames to
+ * the scheduled ones. header is followed by rlyInfo_t telling the relay, the announced slot and slots behind it.
+ * relay listens frames of slaves behind it under its own sync word and in the region announces (while master does),
+ * repeats the header, master data routed to it by mdf_t.slot and forwards up to RLY_FWD fragments under sync word of
+ * master, so its airtime is bounded. slaves behind it sync on the repeated header, their frames are in the next period,
+ * fragments are a byte shorter for the slot of forwarding and run single bit ARQ. the repeated header is sent before
+ * fragments are forwarded, so it answers fragments of the previous period.
+ */
+#define RLY_FWD       (2U)            /* fragments forwarded per period */
+#define RLY_FRAMES    (2U + RLY_FWD)  /* announcement & header, master data, forwarded fragments */
+#define RLY_HDR_SLOT  (1U)            /* of the region, announcement is in the first one */
+#define RLY_DATA_SLOT (FRAME_TO_SLOTS(1))
+#define RLY_FWD_SLOT  (FRAME_TO_SLOTS(2))
+#define RLY_NONE      (0xFFU)
+#define MDF_RLY(_s)   (0x80U | (_s))  /* mdf_t.slot of master data relay _s repeats */
+#define RLY_PRIO(_s)  ((uint8_t) ((_s) - rlyNext)) /* lower is forwarded first */
 
 /* ptr to buffer without side effect */
 #define bufUsedS(_p, _size) (((_p)->tail <= (_p)->head) ? ((_p)->head - (_p)->tail) : (_size + (_p)->head - (_p)->tail))
@@ -164,21 +329,32 @@ typedef enum {
     cmd_nop,
     cmd_syn,
     cmd_dcn,
+    cmd_wnd,        /* master acks of windowed slaves, follows the header */
+    cmd_lck,        /* slave runs drift locked, in its fragments */
+    cmd_rly,        /* slave asks to relay, in its fragments till granted */
     msf_cmd = 0x0F, /* also used by slave on connection */
     msf_sn = 1 << 4,
     msf_ack = 1 << 5,
-    msf_reserved = 0xC0
+    msf_hdr = 1 << 6, /* master header, slaves sync on it */
+    msf_wnd = 1 << 7  /* slave runs windowed ARQ */
 } com_flags_t; /* add full flag? */
 
 /* wtf with formater? */
 #define COM_CMD_CHECK(_v, _c) (((_v) &msf_cmd) == (_c))
 #define COM_CMD_SET(_v, _c)   (((_v) &= ~msf_cmd), (_v |= _c))
+/* data packets of master start with slot 0xFF */
+#define COM_HDR_CHECK(_v) (((_v) & (msf_hdr | msf_wnd)) == msf_hdr && !COM_CMD_CHECK(_v, cmd_wnd))
+#define COM_WND_CHECK(_v) (((_v) & (msf_hdr | msf_wnd | msf_cmd)) == (msf_hdr | cmd_wnd))
 
 typedef enum {
     dff_len = 0x3F,
-    df_reserved = 0xC0
+    dff_seq = 0xC0 /* fragment sequence of windowed slave */
 } df_flags_t;
 
+#define DFF_SEQ_SHIFT  (6)
+#define DFF_SEQ_MASK   (dff_seq >> DFF_SEQ_SHIFT)
+#define DFF_SEQ_GET(_v) (((_v) &dff_seq) >> DFF_SEQ_SHIFT)
+
 typedef struct {
     df_flags_t mf_dlen;
     uint8_t    data[MAX_DATA_SIZE];
@@ -186,10 +362,22 @@ typedef struct {
 
 typedef struct {
     com_flags_t flags : 8;
+    uint8_t     frames; /* slave frames in this period */
+    uint16_t    slot;   /* slot time from this header on */
+    uint8_t     hop;    /* channels to hop over from this period on */
     uint32_t    ack[MAX_CONN_DWC];
-    uint8_t     slot; /* fin dst | 0xFF for all. unused yet */
 } __packed mheader_t;
 
+typedef struct {
+    com_flags_t flags : 8; /* msf_hdr | cmd_wnd */
+    uint32_t    ack[MAX_CONN_DWC]; /* second channel of windowed slaves */
+} __packed mack_t;
+
+/* acks are sent for scheduled frames only */
+#define ACK_SIZE(_frames) (sizeof(uint32_t) * ARR_DW_INDX((_frames) + DWB_INDX_MASK))
+#define HDR_SIZE(_frames) (offsetof(mheader_t, ack) + ACK_SIZE(_frames))
+#define WND_SIZE(_frames) (offsetof(mack_t, ack) + ACK_SIZE(_frames))
+
 typedef struct {
     uint8_t     slot; /* packet destination || 0xFF broadcast. unused yet */
     dfragmend_t df;
@@ -200,22 +388,123 @@ typedef struct {
     dfragmend_t df;
 } __packed sdf_t;
 
+typedef struct {
+    uint8_t slot; /* of the slave behind the relay */
+    sdf_t   sdf;
+} __packed rsdf_t;
+
+typedef struct {
+    uint8_t  relay;             /* slot of the relay, RLY_NONE if there is none */
+    uint8_t  ann;               /* slot announced by master, RLY_NONE if it does not announce */
+    uint32_t via[MAX_CONN_DWC]; /* slaves behind the relay, indexed as slots */
+} __packed rlyInfo_t;
+
+#define RLY_INFO_SIZE(_frames) (offsetof(rlyInfo_t, via) + ACK_SIZE(_frames))
+
+/* NOTE: stream packing
+ * packed stream carries plain bytes and records. a record is PACK_ESC, header of codec and packed length, and packed
+ * bytes; PACK_ESC of plain bytes goes as PACK_ESC, 0. text records hold ascii literals, digit pairs and words of
+ * packDict, delta ones zigzag varints of differences of 16 or 32 bit little endian samples. GOD_Write() puts a record
+ * where a codec gains over plain bytes, so incompressible data costs only escapes. records do not refer to the stream
+ * before them, fragments of a record are unpacked as they come.
+ * master announces ANN_PACK, slaves of such a master pack their streams and put PACK_CAP in the connection fragment.
+ */
+#define PACK_ESC      (0xF5U) /* never in utf-8, rare in small integers */
+#define PACK_CHUNK    (64U)   /* bytes of GOD_Write() looked at once */
+#define PACK_REC_MAX  (63U)   /* packed bytes of a record */
+#define PACK_TEXT_RUN (8U)    /* ascii bytes worth to try text after plain ones */
+#define PACK_DIGITS   (0x80U) /* text tokens of "00".."99" */
+#define PACK_DICT     (PACK_DIGITS + 100U)
+#define PACK_DICT_CNT (0x100U - PACK_DICT) /* words fill the rest of the byte */
+#define PACK_EXPAND   (6U) /* unpacked bytes of a packed one at most */
+#define PACK_CAP      (0x01U)
+
+typedef enum {
+    pack_raw,
+    pack_text,
+    pack_d16,
+    pack_d32
+} pack_codec_t;
+
+#define PACK_HDR(_c, _len) ((uint8_t) (((_c) << 6) | (_len)))
+#define PACK_HDR_CODEC(_h) ((_h) >> 6)
+#define PACK_HDR_LEN(_h)   ((_h) &0x3FU)
+
+/* unpacker of a peer stream */
+typedef struct {
+    uint8_t  esc;   /* PACK_ESC got, header is next */
+    uint8_t  codec; /* of the record, pack_raw outside */
+    uint8_t  left;  /* packed bytes of the record to come */
+    uint8_t  shift; /* of varint */
+    uint32_t acc;
+    uint32_t prev; /* sample */
+} unpack_t;
+
+typedef struct rxBlk {
+    struct rxBlk *next;
+    uint8_t       data[RX_BLK_DATA];
+} rxBlk_t;
+
 typedef struct {
     struct {
+        rxBlk_t *first; /* read from tail */
+        rxBlk_t *last;  /* written at head */
         uint16_t head;
         uint16_t tail;
-        uint8_t  full;
-        uint8_t  data[BUF_RX_SIZE];
+        uint16_t used;  /* bytes in chain */
+        uint8_t  seq;   /* next fragment of windowed slave */
+        sdf_t    ahead; /* fragment got ahead of seq, df.mf_dlen = 0 if none */
+        uint8_t  msgHdr;   /* bytes of message length got */
+        uint16_t msgLeft;  /* bytes of message to come */
+        uint16_t msgDone;  /* messages in buffer, changed by GEODE task only */
+        uint16_t msgTaken; /* messages read out, changed by readers only */
+        uint8_t  pack;     /* peer packs its stream */
+        unpack_t unpack;
+        god_link_stat_t stat;
     } *buf;
 } bufRx_t;
 
+/* NOTE: link statistics
+ * counters and histograms are written by GEODE task only and read as they are, 32 bit stores are atomic on the MCU.
+ * byte counters of the own stream are written by GOD_Write() under muxBufTx.
+ * GOD_Write() calls are marked with the time and the stream position, so the fragment knows when its first byte was
+ * written. marks go in a ring, a call that finds it full is accounted to the previous one.
+ */
+#define TX_MARK_CNT (8U) /* power of 2, ring indexes wrap */
+#define RSSI_EVERY  (8U) /* RSSI read costs a command to the radio, so one packet of RSSI_EVERY is sampled */
+
 typedef struct {
     uint16_t head;
     uint16_t tail;
     uint8_t  full;
     uint8_t  buf[BUF_TX_SIZE];
+    uint32_t wrPos; /* bytes written ever, GOD_Write() only */
+    uint32_t rdPos; /* bytes taken ever, GEODE task only */
+    struct {
+        uint32_t pos;
+        ULONG    time;
+    } mark[TX_MARK_CNT];
+    volatile uint8_t markW;
+    volatile uint8_t markR;
 } bufTx_t;
 
+/* link quality of a channel seen by master */
+typedef struct {
+    uint16_t exp;     /* listened slots of active slaves */
+    uint16_t ok;      /* of them received */
+    uint16_t ban;     /* periods left on blacklist */
+    uint16_t loss;    /* share of slots lost the last time in the hop set, 1/256 */
+    int32_t  rssi;    /* sum of samples, dBm */
+    uint16_t rssiCnt; /* samples */
+} chStat_t;
+
+/* fragment of the own stream in flight */
+typedef struct {
+    ULONG   written; /* GOD_Write() of the first byte */
+    ULONG   sent;    /* first tx */
+    uint8_t inFlight;
+} txFrag_t;
+
 extern TIM_HandleTypeDef GOD_TIM;
 
 #define STACK_SIZE     1024
@@ -250,34 +539,107 @@ static TX_SEMAPHORE semTIM;
 /* move those in buffer structs ? */
 static TX_EVENT_FLAGS_GROUP god_ef_mux[MAX_CONN_FGC];
 static TX_EVENT_FLAGS_GROUP god_ef_ntfy[MAX_CONN_FGC];
+static TX_EVENT_FLAGS_GROUP god_ef_msg[MAX_CONN_FGC];
+static TX_EVENT_FLAGS_GROUP god_ef_msgAny; /* bit per god_ef_msg group */
 
 static TX_THREAD taskGEODE;
 
 enum {
-    STAT_CONNECT = 0x7F,
+    STAT_CONNECT = 0x01,
+    STAT_STARTED = 0x40,
     STAT_DEINITED = 0x80
 } static statFlags = STAT_DEINITED;
 
-static uint8_t pkt_len = PKT_SIZE;
+static ULONG annEnd; /* announcing till */
+
+static uint8_t  frames = GOD_MAX_CONN;    /* slave frames in current period */
+static uint8_t  dataSize = GOD_DATA_SIZE; /* of fragment, announced by master */
+static uint16_t slotTim;                  /* pkt_time */
+
+static int32_t pllTrim; /* ticks per slot, PLL_FRAC_SHIFT fixed point */
+static int32_t pllAcc;  /* fraction of trim not applied yet */
+static uint8_t pllLock; /* headers in row within PLL_LOCK_TIM */
+
+static uint64_t pwrTime[PWR_CNT]; /* GOD_TIM ticks in radio states */
+static uint32_t pwrLast;          /* tick of the last state change */
+static uint8_t  pwrCur = PWR_IDLE;
+static uint32_t timTicks; /* GOD_TIM ticks of slots passed */
+
+static uint8_t relayOn;  /* GOD_Relay() was called */
+static uint8_t viaRelay; /* slave syncs on the header repeated by a relay */
+static uint8_t packCell; /* ANN_PACK of the cell */
+static uint8_t packTx;   /* own stream is packed */
+
+/* fragments to forward in the region, the spare entry takes a received one till it is known whether it is queued */
+static rsdf_t  rlyQ[RLY_FWD + 1U];
+static uint8_t rlyLen[RLY_FWD + 1U];
+static uint8_t rlyCnt;
+static uint8_t rlyNext;            /* slot of the highest priority, the first one dropped in the previous period */
+static uint8_t rlyDrop = RLY_NONE; /* of this period */
+
+static const rfm_ops_t *rfm; /* radio backend of GOD_Init() */
+
+static uint8_t freqI;                 /* current channel */
+static uint8_t hopMask = HOP_DEFAULT; /* of master header */
+static uint8_t hopFree = FREQ_ALL;    /* channels not taken by other masters */
 
 #define DEFAULT_SYNC_WORD \
     { 0xFC, 0xFC, 0xFC, 0xFC }
 #define SYNC_WORD_LEN (4)
 
-static const uint32_t freqSet[] = { 863500, 864300, 864700 };
-static const uint8_t  dSyncWord[SYNC_WORD_LEN] = DEFAULT_SYNC_WORD;
+#if PKT_AIR_TIM(PKT_MAX_SIZE, BAUD_RATE) + PKT_GUARD_TIM(BAUD_RATE) + PKT_GUARD_RAND_MAX > 0xFFFF
+#error "slot does not fit GOD_TIM"
+#endif
+
+#if BAUD_RATE % 100 || BAUD_RATE_FAST % 100
+#error "rate is not a multiple of 100 baud"
+#endif
 
-#define freqN countof(freqSet)
+/* radio settings and guard of god_profile_t */
+typedef struct {
+    uint32_t baud_rate;
+    uint32_t deviation;
+    uint16_t guard;
+    uint16_t guardLck; /* all slaves drift locked */
+} profile_t;
+
+static const profile_t profiles[] = {
+    [GOD_PROFILE_DEFAULT] = { .baud_rate = BAUD_RATE,
+                             .deviation = DEVIATION,
+                             .guard = PKT_GUARD_TIM(BAUD_RATE),
+                             .guardLck = PKT_GUARD_LCK_TIM },
+    [GOD_PROFILE_FAST] = { .baud_rate = BAUD_RATE_FAST,
+                          .deviation = DEVIATION_FAST,
+                          .guard = PKT_GUARD_TIM(BAUD_RATE_FAST),
+                          .guardLck = PKT_GUARD_LCK_TIM },
+};
+
+static const profile_t *profile = &profiles[GOD_PROFILE_DEFAULT];
+
+/* first HOP_CNT are the default hop set, the rest are spares */
+static const uint32_t freqSet[FREQ_CNT] = { 863500, 864300, 864700, 863100, 863900, 865100, 865500, 865900 };
+static const uint8_t  dSyncWord[SYNC_WORD_LEN] = DEFAULT_SYNC_WORD;
 
 #define FLAGS_OFFSET          (sizeof(sdf_t) - MAX_DATA_SIZE)
 #define DATA_FLAGS_OFFSET     (FLAGS_OFFSET - sizeof(df_flags_t))
+#define DF_PKT_SIZE(_df)      (FLAGS_OFFSET + ((_df).mf_dlen & dff_len))
 #define THREAD_FLAG_SLOT_MASK (GOD_MAX_CONN - 1)
 
 static uint8_t   node;
 static uint8_t  *str = NULL;
 static uint8_t  *bufAnn = NULL;
+static ULONG     annTime[ANN_MAX]; /* reception of the last announcement of bufAnn entries */
 static bufTx_t  *bufTx = NULL;
-static bufRx_t **arrRx = NULL;
+static bufRx_t  *arrRx = NULL;
+
+static TX_BLOCK_POOL rxPool;   /* rx blocks of all slots */
+static TX_BLOCK_POOL slotPool; /* states of connected slots */
+static uint8_t      *poolArea = NULL;
+static uint8_t       rxOwner = RX_OWNER_NONE; /* slot in the reserve */
+static uint16_t      rxPeak;                  /* blocks */
+
+static god_tx_stat_t   txStat;
+static god_link_stat_t statNone; /* counters of slots without state, dropped */
 
 #if 0
 void TaskScanGEODE(void *argument) {
@@ -292,36 +654,131 @@ void god_ann(uint8_t argc, void **argv) {
 }
 #endif    // 0
 
+static void printHist(const char *name, const uint32_t *hist) {
+    LOG_Printf("%s [ms]:", name);
+    for (uint8_t i = 0; i < GOD_HIST_BINS; ++i) {
+        if (hist[i]) {
+            LOG_Printf(" <%lu:%lu", (unsigned long) EXT_TICKS_TO_MS(1UL << i), (unsigned long) hist[i]);
+        }
+    }
+    LOG_Printf("\n");
+}
+
+/* share of the total, hundredths of percent */
+#define PWR_BP(_t, _all) ((unsigned long) ((_all) ? (_t) * 10000U / (_all) : 0))
+
+/* rfm stats */
+static void god_stats(uint8_t argc, void **argv) {
+    god_tx_stat_t    tx;
+    god_link_stat_t  link;
+    god_radio_stat_t pwr;
+
+    if (GOD_GetTxStat(&tx) != GOD_OK) {
+        LOG_Printf("GEODE is not started\n");
+        return;
+    }
+    LOG_Printf("%s tx %lu retx %lu, wrote %lu B packed to %lu B\n", (node == GOD_NODE_MASTER) ? "master" : "slave",
+               (unsigned long) tx.tx, (unsigned long) tx.retx, (unsigned long) tx.bytes, (unsigned long) tx.packed);
+    printHist("queue", tx.queue);
+    printHist("delivery", tx.delivery);
+    if (GOD_GetRadioStat(&pwr) == GOD_OK) {
+        const uint64_t all = pwr.rx_us + pwr.tx_us + pwr.idle_us + pwr.sleep_us;
+        LOG_Printf("radio duty %lu.%02lu%% (rx %lu.%02lu%% tx %lu.%02lu%%), sleep %lu.%02lu%%, ~%lu uA\n",
+                   PWR_BP(pwr.rx_us + pwr.tx_us, all) / 100U, PWR_BP(pwr.rx_us + pwr.tx_us, all) % 100U,
+                   PWR_BP(pwr.rx_us, all) / 100U, PWR_BP(pwr.rx_us, all) % 100U, PWR_BP(pwr.tx_us, all) / 100U,
+                   PWR_BP(pwr.tx_us, all) % 100U, PWR_BP(pwr.sleep_us, all) / 100U, PWR_BP(pwr.sleep_us, all) % 100U,
+                   (unsigned long) pwr.current_ua);
+    }
+    LOG_Printf("slot       rx      dup     lost  rssi\n");
+    for (uint8_t i = 0; i < node; ++i) {
+        if (GOD_GetLinkStat(i, &link) == GOD_OK) {
+            LOG_Printf("%4u %8lu %8lu %8lu %5d\n", i, (unsigned long) link.rx, (unsigned long) link.dup,
+                       (unsigned long) link.lost, link.rssi);
+        }
+    }
+}
+
+/* rfm link -s 0 */
+static void god_link(uint8_t argc, void **argv) {
+    god_link_stat_t link;
+    const uint8_t   slot = atoi(argv[0]);
+
+    if (GOD_GetLinkStat(slot, &link) != GOD_OK) {
+        LOG_Printf("slot %u is not connected\n", slot);
+        return;
+    }
+    LOG_Printf("slot %u: rx %lu dup %lu lost %lu (%lu ppm), rssi %d dBm\n", slot, (unsigned long) link.rx,
+               (unsigned long) link.dup, (unsigned long) link.lost,
+               (unsigned long) ((uint64_t) link.lost * 1000000U / ((link.rx + link.lost) ? (link.rx + link.lost) : 1U)),
+               link.rssi);
+    /* goodput gain of packing, hundredths */
+    const unsigned long gain = link.packed ? (unsigned long) ((uint64_t) link.bytes * 100U / link.packed) : 100U;
+    LOG_Printf("slot %u: stream %lu B in %lu B, gain x%lu.%02lu\n", slot, (unsigned long) link.bytes,
+               (unsigned long) link.packed, gain / 100U, gain % 100U);
+}
+
 static __unused god_stat_t createArr(god_node_t n) {
     if ((arrRx != NULL) || (bufTx != NULL)) {
         return GOD_ERROR;
     }
 
+    /* states and rx blocks are taken at once, so connections do not touch heap */
+    const ULONG slotArea = n * (sizeof(*arrRx[0].buf) + sizeof(void *));
+    const ULONG rxArea = RX_POOL_BLKS(n) * (sizeof(rxBlk_t) + sizeof(void *));
+
     node = n;
     str = malloc(STR_SIZE);
-    bufTx = malloc(sizeof(bufTx_t));
-    bufTx->full = bufTx->tail = bufTx->head = 0;
-
-    arrRx = (bufRx_t **) malloc(n * sizeof(bufRx_t *));
-    for (uint8_t i = 0; i < node; i++) {
-        arrRx[i] = malloc(sizeof(bufRx_t));
-        arrRx[i]->buf = NULL;
+    bufTx = calloc(1, sizeof(bufTx_t));
+    memset(&txStat, 0, sizeof(txStat));
+
+    arrRx = (bufRx_t *) calloc(n, sizeof(bufRx_t));
+    poolArea = malloc(slotArea + rxArea);
+    if (str == NULL || bufTx == NULL || arrRx == NULL || poolArea == NULL ||
+        tx_block_pool_create(&slotPool, "GEODE slots", sizeof(*arrRx[0].buf), poolArea, slotArea) != TX_SUCCESS ||
+        tx_block_pool_create(&rxPool, "GEODE rx", sizeof(rxBlk_t), poolArea + slotArea, rxArea) != TX_SUCCESS) {
+        return GOD_ERROR;
     }
+    rxOwner = RX_OWNER_NONE;
+    rxPeak = 0;
 
     if (n == GOD_NODE_MASTER) {
-        bufAnn = malloc(PKT_SIZE - (SYNC_WORD_LEN - 1));
+        bufAnn = malloc(ANN_TEXT_SIZE);
         *bufAnn = 0;
     }
     return GOD_OK;
 }
 
 static __unused god_stat_t createBuf(uint8_t slot) {
-    if (arrRx[slot]->buf != NULL) {
+    if (arrRx[slot].buf != NULL ||
+        tx_block_allocate(&slotPool, (VOID **) &arrRx[slot].buf, TX_NO_WAIT) != TX_SUCCESS) {
+        return GOD_ERROR;
+    }
+    memset(arrRx[slot].buf, 0, sizeof(*arrRx[slot].buf));
+    return GOD_OK;
+}
+
+/* gives back block of slot chain */
+static inline void rxRelease(rxBlk_t *blk) {
+    tx_block_release(blk);
+    if (rxPool.tx_block_pool_available >= RX_SLOT_BLKS) {
+        rxOwner = RX_OWNER_NONE;
+    }
+}
+
+static __unused god_stat_t delBuf(uint8_t slot) {
+    TX_INTERRUPT_SAVE_AREA
+
+    if (arrRx[slot].buf == NULL) {
         return GOD_ERROR;
     }
-    arrRx[slot]->buf = malloc(sizeof(*(arrRx[slot]->buf)));
-    arrRx[slot]->buf->full = arrRx[slot]->buf->data[DATA_FLAGS_OFFSET] = arrRx[slot]->buf->tail =
-        arrRx[slot]->buf->head = 0;
+    TX_DISABLE
+    for (rxBlk_t *blk = arrRx[slot].buf->first, *next; blk != NULL; blk = next) {
+        next = blk->next;
+        rxRelease(blk);
+    }
+    TX_RESTORE
+    tx_block_release(arrRx[slot].buf);
+    arrRx[slot].buf = NULL;
     return GOD_OK;
 }
 
@@ -330,11 +787,12 @@ static __unused god_stat_t delArr() {
         return GOD_ERROR;
     }
     for (uint8_t i = 0; i < node; i++) {
-        if (arrRx[i]->buf != NULL) {
-            free(arrRx[i]->buf);
-        }
-        free(arrRx[i]);
+        delBuf(i);
     }
+    tx_block_pool_delete(&rxPool);
+    tx_block_pool_delete(&slotPool);
+    free(poolArea);
+    poolArea = NULL;
     free(arrRx);
     arrRx = NULL;
     free(bufTx);
@@ -348,13 +806,82 @@ static __unused god_stat_t delArr() {
     return GOD_OK;
 }
 
-static __unused god_stat_t delBuf(uint8_t slot) {
-    if (arrRx[slot]->buf == NULL) {
-        return GOD_ERROR;
+/* bytes slot can take now. others only give blocks back meanwhile */
+static uint16_t rxRoom(uint8_t slot) {
+    ULONG    blks = rxPool.tx_block_pool_available;
+    uint16_t room;
+
+    if (rxOwner != RX_OWNER_NONE && rxOwner != slot) {
+        blks = (blks > RX_SLOT_BLKS) ? (blks - RX_SLOT_BLKS) : 0;
+    }
+    room = ((arrRx[slot].buf->last != NULL) ? (RX_BLK_DATA - arrRx[slot].buf->head) : 0U) + blks * RX_BLK_DATA;
+    return (room < RX_SLOT_MAX - arrRx[slot].buf->used) ? room : (RX_SLOT_MAX - arrRx[slot].buf->used);
+}
+
+/* append to slot chain, room is checked by rxRoom() */
+static void putRx(uint8_t slot, const uint8_t *data, uint16_t size) {
+    TX_INTERRUPT_SAVE_AREA
+    uint16_t tmp;
+    rxBlk_t *blk;
+
+    while (size) {
+        TX_DISABLE
+        if (arrRx[slot].buf->last == NULL || arrRx[slot].buf->head == RX_BLK_DATA) {
+            tx_block_allocate(&rxPool, (VOID **) &blk, TX_NO_WAIT);
+            blk->next = NULL;
+            if (rxPool.tx_block_pool_available < RX_SLOT_BLKS) {
+                rxOwner = slot;
+            }
+            if (rxPool.tx_block_pool_total - rxPool.tx_block_pool_available > rxPeak) {
+                rxPeak = rxPool.tx_block_pool_total - rxPool.tx_block_pool_available;
+            }
+            if (arrRx[slot].buf->last == NULL) {
+                arrRx[slot].buf->first = blk;
+                arrRx[slot].buf->tail = 0;
+            } else {
+                arrRx[slot].buf->last->next = blk;
+            }
+            arrRx[slot].buf->last = blk;
+            arrRx[slot].buf->head = 0;
+        }
+        tmp = (size < RX_BLK_DATA - arrRx[slot].buf->head) ? size : (RX_BLK_DATA - arrRx[slot].buf->head);
+        memcpy(arrRx[slot].buf->last->data + arrRx[slot].buf->head, data, tmp);
+        arrRx[slot].buf->head += tmp;
+        arrRx[slot].buf->used += tmp;
+        TX_RESTORE
+        data += tmp;
+        size -= tmp;
+    }
+}
+
+/* read out what is known to be in buffer, NULL data skips it. read blocks go back to the pool */
+static void takeRx(uint8_t slot, uint8_t *data, uint16_t size) {
+    TX_INTERRUPT_SAVE_AREA
+    uint16_t tmp;
+    rxBlk_t *blk;
+
+    while (size) {
+        TX_DISABLE
+        blk = arrRx[slot].buf->first;
+        tmp = (size < RX_BLK_DATA - arrRx[slot].buf->tail) ? size : (RX_BLK_DATA - arrRx[slot].buf->tail);
+        if (data != NULL) {
+            memcpy(data, blk->data + arrRx[slot].buf->tail, tmp);
+            data += tmp;
+        }
+        arrRx[slot].buf->tail += tmp;
+        arrRx[slot].buf->used -= tmp;
+        /* block is linked with its first byte, so empty chain is a single block */
+        if (!arrRx[slot].buf->used) {
+            arrRx[slot].buf->first = arrRx[slot].buf->last = NULL;
+            rxRelease(blk);
+        } else if (arrRx[slot].buf->tail == RX_BLK_DATA) {
+            arrRx[slot].buf->first = blk->next;
+            arrRx[slot].buf->tail = 0;
+            rxRelease(blk);
+        }
+        TX_RESTORE
+        size -= tmp;
     }
-    free(arrRx[slot]->buf);
-    arrRx[slot]->buf = NULL;
-    return GOD_OK;
 }
 
 god_stat_t GOD_DelAnnBuf() {
@@ -366,28 +893,262 @@ god_stat_t GOD_DelAnnBuf() {
     return GOD_OK;
 }
 
-static __unused god_stat_t writeRxMsg(uint8_t *data) {
-    uint8_t tmp, size, slot;
-    slot = data[0];
-    size = data[1] & dff_len;
+/* follow GOD_SendMsg() framing in the stream of the slot. returns whether some message got completed */
+static uint8_t frameMsg(uint8_t slot, const uint8_t *data, uint16_t size) {
+    uint16_t tmp;
+    uint8_t  done = 0;
+    while (size) {
+        if (arrRx[slot].buf->msgHdr < MSG_HDR_SIZE) {
+            arrRx[slot].buf->msgLeft |= (uint16_t) *data++ << (8U * arrRx[slot].buf->msgHdr++);
+            --size;
+        } else {
+            tmp = (size < arrRx[slot].buf->msgLeft) ? (size) : (arrRx[slot].buf->msgLeft);
+            arrRx[slot].buf->msgLeft -= tmp;
+            data += tmp;
+            size -= tmp;
+        }
+        if (arrRx[slot].buf->msgHdr == MSG_HDR_SIZE && !arrRx[slot].buf->msgLeft) {
+            arrRx[slot].buf->msgHdr = 0;
+            ++arrRx[slot].buf->msgDone;
+            done = 1;
+        }
+    }
+    return done;
+}
 
-    if ((arrRx[slot]->buf->full) || (size > bufFreeS(arrRx[slot]->buf, BUF_RX_SIZE))) {
-        return GOD_BUF_FULL;
+/* words of text records, the longest matching one is taken */
+static const char *const packDict[PACK_DICT_CNT] = {
+    "\r\n", ", ",   ": ",   " = ",  "    ", "  ",   "\":",  "\",\"", "{\"",  "\"}",
+    "true", "false", "null", "temp", "hum",  "bat",  "rssi", "time",  "err",  "mV",
+    "dBm",  "ms",    "id",   "ok",   "0.",   ".0",   "-0",   "OK",
+};
+
+static inline uint8_t isDigit(uint8_t c) {
+    return c >= '0' && c <= '9';
+}
+
+/* text record of the ascii head of data, used - bytes it takes. returns packed length */
+static uint8_t packText(uint8_t *out, const uint8_t *data, uint8_t size, uint8_t *used) {
+    uint8_t i = 0, len = 0;
+
+    while (i < size && data[i] < 0x80U && len < PACK_REC_MAX) {
+        uint8_t tok = data[i], n = 1;
+        if (i + 1U < size && isDigit(data[i]) && isDigit(data[i + 1U])) {
+            tok = PACK_DIGITS + (data[i] - '0') * 10U + (data[i + 1U] - '0');
+            n = 2;
+        } else {
+            for (uint8_t w = 0; w < countof(packDict); ++w) {
+                const uint8_t wl = strlen(packDict[w]);
+                if (wl > n && i + wl <= size && !memcmp(data + i, packDict[w], wl)) {
+                    tok = PACK_DICT + w;
+                    n = wl;
+                }
+            }
+        }
+        out[len++] = tok;
+        i += n;
     }
+    *used = i;
+    return len;
+}
+
+/* delta record of whole samples of data */
+static uint8_t packDelta(uint8_t *out, const uint8_t *data, uint8_t size, uint8_t width, uint8_t *used) {
+    uint32_t prev = 0, cur, zz;
+    uint8_t  i = 0, len = 0, n;
+    uint8_t  tmp[5];
+
+    for (; i + width <= size; i += width, prev = cur) {
+        cur = 0;
+        memcpy(&cur, data + i, width);
+        const int32_t d = (width == 2U) ? (int16_t) (cur - prev) : (int32_t) (cur - prev);
+        zz = ((uint32_t) d << 1) ^ (uint32_t) (d >> 31);
+        for (n = 0; zz >= 0x80U; zz >>= 7) {
+            tmp[n++] = 0x80U | (zz & 0x7FU);
+        }
+        tmp[n++] = zz;
+        if (len + n > PACK_REC_MAX) {
+            break;
+        }
+        memcpy(out + len, tmp, n);
+        len += n;
+    }
+    *used = i;
+    return len;
+}
+
+/* copy to tx ring, muxBufTx is held */
+static void putTx(const uint8_t *data, uint16_t size) {
+    uint16_t tmp;
 
-    data += FLAGS_OFFSET;
     while (size) {
-        tmp = ((size < bufFEndS(arrRx[slot]->buf, BUF_RX_SIZE)) ? (size) : (bufFEndS(arrRx[slot]->buf, BUF_RX_SIZE)));
-        memcpy(arrRx[slot]->buf->data + arrRx[slot]->buf->head, data, tmp);
-        arrRx[slot]->buf->head += tmp;
+        /* semaphore is put on every read of full buffer, so count can be left from the last time */
+        while (bufTx->full) {
+            tx_semaphore_get(&semBufTx, TX_WAIT_FOREVER);
+        }
+        tmp = (size < bufFEndS(bufTx, BUF_TX_SIZE) ? size : bufFEndS(bufTx, BUF_TX_SIZE));
+        memcpy(bufTx->buf + bufTx->head, data, tmp);
+        bufTx->head += tmp;
+        bufTx->wrPos += tmp;
+        txStat.packed += tmp;
         data += tmp;
         size -= tmp;
-        if (arrRx[slot]->buf->head == BUF_RX_SIZE) {
-            arrRx[slot]->buf->head = 0;
+        if (bufTx->head == BUF_TX_SIZE) {
+            bufTx->head = 0;
+        }
+        if (bufTx->head == bufTx->tail) {
+            bufTx->full = 1;
+        }
+    }
+}
+
+/* plain bytes to tx ring with escapes */
+static void putTxPlain(const uint8_t *data, uint16_t size) {
+    static const uint8_t esc[] = { PACK_ESC, 0 };
+    uint16_t             n;
+
+    while (size) {
+        for (n = 0; n < size && data[n] != PACK_ESC; ++n) {
+        }
+        putTx(data, n);
+        if (n < size) {
+            putTx(esc, sizeof(esc));
+            ++n;
         }
-        if (arrRx[slot]->buf->head == arrRx[slot]->buf->tail) {
-            arrRx[slot]->buf->full = 1;
+        data += n;
+        size -= n;
+    }
+}
+
+/* packs data to tx ring, a codec of the most gain over plain bytes takes the head of a chunk */
+static void packWrite(const uint8_t *data, uint16_t size) {
+    uint8_t rec[2U + PACK_REC_MAX], tmp[PACK_REC_MAX];
+
+    while (size) {
+        const uint8_t chunk = (size < PACK_CHUNK) ? size : PACK_CHUNK;
+        uint8_t       used, len, best = 0, take = 0;
+        int16_t       gain = 0;
+
+        for (uint8_t c = pack_text; c <= pack_d32; ++c) {
+            len = (c == pack_text) ? packText(tmp, data, chunk, &used) :
+                                     packDelta(tmp, data, chunk, (c == pack_d16) ? 2U : 4U, &used);
+            if ((int16_t) used - 2 - len > gain) {
+                gain = used - 2 - len;
+                best = c;
+                take = used;
+                rec[1] = PACK_HDR(c, len);
+                memcpy(rec + 2, tmp, len);
+            }
+        }
+        if (best != pack_raw) {
+            rec[0] = PACK_ESC;
+            putTx(rec, 2U + PACK_HDR_LEN(rec[1]));
+        } else {
+            /* plain bytes up to ascii run a text record may take */
+            uint8_t run = 0;
+            for (take = 0; take < chunk && run < PACK_TEXT_RUN; ++take) {
+                run = (data[take] < 0x80U) ? (run + 1U) : 0;
+            }
+            take = (run == PACK_TEXT_RUN && take > PACK_TEXT_RUN) ? (take - PACK_TEXT_RUN) : chunk;
+            putTxPlain(data, take);
         }
+        data += take;
+        size -= take;
+    }
+}
+
+/* unpacks stream bytes of a peer to out, NULL out counts them only. returns unpacked size */
+static uint16_t unpack(unpack_t *st, const uint8_t *data, uint8_t size, uint8_t *out) {
+    uint16_t len = 0;
+    uint8_t  n;
+
+#define UNPACK_PUT(_src, _n) ((out != NULL) ? memcpy(out + len, _src, _n) : NULL, len += (_n))
+    for (; size; --size, ++data) {
+        const uint8_t b = *data;
+        if (st->esc) {
+            st->esc = 0;
+            if (!b) {
+                const uint8_t esc = PACK_ESC;
+                UNPACK_PUT(&esc, 1);
+            } else {
+                st->codec = PACK_HDR_CODEC(b);
+                st->left = PACK_HDR_LEN(b);
+                st->acc = st->prev = st->shift = 0;
+            }
+        } else if (!st->left) {
+            st->codec = pack_raw;
+            if (b == PACK_ESC) {
+                st->esc = 1;
+            } else {
+                UNPACK_PUT(&b, 1);
+            }
+        } else {
+            --st->left;
+            if (st->codec == pack_text) {
+                if (b < PACK_DIGITS) {
+                    UNPACK_PUT(&b, 1);
+                } else if (b < PACK_DICT) {
+                    const uint8_t pair[2] = { '0' + (b - PACK_DIGITS) / 10U, '0' + (b - PACK_DIGITS) % 10U };
+                    UNPACK_PUT(pair, 2);
+                } else {
+                    UNPACK_PUT(packDict[b - PACK_DICT], strlen(packDict[b - PACK_DICT]));
+                }
+            } else {
+                st->acc |= (uint32_t) (b & 0x7FU) << st->shift;
+                st->shift += 7U;
+                if (!(b & 0x80U)) {
+                    n = (st->codec == pack_d16) ? 2U : 4U;
+                    st->prev += (st->acc >> 1) ^ -(st->acc & 1U);
+                    UNPACK_PUT(&st->prev, n);
+                    st->acc = st->shift = 0;
+                }
+            }
+        }
+    }
+#undef UNPACK_PUT
+    return len;
+}
+
+/* bytes fragments take in slot buffer written in row, b can be NULL */
+static uint16_t rxSize(uint8_t slot, const uint8_t *a, const uint8_t *b) {
+    unpack_t st = arrRx[slot].buf->unpack;
+    uint16_t len = 0;
+
+    for (const uint8_t *f = a; f != NULL; f = (f == a) ? b : NULL) {
+        len += (arrRx[slot].buf->pack) ? unpack(&st, f + FLAGS_OFFSET, f[1] & dff_len, NULL) : (f[1] & dff_len);
+    }
+    return len;
+}
+
+static __unused god_stat_t writeRxMsg(uint8_t *data) {
+    static uint8_t unpacked[MAX_DATA_SIZE * PACK_EXPAND];
+    uint8_t        size, slot;
+    uint16_t       len;
+    unpack_t       st;
+    slot = data[0];
+    size = len = data[1] & dff_len;
+    data += FLAGS_OFFSET;
+
+    /* unpacker goes on only when the fragment is taken */
+    if (arrRx[slot].buf->pack) {
+        st = arrRx[slot].buf->unpack;
+        len = unpack(&st, data, size, unpacked);
+    }
+    if (len > rxRoom(slot)) {
+        return GOD_BUF_FULL;
+    }
+    if (arrRx[slot].buf->pack) {
+        arrRx[slot].buf->unpack = st;
+        data = unpacked;
+    }
+    arrRx[slot].buf->stat.bytes += len;
+    arrRx[slot].buf->stat.packed += size;
+
+    putRx(slot, data, len);
+    /* messages are counted once they are in buffer */
+    if (frameMsg(slot, data, len)) {
+        ARR_EVENT_FLAG_SET(god_ef_msg, slot, TX_OR);
+        tx_event_flags_set(&god_ef_msgAny, 1U << ARR_DW_INDX(slot), TX_OR);
     }
     ARR_EVENT_FLAG_SET(god_ef_ntfy, slot, TX_OR);
     semReadMBC.tx_semaphore_count = slot;
@@ -396,16 +1157,58 @@ static __unused god_stat_t writeRxMsg(uint8_t *data) {
     return GOD_OK;
 }
 
-static __unused uint8_t getTxMsg(uint8_t *buf) {
-    uint8_t tmp, size;
+/* windowed slave fragment can pass the lost one, keep it till the gap is filled */
+static __unused god_stat_t writeWndMsg(uint8_t *data) {
+    uint8_t slot = data[0];
+
+    if (DFF_SEQ_GET(data[1]) != arrRx[slot].buf->seq) {
+        /* kept only if the gap fits buffer too, so both of them are likely written later */
+        if (arrRx[slot].buf->ahead.df.mf_dlen || rxRoom(slot) < rxSize(slot, data, NULL) + MAX_DATA_SIZE) {
+            return GOD_BUF_FULL;
+        }
+        memcpy(&arrRx[slot].buf->ahead, data, sizeof(sdf_t));
+        return GOD_OK;
+    }
+    /* acked fragment ahead is written right after the gap, others may have taken the pool meanwhile */
+    if (arrRx[slot].buf->ahead.df.mf_dlen &&
+        DFF_SEQ_GET(arrRx[slot].buf->ahead.df.mf_dlen) == ((arrRx[slot].buf->seq + 1) & DFF_SEQ_MASK) &&
+        rxRoom(slot) < rxSize(slot, data, (uint8_t *) &arrRx[slot].buf->ahead)) {
+        return GOD_BUF_FULL;
+    }
+    if (writeRxMsg(data) != GOD_OK) {
+        return GOD_BUF_FULL;
+    }
+    arrRx[slot].buf->seq = (arrRx[slot].buf->seq + 1) & DFF_SEQ_MASK;
+    if (arrRx[slot].buf->ahead.df.mf_dlen &&
+        DFF_SEQ_GET(arrRx[slot].buf->ahead.df.mf_dlen) == arrRx[slot].buf->seq) {
+        writeRxMsg((uint8_t *) &arrRx[slot].buf->ahead);
+        arrRx[slot].buf->seq = (arrRx[slot].buf->seq + 1) & DFF_SEQ_MASK;
+        arrRx[slot].buf->ahead.df.mf_dlen = 0;
+    }
+    return GOD_OK;
+}
+
+/* time the byte at rdPos was written, marks of bytes taken before are dropped */
+static ULONG takeMark(uint8_t len) {
+    while ((uint8_t) (bufTx->markW - bufTx->markR) > 1U &&
+           bufTx->mark[(uint8_t) (bufTx->markR + 1U) % TX_MARK_CNT].pos <= bufTx->rdPos) {
+        bufTx->markR++;
+    }
+    bufTx->rdPos += len;
+    return bufTx->mark[bufTx->markR % TX_MARK_CNT].time;
+}
+
+static __unused uint8_t getTxMsg(uint8_t *buf, txFrag_t *frag) {
+    uint8_t tmp, size, len;
     uint8_t full = bufTx->full; /* save status or disable context switch on putting semaphore */
     if ((bufTx->head == bufTx->tail) && !full) {
         return 0;
     }
-    size = ((full) ? (PKT_SIZE - FLAGS_OFFSET) :
-                     ((bufUsedS(bufTx, BUF_TX_SIZE) < (PKT_SIZE - FLAGS_OFFSET)) ? (bufUsedS(bufTx, BUF_TX_SIZE)) :
-                                                                                   (PKT_SIZE - FLAGS_OFFSET)));
-    buf[0] = size;
+    size = ((full) ? (dataSize) :
+                     ((bufUsedS(bufTx, BUF_TX_SIZE) < dataSize) ? (bufUsedS(bufTx, BUF_TX_SIZE)) : (dataSize)));
+    buf[0] = len = size;
+    frag->written = takeMark(len);
+    frag->inFlight = 0;
     buf++;
     while (size) {
         tmp = ((bufTx->full) ? ((size < (BUF_TX_SIZE - bufTx->tail)) ? (size) : (BUF_TX_SIZE - bufTx->tail)) :
@@ -424,24 +1227,157 @@ static __unused uint8_t getTxMsg(uint8_t *buf) {
     if (full) {
         tx_semaphore_put(&semBufTx);
     }
-    return PKT_SIZE;
+    return FLAGS_OFFSET + len;
+}
+
+static inline void histAdd(uint32_t *hist, ULONG ticks) {
+    const uint8_t bin = 32U - clz(ticks);
+    ++hist[(bin < GOD_HIST_BINS) ? bin : (GOD_HIST_BINS - 1U)];
+}
+
+/* fragment goes on air, the first time ends its queueing */
+static void fragSent(txFrag_t *frag) {
+    if (frag->inFlight) {
+        ++txStat.retx;
+        return;
+    }
+    frag->inFlight = 1;
+    frag->sent = tx_time_get();
+    ++txStat.tx;
+    histAdd(txStat.queue, frag->sent - frag->written);
+}
+
+static void fragAcked(txFrag_t *frag) {
+    if (frag->inFlight) {
+        frag->inFlight = 0;
+        histAdd(txStat.delivery, tx_time_get() - frag->sent);
+    }
+}
+
+/* returns 1 if stat->rssi was sampled now */
+static inline uint8_t sampleRssi(god_link_stat_t *stat, uint32_t cnt) {
+    return !(cnt % RSSI_EVERY) && rfm->get_rssi(&stat->rssi) == RFM_OK;
 }
 
 static rfm_stat_t initRFM() {
-    rfm_config_t cnfg = RFM_CONFIG;
-    return RFM_Init() | RFM_Config(&cnfg);
+    const rfm_settings_t set = RFM_SETTINGS;
+    return rfm->init() | rfm->config(&set);
+}
+
+static inline void tune(uint8_t ch) {
+    rfm->standby();
+    rfm->set_freq(freqSet[ch]);
 }
 
-/* yet it just linear */
+/* next channels of the hop set, in order of the table */
 uint32_t setNextFreq(uint8_t step) {
-    static uint8_t i = 0;
-    i += step;
-    if (i >= freqN) {
-        i %= freqN;
+    while (step--) {
+        do {
+            freqI = (freqI + 1) % FREQ_CNT;
+        } while (!BIT_CHECK(hopMask, freqI));
+    }
+    tune(freqI);
+    return freqSet[freqI];
+}
+
+static inline int32_t chRssi(const chStat_t *ch) {
+    return ch->rssi / (int32_t) ch->rssiCnt;
+}
+
+/* blacklists the worst channel of the hop set if it gets much less than the best one, else the weakest if its RSSI is
+ * much lower, and fills the set with spares that lost least. counters of the set are restarted after a decision,
+ * returns the new set */
+static uint8_t evalHop(uint8_t mask, chStat_t ch[FREQ_CNT]) {
+    uint8_t best = FREQ_CNT, worst = FREQ_CNT, strong = FREQ_CNT, weak = FREQ_CNT;
+
+    for (uint8_t i = 0; i < FREQ_CNT; ++i) {
+        if (!BIT_CHECK(mask, i)) {
+            continue;
+        }
+        if (ch[i].exp < CH_MIN_EXP) {
+            return mask;
+        }
+        /* compare ok/exp ratios */
+        if (best == FREQ_CNT || (uint32_t) ch[i].ok * ch[best].exp > (uint32_t) ch[best].ok * ch[i].exp) {
+            best = i;
+        }
+        if (worst == FREQ_CNT || (uint32_t) ch[i].ok * ch[worst].exp < (uint32_t) ch[worst].ok * ch[i].exp) {
+            worst = i;
+        }
+        if (ch[i].rssiCnt >= CH_MIN_RSSI) {
+            if (strong == FREQ_CNT || chRssi(&ch[i]) > chRssi(&ch[strong])) {
+                strong = i;
+            }
+            if (weak == FREQ_CNT || chRssi(&ch[i]) < chRssi(&ch[weak])) {
+                weak = i;
+            }
+        }
+        ch[i].loss = 256U - 256U * ch[i].ok / ch[i].exp;
+    }
+    if (best == FREQ_CNT) {
+        return mask;
+    }
+    if (4U * ch[worst].ok * ch[best].exp < 3U * ch[best].ok * ch[worst].exp) {
+        BIT_RESET(mask, worst);
+        ch[worst].ban = CH_BAN_PERIODS;
+        LOG_INFO("MASTER: channel %d blacklisted, %d/%d against %d/%d", (int) freqSet[worst], ch[worst].ok,
+                 ch[worst].exp, ch[best].ok, ch[best].exp);
+    } else if (weak != FREQ_CNT && chRssi(&ch[strong]) - chRssi(&ch[weak]) > CH_RSSI_GAP) {
+        worst = weak;
+        BIT_RESET(mask, worst);
+        ch[worst].ban = CH_BAN_PERIODS;
+        LOG_INFO("MASTER: channel %d blacklisted, %d dBm against %d dBm", (int) freqSet[worst],
+                 (int) chRssi(&ch[worst]), (int) chRssi(&ch[strong]));
+    }
+    while (__builtin_popcount(mask) < HOP_CNT) {
+        uint8_t spare = FREQ_CNT;
+        /* in order of the table after the blacklisted one among equals */
+        for (uint8_t i = 1; i < FREQ_CNT; ++i) {
+            const uint8_t c = (worst + i) % FREQ_CNT;
+            if (!BIT_CHECK(mask, c) && !ch[c].ban && BIT_CHECK(hopFree, c) &&
+                (spare == FREQ_CNT || ch[c].loss < ch[spare].loss)) {
+                spare = c;
+            }
+        }
+        if (spare == FREQ_CNT) {
+            break;
+        }
+        BIT_SET(mask, spare);
     }
-    RFM_SetMode(RFM_MODE_STANDBY);
-    RFM_SetFrequency(freqSet[i]);
-    return freqSet[i];
+    for (uint8_t i = 0; i < FREQ_CNT; ++i) {
+        ch[i].exp = ch[i].ok = ch[i].rssiCnt = 0;
+        ch[i].rssi = 0;
+    }
+    return mask;
+}
+
+/* hop set of a new master out of channels of masters in scan results */
+static uint8_t pickHop(const uint8_t *ann) {
+    uint8_t used = 0, mask = 0;
+
+    for (uint8_t i = 0; ann != NULL && i < ann[0]; ++i) {
+        used |= ANN_HOP((ann + 1) + (i * ANN_SIZE));
+    }
+    hopFree = FREQ_ALL & ~used;
+    if (!used) {
+        return HOP_DEFAULT;
+    }
+    if (!hopFree) {
+        LOG_WARN("MASTER: no free channels, sharing default hop set");
+        hopFree = FREQ_ALL;
+        return HOP_DEFAULT;
+    }
+    /* half of the free ones, the next master finds some too */
+    uint8_t cnt = __builtin_popcount(hopFree) / 2;
+    cnt = (cnt < 1) ? 1 : (cnt > HOP_CNT) ? HOP_CNT : cnt;
+    for (uint8_t ch = 0; ch < FREQ_CNT && cnt; ++ch) {
+        if (BIT_CHECK(hopFree, ch)) {
+            BIT_SET(mask, ch);
+            --cnt;
+        }
+    }
+    LOG_INFO("MASTER: %d masters around on %02x, hop set %02x", ann[0], used, mask);
+    return mask;
 }
 
 static inline uint8_t getSlot(uint32_t sar[MAX_CONN_DWC]) {
@@ -452,6 +1388,18 @@ static inline uint8_t getSlot(uint32_t sar[MAX_CONN_DWC]) {
     return (i << DW_INDX_SHIFT) | k; /* (i == MAX_CONN_DWC) ? ~0U : (i << DW_INDX_SHIFT) | (k & DWB_INDX_MASK); */
 }
 
+/* slave frames to schedule: occupied front of ~sar (see getSlot) or up to announced slot */
+static inline uint8_t getFrames(uint32_t sar[MAX_CONN_DWC], uint8_t ann) {
+    uint8_t i = MAX_CONN_DWC, n = 0;
+    while (i && sar[i - 1] == ~0U) {
+        --i;
+    }
+    if (i) {
+        n = ((i - 1) << DW_INDX_SHIFT) + (32 - ctz(~sar[i - 1]));
+    }
+    return (ann > n) ? ann : n;
+}
+
 /* check for subset in ~sets. inline yet */
 static inline uint8_t nsubset(uint32_t *na, uint32_t *nb, uint8_t size) {
     for (register uint8_t i = 0; i < size; ++i) {
@@ -462,39 +1410,130 @@ static inline uint8_t nsubset(uint32_t *na, uint32_t *nb, uint8_t size) {
     return 1;
 }
 
-static int16_t tim_val;
+static int16_t tim_val;
+
+static void waitTIM() {
+    if (tim_val > 0) {
+        tx_semaphore_get(&semTIM, TX_WAIT_FOREVER);
+    }
+}
+
+static volatile uint8_t txArmed;
+
+/* time spent in the previous radio state is added to its counter */
+static void pwrMark(pwrState_t st) {
+    TX_INTERRUPT_SAVE_AREA
+
+    TX_DISABLE
+    const uint32_t now = timTicks + __HAL_TIM_GET_COUNTER(&GOD_TIM);
+    /* counter wrapped and its irq is pending, or was set on the header: the gap goes to the next state */
+    if ((int32_t) (now - pwrLast) > 0) {
+        pwrTime[pwrCur] += now - pwrLast;
+        pwrLast = now;
+    }
+    pwrCur = st;
+    TX_RESTORE
+}
+
+static void txDone(rfm_stat_t stat) {
+    pwrMark(PWR_IDLE);
+    tx_semaphore_put(&semTIM);
+}
+
+/* waits the slot and sends packet loaded by GOD_TxLoad(), tx is started in GOD_TIM_Callback() right on the slot */
+static void waitTIMTx() {
+    TX_INTERRUPT_SAVE_AREA
+
+    TX_DISABLE
+    if (tim_val > 0) {
+        txArmed = 1;
+        TX_RESTORE
+        tx_semaphore_get(&semTIM, TX_WAIT_FOREVER);
+    } else {
+        TX_RESTORE
+        pwrMark(PWR_TX);
+        GOD_TxStart();
+        pwrMark(PWR_IDLE);
+    }
+}
+
+static rfm_stat_t GOD_Rx(void *data, uint8_t *size, uint32_t timeout) {
+    pwrMark(PWR_RX);
+    const rfm_stat_t stat = rfm->rx(data, size, timeout);
+    pwrMark(PWR_IDLE);
+    return stat;
+}
+
+/* sleeps the radio till the slot before the one waited for, radio is ready on return */
+static void napTIM(void) {
+    if (!GOD_RADIO_SLEEP || relayOn || tim_val <= 1) {
+        return;
+    }
+    rfm->sleep();
+    pwrMark(PWR_SLEEP);
+    tim_val -= 1;
+    waitTIM();
+    tim_val += 1;
+    rfm->standby();
+    pwrMark(PWR_IDLE);
+}
+
+static inline void setSync(const uint8_t *sync) {
+    rfm->set_sync(sync, SYNC_WORD_LEN);
+}
 
-static void waitTIM() {
-    if (tim_val > 0) {
-        tx_semaphore_get(&semTIM, TX_WAIT_FOREVER);
-    }
+/* sends announcement (fields up to the text) in the slot on FREQ_HOME, returns to the channel and to sync word of the
+ * announced cell */
+static void txAnn(const uint8_t *ann, const uint8_t *text) {
+    rfm->config_begin();
+    tune(FREQ_HOME);
+    setSync(dSyncWord);
+    rfm->config_commit();
+    GOD_TxLoad(ann, ANN_TEXT_OFFSET, text, ANN_TEXT_SIZE);
+    waitTIMTx();
+    rfm->config_begin();
+    setSync(ann);
+    tune(freqI);
+    rfm->config_commit();
 }
 
-void mTaskGEODE(uint32_t arg) {
+void mTaskGEODE(ULONG arg) {
     /* adjust master segments griding to others ? */
     const uint32_t mSyncDW = LL_GetUID_Word0();
     uint8_t        rep = 0, pos = 0;
     uint32_t       sAck[MAX_CONN_DWC];
     uint32_t       slots[MAX_CONN_DWC]; /* control on connection and disconnection */
+    uint32_t       wnd[MAX_CONN_DWC] = {}; /* windowed slaves */
+    uint32_t       lck[MAX_CONN_DWC] = {}; /* drift locked slaves, indexed as slots */
     uint16_t       synPDcnt = MPDS_TO_SYN;
+    uint32_t       act[MAX_CONN_DWC] = {}; /* slaves heard in the previous period */
+    chStat_t       ch[FREQ_CNT] = {};
 
-    mheader_t mh = {};
+    mheader_t mh = { .flags = msf_hdr, .hop = hopMask };
+    mack_t    mack = { .flags = msf_hdr | cmd_wnd };
     mdf_t     mdf = {};
     sdf_t     sdf = {};
-    uint8_t   buf[PKT_SIZE];
+    rsdf_t    rsdf;
+    rlyInfo_t ri = { .relay = RLY_NONE, .ann = RLY_NONE };
+    txFrag_t  frag = {};
+    uint8_t   buf[PKT_MAX_SIZE];
+    uint8_t   len;
 
     srand(tx_time_get());
-    const uint16_t pkt_time = PKT_TIM_CNT + ((uint64_t) rand() * PKT_GUARD_RAND_MAX) / RAND_MAX;
+    const uint16_t pkt_time =
+        PKT_TIM_CNT(FLAGS_OFFSET + dataSize) + ((uint64_t) rand() * PKT_GUARD_RAND_MAX) / RAND_MAX;
+    slotTim = pkt_time;
+    mh.slot = pkt_time;
 
-    memset(slots, ~0UL, sizeof(slots));
-    memset(sAck, ~0UL, sizeof(sAck));
+    memset(slots, 0xFF, sizeof(slots));
+    memset(sAck, 0xFF, sizeof(sAck));
 
-    mdf.slot = GOD_MBC;    // is not used yet
+    mdf.slot = GOD_MBC;
 
-    memcpy(buf, &mSyncDW, sizeof(mSyncDW));
-    RFM_SetSyncWord(buf, sizeof(mSyncDW));
+    setSync((const uint8_t *) &mSyncDW);
+    setNextFreq(!BIT_CHECK(hopMask, freqI));
 
-    LOG_INFO("MASTER: started with %08x pkt_time %d", mSyncDW, pkt_time);
+    LOG_INFO("MASTER: started with %08x pkt_time %d data %d", mSyncDW, pkt_time, dataSize);
 
     TIM_SET_AUTORELOAD(&GOD_TIM, pkt_time);
     HAL_TIM_Base_Start_IT(&GOD_TIM);
@@ -506,19 +1545,25 @@ void mTaskGEODE(uint32_t arg) {
 
         /* first slot for announcing */
         /* Tx our sync word + pos for new connection. we can announce multiple free slots */
-        if (statFlags & STAT_CONNECT && (--statFlags, pos < GOD_MAX_CONN)) {
+        const uint8_t maxConn = (ri.relay != RLY_NONE) ? GOD_MAX_CONN - RLY_FRAMES : GOD_MAX_CONN;
+        const uint8_t ann = statFlags & STAT_CONNECT &&
+                            ((LONG) (tx_time_get() - annEnd) < 0 || (statFlags &= ~STAT_CONNECT, 0)) &&
+                            pos < maxConn;
+        /* slots for master header, relay region follows scheduled frames */
+        const uint8_t sched = getFrames(slots, (statFlags & STAT_CONNECT && pos < maxConn) ? (pos + 1) : 0);
+        mh.frames = sched + ((ri.relay != RLY_NONE) ? RLY_FRAMES : 0U);
+        ri.ann = ann ? pos : RLY_NONE;
+        if (ann) {
             EXT_DLOG("MASTER: announce");
-            /* set announce syncword tx some data and return own syncword */
-            memcpy(buf, dSyncWord, sizeof(dSyncWord)); /* get rid of this shit */
-            RFM_SetSyncWord(buf, SYNC_WORD_LEN);
-            buf[SYNC_WORD_LEN] = pos;
-            *(uint16_t *) &buf[SYNC_WORD_LEN + 1] = pkt_time;
             memcpy(buf, &mSyncDW, sizeof(mSyncDW));
-            memcpy(buf + (SYNC_WORD_LEN + 3), bufAnn, PKT_SIZE - (SYNC_WORD_LEN + 3));
-            waitTIM();
-            GOD_Tx(buf, pkt_len);
-            memcpy(buf, &mSyncDW, sizeof(mSyncDW));
-            RFM_SetSyncWord(buf, sizeof(mSyncDW));
+            buf[SYNC_WORD_LEN] = pos;
+            ANN_SLOT_TIM(buf) = slotTim;
+            buf[SYNC_WORD_LEN + 3] = dataSize;
+            ANN_CHANNEL(buf) = freqI;
+            ANN_HOP(buf) = mh.hop;
+            ANN_FRAMES(buf) = mh.frames;
+            ANN_HDR_SLOTS(buf) = (MHDC_TIM_POS - MABC_TIM_POS) | (packCell ? ANN_PACK : 0U);
+            txAnn(buf, bufAnn);
         }
 
         /* some commands processing */
@@ -530,143 +1575,484 @@ void mTaskGEODE(uint32_t arg) {
             EXT_DLOG("MASTER: cmd_syn");
         }
 
-        /* slots for master header */
         tim_val += MHDC_TIM_POS - MABC_TIM_POS;
-        if (rep || (statFlags & STAT_CONNECT)) {
-            memcpy(buf, &mh, PKT_SIZE); /* get rid of this shit */
-            waitTIM();
-            GOD_Tx(buf, pkt_len);
+        if (rep || mh.frames) {
+            if (ri.relay != RLY_NONE) {
+                GOD_TxLoad(&mh, HDR_SIZE(mh.frames), &ri, RLY_INFO_SIZE(mh.frames));
+            } else {
+                GOD_TxLoad(&mh, HDR_SIZE(mh.frames), NULL, 0);
+            }
+            waitTIMTx();
             EXT_DLOG("MASTER: tx header");
+            /* slots of the header on are as advertised, counter is yet at the beginning of the slot */
+            if (slotTim != mh.slot) {
+                slotTim = mh.slot;
+                TIM_SET_AUTORELOAD(&GOD_TIM, slotTim);
+                LOG_INFO("MASTER: slot time %d", slotTim);
+            }
             COM_CMD_SET(mh.flags, cmd_nop); /* yet just clean it. l8r make state machine of commands processing */
             rep &= ~4U;
+
+            /* acks of the second channel in the second slot of header frame */
+            if (wnd[0] | wnd[1] | wnd[2] | wnd[3]) {
+                GOD_TxLoad(&mack, WND_SIZE(mh.frames), NULL, 0);
+                tim_val += 1;
+                waitTIMTx();
+                tim_val -= 1;
+            }
         }
+        hopMask = mh.hop;
 
         /* slot for data fragment */
         tim_val += MDFC_TIM_POS - MHDC_TIM_POS;
         if (rep & 2) {
             EXT_DLOG("MASTER: tx data");
-            memcpy(buf, &mdf, PKT_SIZE); /* get rid of this shit */
-            waitTIM();
-            GOD_Tx(buf, pkt_len);
+            /* relay repeats it while a slave behind it has not acked */
+            mdf.slot = GOD_MBC;
+            for (uint8_t d = 0; ri.relay != RLY_NONE && d < MAX_CONN_DWC; ++d) {
+                if (ri.via[d] & sAck[d] & ~slots[d]) {
+                    mdf.slot = MDF_RLY(ri.relay);
+                    break;
+                }
+            }
+            GOD_TxLoad(&mdf, DF_PKT_SIZE(mdf.df), NULL, 0);
+            waitTIMTx();
+            fragSent(&frag);
         }
 
-        for (uint8_t i = 0; i < GOD_MAX_CONN; ++i) {
+        for (uint8_t f = 0; f < mh.frames; ++f) {
             tim_val += FRAME_TO_SLOTS(1);
-            if ((ARR_BIT_CHECK(slots, i ^ DWB_INDX_MASK) && !((statFlags & STAT_CONNECT) && i == pos)) ||
-                ((waitTIM()), RFM_Rx((uint8_t *) &sdf, &pkt_len, PKT_OFFSET(1)) != RFM_OK)) {
-                continue;
+            uint8_t i = f; /* slot of the fragment, forwarded ones carry it */
+            if (f >= sched) {
+                /* relay region, forwarded fragments are in the first slots of its last frames */
+                if (f < sched + RLY_FRAMES - RLY_FWD ||
+                    ((waitTIM()), GOD_Rx((uint8_t *) &rsdf, &len, PKT_OFFSET(1))) != RFM_OK ||
+                    len < FLAGS_OFFSET + 1U || (i = rsdf.slot) >= sched ||
+                    !(ARR_BIT_CHECK(ri.via, i ^ DWB_INDX_MASK) || ((statFlags & STAT_CONNECT) && i == pos))) {
+                    continue;
+                }
+                memcpy(&sdf, &rsdf.sdf, --len);
+            } else if ((ARR_BIT_CHECK(slots, i ^ DWB_INDX_MASK) && !((statFlags & STAT_CONNECT) && i == pos)) ||
+                       ARR_BIT_CHECK(ri.via, i ^ DWB_INDX_MASK)) {
+                continue; /* free or behind the relay */
             }
-            rep |= 4;
-
-            EXT_DLOG("MASTER: slave %d process", i);
-
-            /* if we expecting connection listen slot that we announced */
-            /* process connection on success stop announcing*/
-            if (COM_CMD_CHECK(sdf.flags, msf_cmd)) {
-                mh.flags ^= msf_ack;
-                if (statFlags & STAT_CONNECT) {
-                    /* process connection */
-                    LOG_INFO("MASTER: slave %d connecting", i);
-                    ARR_BIT_RESET(slots, i ^ DWB_INDX_MASK);
-                    statFlags &= ~STAT_CONNECT;
+            /* idle slaves do not tx, channel is judged by slaves that did in the previous period */
+            const uint8_t exp = f < sched && !ARR_BIT_CHECK(slots, i ^ DWB_INDX_MASK) && ARR_BIT_CHECK(act, i);
+            ch[freqI].exp += exp;
+            ARR_BIT_RESET(act, i);
+            /* connecting slave has no state yet */
+            god_link_stat_t *const stat = (arrRx[i].buf != NULL) ? &arrRx[i].buf->stat : &statNone;
+            /* windowed slave uses the second slot of the frame too */
+            if (f < sched && ((waitTIM()), GOD_Rx((uint8_t *) &sdf, &len,
+                                                   ARR_BIT_CHECK(wnd, i) ? PKT_SLOT_OFFSET : PKT_OFFSET(1))) != RFM_OK) {
+                /* slave that has not acked our data yet answers it for sure */
+                stat->lost += (rep & 2) && ARR_BIT_CHECK(sAck, i ^ DWB_INDX_MASK);
+            } else {
+                rep |= 4;
+                ch[freqI].ok += exp;
+                ARR_BIT_SET(act, i);
+                if (sampleRssi(stat, stat->rx++)) {
+                    ch[freqI].rssi += stat->rssi;
+                    ++ch[freqI].rssiCnt;
+                }
+
+                EXT_DLOG("MASTER: slave %d process", i);
+
+                /* if we expecting connection listen slot that we announced */
+                /* process connection on success stop announcing*/
+                if (COM_CMD_CHECK(sdf.flags, msf_cmd)) {
+                    mh.flags ^= msf_ack;
+                    if (statFlags & STAT_CONNECT) {
+                        /* process connection, route is the way it came */
+                        LOG_INFO("MASTER: slave %d connecting%s", i, (f >= sched) ? " via relay" : "");
+                        ARR_BIT_RESET(slots, i ^ DWB_INDX_MASK);
+                        ARR_BIT_RESET(lck, i ^ DWB_INDX_MASK);
+                        if (f >= sched) {
+                            ARR_BIT_SET(ri.via, i ^ DWB_INDX_MASK);
+                        } else {
+                            ARR_BIT_RESET(ri.via, i ^ DWB_INDX_MASK);
+                        }
+                        statFlags &= ~STAT_CONNECT;
+                        continue;
+                    }
+                    /* second step in connection */
+                    if (!ARR_BIT_CHECK(slots, i ^ DWB_INDX_MASK) &&
+                        (ARR_BIT_CHECK(mh.ack, i) ^ !!(sdf.flags & msf_sn))) {
+                        createBuf(i);
+                        arrRx[i].buf->pack = (sdf.df.mf_dlen & dff_len) && (sdf.df.data[0] & PACK_CAP);
+                        memset(&arrRx[i].buf->unpack, 0, sizeof(arrRx[i].buf->unpack));
+                        /* mb change getSlot fn to remove those index inversions, and make random or max slaves
+                         * dispensation (not in row as is) */
+                        ARR_BIT_RESET(sAck, i ^ DWB_INDX_MASK);
+                        if (GOD_WND_SIZE > 1 && (sdf.flags & msf_wnd) && f < sched) {
+                            ARR_BIT_SET(wnd, i);
+                            ARR_BIT_RESET(mack.ack, i);
+                            arrRx[i].buf->seq = arrRx[i].buf->ahead.df.mf_dlen = 0;
+                        }
+                        pos = getSlot(slots);
+                        LOG_INFO("MASTER: slave %d connected", i);
+                        /* pass more info to ensure that it is ours node */
+                    } else {
+                        /* if we get here and it already connected something happened to slave. reject him and warn
+                         * user */
+                        LOG_WARN("MASTER: slave %d missbehavior", i);
+                        mh.flags ^= msf_ack;
+                        ARR_BIT_SET(slots, i ^ DWB_INDX_MASK);
+                        ARR_BIT_RESET(wnd, i);
+                        ARR_BIT_RESET(ri.via, i ^ DWB_INDX_MASK);
+                        if (ri.relay == i) {
+                            /* slaves behind it are expected in their frames again */
+                            ri.relay = RLY_NONE;
+                            memset(ri.via, 0, sizeof(ri.via));
+                        }
+                    }
                     continue;
                 }
-                /* second step in connection */
-                if (!ARR_BIT_CHECK(slots, i ^ DWB_INDX_MASK) && (ARR_BIT_CHECK(mh.ack, i) ^ !!(sdf.flags & msf_sn))) {
-                    createBuf(i);
-                    /* mb change getSlot fn to remove those index inversions, and make random or max slaves dispensation
-                     * (not in row as is) */
-                    ARR_BIT_RESET(sAck, i ^ DWB_INDX_MASK);
-                    pos = getSlot(slots);
-                    LOG_INFO("MASTER: slave %d connected", i);
-                    /* pass more info to ensure that it is ours node */
+
+                /* !todo commands processing */
+                if (COM_CMD_CHECK(sdf.flags, cmd_lck)) {
+                    ARR_BIT_SET(lck, i ^ DWB_INDX_MASK);
                 } else {
-                    /* if we get here and it already connected something happened to slave. reject him and warn user */
-                    LOG_WARN("MASTER: slave %d missbehavior", i);
-                    mh.flags ^= msf_ack;
-                    ARR_BIT_SET(slots, i ^ DWB_INDX_MASK);
+                    ARR_BIT_RESET(lck, i ^ DWB_INDX_MASK);
+                }
+                /* slot of MDF_RLY() is never GOD_MBC */
+                if (COM_CMD_CHECK(sdf.flags, cmd_rly) && ri.relay == RLY_NONE && f < sched && i < GOD_MAX_CONN - 1 &&
+                    sched + RLY_FRAMES <= GOD_MAX_CONN) {
+                    ri.relay = i;
+                    LOG_INFO("MASTER: slave %d relays", i);
                 }
-                continue;
-            }
 
-            /* !todo commands processing */
+                if (ARR_BIT_CHECK(sAck, i ^ DWB_INDX_MASK) && ((mh.flags & msf_sn) ^ ((sdf.flags & msf_ack) >> 1))) {
+                    ARR_BIT_RESET(sAck, i ^ DWB_INDX_MASK);
+                    EXT_DLOG("MASTER: slave %d got msg", i);
+                }
 
-            if (ARR_BIT_CHECK(sAck, i ^ DWB_INDX_MASK) && ((mh.flags & msf_sn) ^ ((sdf.flags & msf_ack) >> 1))) {
-                ARR_BIT_RESET(sAck, i ^ DWB_INDX_MASK);
-                EXT_DLOG("MASTER: slave %d got msg", i);
+                if (ARR_BIT_CHECK(mh.ack, i) != !!(sdf.flags & msf_sn)) {
+                    ++stat->dup;
+                } else {
+                    EXT_DLOG("MASTER: got data from slave %d", i);
+                    /* there is some new data */
+                    sdf.flags = i;
+                    /* do not ack it if buffer is full, slave repeats it each period till reader frees the place.
+                     * special command for suspending tx can be added to prevent such spam
+                     */
+                    if ((ARR_BIT_CHECK(wnd, i) ? writeWndMsg : writeRxMsg)((uint8_t *) &sdf) == GOD_OK) {
+                        ARR_BIT_TOGGLE(mh.ack, i);
+                    }
+                }
             }
 
-            if (ARR_BIT_CHECK(mh.ack, i) == !!(sdf.flags & msf_sn)) {
-                EXT_DLOG("MASTER: got data from slave %d", i);
-                /* there is some new data */
-                sdf.flags = i;
-                writeRxMsg((uint8_t *) &sdf);
-                /* do not ack it if buffer is full?
-                 * but in this case slave will spam each period.
-                 * special command for suspending tx can be added to prevent such situations
-                 */
-
-                ARR_BIT_TOGGLE(mh.ack, i);
+            if (!ARR_BIT_CHECK(wnd, i)) {
+                continue;
+            }
+            tim_val += 1;
+            if ((waitTIM()), GOD_Rx((uint8_t *) &sdf, &len, PKT_SLOT_OFFSET) == RFM_OK &&
+                                 (sdf.flags & (msf_wnd | msf_cmd)) == msf_wnd) {
+                rep |= 4;
+                ++stat->rx;
+                if (ARR_BIT_CHECK(mack.ack, i) != !!(sdf.flags & msf_sn)) {
+                    ++stat->dup;
+                } else {
+                    EXT_DLOG("MASTER: got second data from slave %d", i);
+                    sdf.flags = i;
+                    if (writeWndMsg((uint8_t *) &sdf) == GOD_OK) {
+                        ARR_BIT_TOGGLE(mack.ack, i);
+                    }
+                }
             }
+            tim_val -= 1;
         }
 
-        if (nsubset(slots, sAck, MAX_CONN_DWC) && ((rep &= ~3U), getTxMsg(((uint8_t *) &mdf) + 1))) {
+        if (nsubset(slots, sAck, MAX_CONN_DWC) &&
+            ((fragAcked(&frag)), (rep &= ~3U), getTxMsg(((uint8_t *) &mdf) + 1, &frag))) {
             EXT_DLOG("MASTER: preparing new msg");
             rep |= 3;
-            memset(sAck, ~0LU, sizeof(sAck));
+            memset(sAck, 0xFF, sizeof(sAck));
             mh.flags ^= msf_sn;
         }
+        /* guard shrinks when every connected slave is drift locked, it is advertised in the next header */
+        mh.slot = pkt_time - ((profile->guard > profile->guardLck) ? (profile->guard - profile->guardLck) : 0U);
+        for (uint8_t d = 0; d < MAX_CONN_DWC; ++d) {
+            if ((slots[d] | lck[d]) != ~0U) {
+                mh.slot = pkt_time;
+                break;
+            }
+        }
+        /* hop set for the next header */
+        for (uint8_t c = 0; c < FREQ_CNT; ++c) {
+            ch[c].ban -= !!ch[c].ban;
+        }
+        mh.hop = evalHop(mh.hop, ch);
         setNextFreq(1);
         tim_val += FRAME_TO_SLOTS(1);
         waitTIM();
     }
 }
 
+/* a slave dropped from the schedule keeps its frame till it is scheduled again */
+static inline void setFrames(mheader_t *mh, uint8_t pos) {
+    frames = (mh->frames > pos) ? mh->frames : pos + 1;
+}
+
+/* slots from the header to master data, to own frame and from own frame to the next header. header repeated by relay
+ * is in the region at the end of the period, so own frame is in the next one */
+static inline uint16_t hdrToData(void) {
+    return viaRelay ? RLY_DATA_SLOT - RLY_HDR_SLOT : MDFC_TIM_POS - MHDC_TIM_POS;
+}
+
+static inline uint16_t hdrToTx(uint8_t pos) {
+    return viaRelay ? FRAME_TO_SLOTS(RLY_FRAMES + pos + MCD_COUNT) - RLY_HDR_SLOT
+                    : FRAME_TO_SLOTS(pos + MCD_COUNT) - MHDC_TIM_POS;
+}
+
+static inline uint16_t txToHdr(uint8_t pos) {
+    return viaRelay ? FRAME_TO_SLOTS(frames - RLY_FRAMES - pos) + RLY_HDR_SLOT
+                    : FRAME_TO_SLOTS(frames - pos) + MHDC_TIM_POS;
+}
+
+/* fragment of a slave behind the relay is forwarded when it connects, is not acked yet or acks master data repeated by
+ * the relay, mh is the latest header of master */
+static inline uint8_t rlyWorth(const mheader_t *mh, const sdf_t *sdf, uint8_t slot, uint8_t data) {
+    return COM_CMD_CHECK(sdf->flags, msf_cmd) || ARR_BIT_CHECK(mh->ack, slot) == !!(sdf->flags & msf_sn) ||
+           (data && ((mh->flags & msf_sn) ^ ((sdf->flags & msf_ack) >> 1)));
+}
+
+/* connecting slave goes first, the rest in turn from rlyNext */
+static inline uint16_t rlyPrio(const rsdf_t *r) {
+    return COM_CMD_CHECK(r->sdf.flags, msf_cmd) ? 0U : 1U + RLY_PRIO(r->slot);
+}
+
+/* queues fragment received to rlyQ[rlyCnt], full queue drops the one of the lowest priority */
+static void rlyPut(uint8_t len) {
+    uint8_t low = rlyCnt;
+
+    rlyLen[rlyCnt] = len;
+    if (rlyCnt < RLY_FWD) {
+        ++rlyCnt;
+        return;
+    }
+    for (uint8_t k = 0; k < RLY_FWD; ++k) {
+        if (rlyPrio(&rlyQ[k]) > rlyPrio(&rlyQ[low])) {
+            low = k;
+        }
+    }
+    if (rlyPrio(&rlyQ[low]) && (rlyDrop == RLY_NONE || RLY_PRIO(rlyQ[low].slot) < RLY_PRIO(rlyDrop))) {
+        rlyDrop = rlyQ[low].slot;
+    }
+    if (low != RLY_FWD) {
+        rlyQ[low] = rlyQ[RLY_FWD];
+        rlyLen[low] = rlyLen[RLY_FWD];
+    }
+}
+
+/* listens frames [from, to) of slaves behind the relay and of the slot announced by master, tim_val counts to slot at
+ * of the period */
+static void rlyListen(const mheader_t *mh, const rlyInfo_t *ri, uint8_t data, uint8_t from, uint8_t to, uint16_t at) {
+    uint8_t len;
+
+    for (uint8_t c = from; c < to; ++c) {
+        if (!ARR_BIT_CHECK(ri->via, c ^ DWB_INDX_MASK) && c != ri->ann) {
+            continue;
+        }
+        const int16_t off = FRAME_TO_SLOTS(c + MCD_COUNT) - at;
+        rsdf_t *const in = &rlyQ[rlyCnt];
+        tim_val += off;
+        if ((waitTIM()), GOD_Rx((uint8_t *) &in->sdf, &len, PKT_OFFSET(1)) == RFM_OK && len >= FLAGS_OFFSET &&
+                             rlyWorth(mh, &in->sdf, c, data)) {
+            in->slot = c;
+            rlyPut(len + 1U);
+        }
+        tim_val -= off;
+    }
+}
+
+/* relay region at the end of the period, tim_val counts to slot at of the period. slaves behind the relay are
+ * addressed under its sync word rSync, fragments are forwarded under the one of master */
+static void rlyRegion(const uint8_t *rSync, const uint8_t *mSync, const mheader_t *mh, mdf_t *mdf, uint8_t data,
+                      uint8_t ann, uint16_t at) {
+    static const uint8_t text[ANN_TEXT_SIZE] = "relay";
+    const int16_t        off = FRAME_TO_SLOTS(mh->frames - RLY_FRAMES + MCD_COUNT) - at;
+    uint8_t              buf[ANN_TEXT_OFFSET];
+
+    tim_val += off;
+    if (ann != RLY_NONE) {
+        memcpy(buf, rSync, SYNC_WORD_LEN);
+        buf[SYNC_WORD_LEN] = ann;
+        ANN_SLOT_TIM(buf) = slotTim;
+        buf[SYNC_WORD_LEN + 3] = dataSize - 1U; /* fragment and its slot fit a packet */
+        ANN_CHANNEL(buf) = freqI;
+        ANN_HOP(buf) = mh->hop;
+        ANN_FRAMES(buf) = mh->frames;
+        ANN_HDR_SLOTS(buf) = RLY_HDR_SLOT | ANN_RELAYED | (packCell ? ANN_PACK : 0U);
+        txAnn(buf, text);
+    }
+    tim_val += RLY_HDR_SLOT;
+    GOD_TxLoad(mh, HDR_SIZE(mh->frames), NULL, 0);
+    waitTIMTx();
+    if (data) {
+        mdf->slot = GOD_MBC;
+        GOD_TxLoad(mdf, DF_PKT_SIZE(mdf->df), NULL, 0);
+        tim_val += RLY_DATA_SLOT - RLY_HDR_SLOT;
+        waitTIMTx();
+        tim_val -= RLY_DATA_SLOT - RLY_HDR_SLOT;
+    }
+    setSync(mSync);
+    for (uint8_t k = 0; k < rlyCnt; ++k) {
+        GOD_TxLoad(&rlyQ[k], rlyLen[k], NULL, 0);
+        tim_val += RLY_FWD_SLOT + FRAME_TO_SLOTS(k) - RLY_HDR_SLOT;
+        waitTIMTx();
+        tim_val -= RLY_FWD_SLOT + FRAME_TO_SLOTS(k) - RLY_HDR_SLOT;
+    }
+    tim_val -= off + RLY_HDR_SLOT;
+    rlyNext = (rlyDrop != RLY_NONE) ? rlyDrop : rlyNext;
+    rlyDrop = RLY_NONE;
+    rlyCnt = 0;
+}
+
+/* header re-syncs slot time and timing of slots, counter is set to the time passed since the header slot began */
+static void syncHeader(mheader_t *mh, uint8_t len) {
+    slotTim = mh->slot;
+    hopMask = mh->hop;
+    HAL_TIM_GenerateEvent(&GOD_TIM, TIM_EVENTSOURCE_UPDATE);
+    __HAL_TIM_SET_COUNTER(&GOD_TIM, PKT_SYNC_TIM(len));
+    tim_val = 0;
+}
+
+/* drift PLL sample, header of the period of _slots slots came err ticks later than the local timer expected */
+static void trimDrift(int32_t err, uint16_t slots) {
+    const uint32_t dev = (err < 0) ? -err : err;
+
+    if (dev > slotTim / 4U) {
+        return; /* not a drift, header of another period or the timer was restarted */
+    }
+    pllTrim += (err * (1 << PLL_FRAC_SHIFT) / slots) / (1 << PLL_GAIN_SHIFT);
+    if (dev > PLL_LOCK_TIM) {
+        pllLock = 0;
+    } else if (pllLock < PLL_LOCK_CNT && ++pllLock == PLL_LOCK_CNT) {
+        LOG_INFO("SLAVE: drift locked, trim %d/%d per slot", (int) pllTrim, 1 << PLL_FRAC_SHIFT);
+    }
+}
+
+/* find translation, get header of a period. channel is left after the hop set gone round without master on it.
+ * returns header length */
+static uint8_t findHeader(uint8_t *buf) {
+    uint8_t    len;
+    rfm_stat_t stat;
+    pllLock = 0;
+    while ((stat = GOD_Rx(buf, &len, PKT_OFFSET((frames + MCD_COUNT) * HOP_CNT + 1))) != RFM_OK ||
+           !COM_HDR_CHECK(((mheader_t *) buf)->flags)) {
+        if (stat == RFM_ERR_TIMEOUT) {
+            EXT_DLOG("Failed to find translations");
+            /* !todo give it finite tries? */
+            tune(freqI = (freqI + 1) % FREQ_CNT);
+        }
+    }
+    EXT_DLOG("Found translation");
+    return len;
+}
+
+/* catch header of the master of ann on the channel and time predicted by the last announcement GOD_Scan() heard.
+ * returns header length, 0 if it did not work out */
+static uint8_t catchHeader(uint8_t *buf, const uint8_t *ann) {
+    uint8_t i, len, k = 0;
+
+    if (bufAnn == NULL) {
+        return 0;
+    }
+    for (i = 0; i < bufAnn[0] && memcmp(ann, (bufAnn + 1) + (i * ANN_SIZE), SYNC_WORD_LEN); ++i) {
+    }
+    if (i == bufAnn[0]) {
+        return 0;
+    }
+    ann = (bufAnn + 1) + (i * ANN_SIZE);
+
+    const uint16_t slot = ANN_SLOT_TIM(ann);
+    const ULONG    per = TIM_TO_TICKS((uint32_t) FRAME_TO_SLOTS(ANN_FRAMES(ann) + MCD_COUNT) * slot);
+    const ULONG    margin = TIM_TO_TICKS(slot) / 2U + 1U;
+    const uint8_t  hdrSlots = ANN_HDR_SLOTS(ann) & ANN_HDR_MASK;
+    /* listen from half a slot before the header slot of the announced period or of the next ones */
+    ULONG hdr = annTime[i] - TIM_TO_TICKS(PKT_SYNC_TIM(ANN_SIZE)) + TIM_TO_TICKS(hdrSlots * slot) - margin;
+    while ((LONG) (hdr - tx_time_get()) <= 0) {
+        if (++k > SPDS_TO_CATCH) {
+            return 0;
+        }
+        hdr += per;
+    }
+    hopMask = ANN_HOP(ann);
+    freqI = ANN_CHANNEL(ann) % FREQ_CNT;
+    setNextFreq(k);
+
+    tx_thread_sleep(hdr - tx_time_get());
+    if (GOD_Rx(buf, &len, 2U * margin + TIM_TO_TICKS(slot)) != RFM_OK || !COM_HDR_CHECK(((mheader_t *) buf)->flags)) {
+        return 0;
+    }
+    return len;
+}
+
 /* do we need this as function */
-static uint8_t sEnsureTx(uint8_t *buf, uint8_t *data, uint8_t pos) {
-    memcpy(buf, data, pkt_len); /* get rid of this shit */
-    tim_val += FRAME_TO_SLOTS(pos + MCD_COUNT) - MHDC_TIM_POS;
-    waitTIM();
-    GOD_Tx(buf, pkt_len);
+static uint8_t sEnsureTx(uint8_t *buf, sdf_t *data, uint8_t pos) {
+    uint8_t len;
+    /* channel is changed before FIFO is loaded */
+    if (viaRelay) {
+        setNextFreq(1);
+    }
+    GOD_TxLoad(data, DF_PKT_SIZE(data->df), NULL, 0);
+    tim_val += hdrToTx(pos);
+    waitTIMTx();
     EXT_DLOG("tx header %d %d", pos, DWT_CYCCNT / 9600, DWT_CYCCNT = 0);
 
-    setNextFreq(1);
+    if (!viaRelay) {
+        setNextFreq(1);
+    }
 
     EXT_DLOG("listen master...");
-    tim_val += FRAME_TO_SLOTS(GOD_MAX_CONN - pos) + MHDC_TIM_POS;
+    tim_val += txToHdr(pos);
+    if (viaRelay) {
+        /* header repeated in the period of the fragment is older than it, master answers in the next one */
+        tim_val += FRAME_TO_SLOTS(frames + MCD_COUNT);
+        setNextFreq(1);
+    }
     waitTIM();
 
     /* !todo meaningful connection information */
-    return RFM_Rx(buf, &pkt_len, PKT_OFFSET(1)) != RFM_OK ||
-           /* add master decline possibility */
-           (((mheader_t *) buf)->flags ^ ((sdf_t *) data)->flags) & msf_ack;
+    if (GOD_Rx(buf, &len, PKT_OFFSET(1)) != RFM_OK || !COM_HDR_CHECK(((mheader_t *) buf)->flags)) {
+        return 1;
+    }
+    syncHeader((mheader_t *) buf, len);
+    setFrames((mheader_t *) buf, pos);
+    /* add master decline possibility */
+    return (((mheader_t *) buf)->flags ^ data->flags) & msf_ack;
 }
 
-static inline uint8_t connect(uint8_t pos, sdf_t *sdf_ptr,
-                              uint8_t *buf) { /* add some timeout? and return state to user? */
+static inline uint8_t connect(uint8_t pos, sdf_t *sdf_ptr, uint8_t *buf,
+                              const uint8_t *ann) { /* add some timeout? and return state to user? */
     EXT_DLOG("Trying connect to master...");
 
-    COM_CMD_SET(sdf_ptr->flags, msf_cmd | msf_ack | msf_sn); /* mb add some data for connection */
-
-    /* find translation, get first packet, establish connection and synchronization */
-    while (RFM_Rx(buf, &pkt_len, PKT_OFFSET(PERIOD * freqN + 1)) == RFM_ERR_TIMEOUT) {
-        EXT_DLOG("Failed to find translations");
-        /* !todo give it finite tries? */
-    }
-    EXT_DLOG("Found translation");
-
-    /* get masters header */
-    while (setNextFreq(1), RFM_Rx(buf, &pkt_len, RFM_WAIT_FOREVER) != RFM_OK) {
+    /* mb add some data for connection */
+    COM_CMD_SET(sdf_ptr->flags, msf_cmd | msf_ack | msf_sn | ((GOD_WND_SIZE > 1 && !viaRelay) ? msf_wnd : 0));
+    /* capabilities go as data of the connection fragment, masters before packing skip it */
+    sdf_ptr->df.mf_dlen = packTx ? 1U : 0U;
+    sdf_ptr->df.data[0] = PACK_CAP;
+
+    /* find translation, establish connection and synchronization */
+    uint8_t len = catchHeader(buf, ann);
+    if (len == 0) {
+        EXT_DLOG("Announced header missed");
+        len = findHeader(buf);
     }
+    setFrames((mheader_t *) buf, pos);
 
+    slotTim = ((mheader_t *) buf)->slot;
+    hopMask = ((mheader_t *) buf)->hop;
+    TIM_SET_AUTORELOAD(&GOD_TIM, slotTim);
     HAL_TIM_Base_Start_IT(&GOD_TIM);
-    __HAL_TIM_SET_COUNTER(&GOD_TIM, PKT_TIM_LEN + TX_OFFSET);
-    tim_val = 0;    // write here slot passed in master header
+    __HAL_TIM_SET_COUNTER(&GOD_TIM, PKT_SYNC_TIM(len));
+    tim_val = 0;
     EXT_DLOG("TIM start");
 
     sdf_ptr->flags ^= (((mheader_t *) buf)->flags & msf_ack);
 
-    while (sEnsureTx(buf, (uint8_t *) sdf_ptr, pos)) {
+    while (sEnsureTx(buf, sdf_ptr, pos)) {
     }
 
     EXT_DLOG("Go ahead");
@@ -675,10 +2061,11 @@ static inline uint8_t connect(uint8_t pos, sdf_t *sdf_ptr,
     }
     sdf_ptr->flags ^= msf_ack;
 
-    while (sEnsureTx(buf, (uint8_t *) sdf_ptr, pos)) {
+    while (sEnsureTx(buf, sdf_ptr, pos)) {
     }
 
     COM_CMD_SET(sdf_ptr->flags, cmd_nop);
+    sdf_ptr->df.mf_dlen = 0;
     if (((mheader_t *) buf)->flags & msf_sn) {
         (sdf_ptr->flags &= ~msf_ack);
     } else {
@@ -688,20 +2075,37 @@ static inline uint8_t connect(uint8_t pos, sdf_t *sdf_ptr,
     return 0; /*some return value? */
 }
 
-void sTaskGEODE(uint32_t arg) {
+void sTaskGEODE(ULONG arg) {
     const uint8_t pos = *((uint8_t *) arg + SYNC_WORD_LEN);
     uint8_t       rep = 0;    // for this statFlags can be used
+    uint8_t       missed = 0;
+    uint8_t       wndTry = SPDS_TO_WND; /* headers left to find out master runs windowed ARQ */
+    uint8_t       seq = 0, seqA = 0, seqB = 0; /* next fragment and ones in the channels */
     sdf_t         sdf = {};
+    sdf_t         sdfw = { .flags = msf_wnd | msf_sn }; /* second channel, acked before the first fragment */
     mheader_t     mh = {};
+    mack_t        mack = {};
     mdf_t         mdf = {};
-    uint8_t       buf[PKT_SIZE];
-
-    memcpy(buf, (uint8_t *) arg, SYNC_WORD_LEN);
-    RFM_SetSyncWord(buf, SYNC_WORD_LEN);
-
-    TIM_SET_AUTORELOAD(&GOD_TIM, *(uint16_t *) (arg + SYNC_WORD_LEN + 1));
-
-    connect(pos, &sdf, (uint8_t *) &mh);    // somehow notify user about progress?
+    txFrag_t      fragA = {}, fragB = {};
+    uint32_t      hdrs = 0;
+    rlyInfo_t     ri = { .relay = RLY_NONE, .ann = RLY_NONE };
+    uint8_t       relaying = 0, rlyData = 0; /* granted by the header, master data to repeat */
+    uint8_t       buf[PKT_MAX_SIZE];
+    uint8_t       len;
+    /* sync word of slaves behind the relay */
+    const uint32_t rSyncDW = LL_GetUID_Word0();
+
+    setSync((uint8_t *) arg);
+
+    slotTim = *(uint16_t *) (arg + SYNC_WORD_LEN + 1);
+    dataSize = *((uint8_t *) arg + SYNC_WORD_LEN + 3);
+    TIM_SET_AUTORELOAD(&GOD_TIM, slotTim);
+    /* relayed slave runs single bit ARQ, there is no second slot in the region */
+    viaRelay = !!(ANN_HDR_SLOTS((uint8_t *) arg) & ANN_RELAYED);
+    wndTry = viaRelay ? 0 : wndTry;
+
+    connect(pos, &sdf, buf, (uint8_t *) arg);    // somehow notify user about progress?
+    memcpy(&mh, buf, sizeof(mh));
 
     LOG_INFO("SLAVE: connected as %d to %08x", pos, *(uint32_t *) arg);
 
@@ -711,57 +2115,164 @@ void sTaskGEODE(uint32_t arg) {
     /* what if when we connected master was tx some data. how we gonna ignore it */
 
     createBuf(0);
+    arrRx[0].buf->pack = packCell;
+    god_link_stat_t *const stat = &arrRx[0].buf->stat;
 
     while (1) {
+        /* after missed header schedule of the period is unknown, keep silent till the next one */
         /* we can't do not listen if already got data */
-        tim_val += MDFC_TIM_POS - MHDC_TIM_POS;
-        if ((waitTIM(), RFM_Rx((uint8_t *) &mdf, &pkt_len, PKT_OFFSET(1)) == RFM_OK) &&
-            ((rep = 1), (mh.flags & msf_sn) == ((sdf.flags & msf_ack) >> 1))) {
+        tim_val += hdrToData();
+        rlyData = 0;
+        if (!missed && (napTIM(), waitTIM(), GOD_Rx((uint8_t *) &mdf, &len, PKT_OFFSET(1)) == RFM_OK) &&
+            ((rep = 1), ++stat->rx, (rlyData = relaying && mdf.slot == MDF_RLY(pos)),
+             (mh.flags & msf_sn) == ((sdf.flags & msf_ack) >> 1) || (++stat->dup, 0))) {
             EXT_DLOG("SLAVE: got data from master");
             /* there is some new data */
-            sdf.flags ^= msf_ack;
             /* handle slot (compare it with own pos) */
 
             mdf.slot = 0; /* ? */
-            writeRxMsg((uint8_t *) &mdf);
+            /* master repeats not acked data */
+            if (writeRxMsg((uint8_t *) &mdf) == GOD_OK) {
+                sdf.flags ^= msf_ack;
+            }
         }
         EXT_DLOG("SLAVE: elapsed time %ld\n", DWT_CYCCNT / 9600, DWT_CYCCNT = 0);
 
         /* listen master packets */
-        if (ARR_BIT_CHECK(mh.ack, pos) ^ !!(sdf.flags & msf_sn) && ((rep = 0), getTxMsg(((uint8_t *) &sdf) + 1))) {
+        if (!missed && ARR_BIT_CHECK(mh.ack, pos) ^ !!(sdf.flags & msf_sn)) {
+            fragAcked(&fragA);
+        }
+        if (!missed && wndTry == WND_ON && ARR_BIT_CHECK(mack.ack, pos) ^ !!(sdfw.flags & msf_sn)) {
+            fragAcked(&fragB);
+        }
+        /* a channel takes the next fragment while the other one does not hold older than previous */
+        if (!missed && ARR_BIT_CHECK(mh.ack, pos) ^ !!(sdf.flags & msf_sn) &&
+            ((rep = 0), (ARR_BIT_CHECK(mack.ack, pos) ^ !!(sdfw.flags & msf_sn)) ||
+                            seqB == ((seq - 1) & DFF_SEQ_MASK)) &&
+            getTxMsg(((uint8_t *) &sdf) + 1, &fragA)) {
             /* there is some new data to tx */
             EXT_DLOG("SLAVE: preparing new msg");
             sdf.flags ^= msf_sn;
+            sdf.df.mf_dlen |= seq << DFF_SEQ_SHIFT;
+            seqA = seq;
+            seq = (seq + 1) & DFF_SEQ_MASK;
             rep = 1;
         }
+        if (!missed && wndTry == WND_ON && ARR_BIT_CHECK(mack.ack, pos) ^ !!(sdfw.flags & msf_sn) &&
+            (ARR_BIT_CHECK(mh.ack, pos) ^ !!(sdf.flags & msf_sn) || seqA == ((seq - 1) & DFF_SEQ_MASK)) &&
+            getTxMsg(((uint8_t *) &sdfw) + 1, &fragB)) {
+            EXT_DLOG("SLAVE: preparing new second msg");
+            sdfw.flags ^= msf_sn;
+            sdfw.df.mf_dlen |= seq << DFF_SEQ_SHIFT;
+            seqB = seq;
+            seq = (seq + 1) & DFF_SEQ_MASK;
+        }
+
+        /* slaves behind the relay tx before it */
+        if (relaying && !missed) {
+            setSync((const uint8_t *) &rSyncDW);
+            rlyListen(&mh, &ri, rlyData, 0, pos, MDFC_TIM_POS);
+            setSync((uint8_t *) arg);
+        }
+        /* relayed slave's frame is in the next period */
+        if (viaRelay) {
+            setNextFreq(1);
+        }
 
         /* tx slot */
         /* add some randomization of translation in slot (random segment) */
-        tim_val += FRAME_TO_SLOTS(pos) + MDFC_TIM_POS - MHDC_TIM_POS;
-        if (rep) {
+        tim_val += hdrToTx(pos) - hdrToData();
+        /* offered relay asks every period till granted */
+        const uint8_t ask = relayOn && !relaying && !viaRelay;
+        if ((rep || ask) && !missed) {
             EXT_DLOG("SLAVE: tx slot");
-            memcpy(buf, &sdf, pkt_len); /* get rid of this shit */
-            waitTIM();
-            GOD_Tx(buf, pkt_len);
+            if (!COM_CMD_CHECK(sdf.flags, msf_cmd)) {
+                COM_CMD_SET(sdf.flags, ask ? cmd_rly : (pllLock == PLL_LOCK_CNT) ? cmd_lck : cmd_nop);
+            }
+            napTIM();
+            GOD_TxLoad(&sdf, DF_PKT_SIZE(sdf.df), NULL, 0);
+            waitTIMTx();
+            /* acked fragment goes again only to carry the ack of master data */
+            if (!(ARR_BIT_CHECK(mh.ack, pos) ^ !!(sdf.flags & msf_sn))) {
+                fragSent(&fragA);
+            }
+        }
+        /* second channel repeats till acked */
+        if (!missed && wndTry == WND_ON && ARR_BIT_CHECK(mack.ack, pos) == !!(sdfw.flags & msf_sn)) {
+            EXT_DLOG("SLAVE: tx second slot");
+            GOD_TxLoad(&sdfw, DF_PKT_SIZE(sdfw.df), NULL, 0);
+            tim_val += 1;
+            waitTIMTx();
+            tim_val -= 1;
+            fragSent(&fragB);
         }
 
-        setNextFreq(1);
+        if (relaying && !missed) {
+            setSync((const uint8_t *) &rSyncDW);
+            rlyListen(&mh, &ri, rlyData, pos + 1U, mh.frames - RLY_FRAMES, FRAME_TO_SLOTS(pos + MCD_COUNT));
+            rlyRegion((const uint8_t *) &rSyncDW, (uint8_t *) arg, &mh, &mdf, rlyData, ri.ann,
+                      FRAME_TO_SLOTS(pos + MCD_COUNT));
+        }
+        if (!viaRelay) {
+            setNextFreq(1);
+        }
 
         /* rx slot */
-        tim_val += FRAME_TO_SLOTS(GOD_MAX_CONN - pos) + MHDC_TIM_POS;
-        if ((waitTIM()), RFM_Rx((uint8_t *) &mh, &pkt_len, PKT_OFFSET(1)) != RFM_OK) {
-            continue;
+        /* header is the first packet on the new frequency, so after a miss listen a frame around of the expected */
+        tim_val += txToHdr(pos) - (missed ? FRAME_TO_SLOTS(1) : 0);
+        napTIM();
+        if ((waitTIM()), GOD_Rx(buf, &len, PKT_OFFSET(missed ? 3 : 1)) != RFM_OK ||
+                             !COM_HDR_CHECK(((mheader_t *) buf)->flags)) {
+            ++stat->lost;
+            if (++missed < SPDS_TO_RESYN) {
+                continue;
+            }
+            /* period length could be changed in missed headers */
+            EXT_DLOG("SLAVE: lost master");
+            len = findHeader(buf);
+        } else if (!missed) {
+            /* slots passed since the expected header slot are negative tim_val */
+            trimDrift((int32_t) __HAL_TIM_GET_COUNTER(&GOD_TIM) - (int32_t) tim_val * slotTim -
+                          (int32_t) PKT_SYNC_TIM(len),
+                      FRAME_TO_SLOTS(frames + MCD_COUNT));
+        }
+        memcpy(&mh, buf, (len < sizeof(mh)) ? len : sizeof(mh));
+        /* relay info trails the header of master */
+        if (!viaRelay && len >= HDR_SIZE(mh.frames) + RLY_INFO_SIZE(mh.frames)) {
+            memcpy(&ri, buf + HDR_SIZE(mh.frames), RLY_INFO_SIZE(mh.frames));
+        } else {
+            ri.relay = RLY_NONE;
+        }
+        if (relayOn && relaying != (ri.relay == pos)) {
+            LOG_INFO("SLAVE: relay %s", relaying ? "released" : "granted");
         }
+        relaying = relayOn && ri.relay == pos;
+        missed = 0;
+        ++stat->rx;
+        sampleRssi(stat, hdrs++);
 
         EXT_DLOG("SLAVE: got master header");
 
+        /* every header re-syncs slot timing and period length */
+        syncHeader(&mh, len);
+        setFrames(&mh, pos);
+
+        /* acks of the second channel, missed ones keep it repeating */
+        if (GOD_WND_SIZE > 1 && wndTry) {
+            tim_val += 1;
+            if ((waitTIM()), GOD_Rx(buf, &len, PKT_SLOT_OFFSET) == RFM_OK && COM_WND_CHECK(buf[0])) {
+                memcpy(&mack, buf, (len < sizeof(mack)) ? len : sizeof(mack));
+                wndTry = WND_ON;
+            } else if (wndTry != WND_ON && !--wndTry) {
+                LOG_INFO("SLAVE: master runs single bit ARQ");
+            }
+            tim_val -= 1;
+        }
+
         /* process commands */
         switch (mh.flags & msf_cmd) {
             case cmd_syn:
                 EXT_DLOG("SLAVE: cmd_syn work out");
-                HAL_TIM_GenerateEvent(&GOD_TIM, TIM_EVENTSOURCE_UPDATE);
-                __HAL_TIM_SET_COUNTER(&GOD_TIM, PKT_TIM_LEN + TX_OFFSET);
-                tim_val = 0; /* some another value that will be passed in master header? */
                 /* mb add some response */
                 break;
             default:
@@ -777,54 +2288,60 @@ god_stat_t GOD_Announce(uint32_t time, uint8_t *text) {
         return GOD_ERROR;
     }
     if (text != NULL) {
-        memcpy(bufAnn, text, PKT_SIZE - SYNC_WORD_LEN - 1);
+        memcpy(bufAnn, text, ANN_TEXT_SIZE);
     } else {
         bufAnn[0] = 0;
     }
-    statFlags = ((time / PKT_OFFSET(PERIOD)) + 1) & STAT_CONNECT;
+    annEnd = tx_time_get() + time;
+    statFlags |= STAT_CONNECT;
     return GOD_OK;
 }
 
 uint8_t *GOD_Scan(uint32_t time) {
     uint8_t  tmp, cnt = 0;
-    uint8_t  buf[PKT_SIZE];
+    uint8_t  buf[PKT_MAX_SIZE];
     uint32_t tim_cnt;
-    memcpy(buf, dSyncWord, SYNC_WORD_LEN);
-    RFM_SetSyncWord(buf, SYNC_WORD_LEN);
+    uint8_t  i;
+    rfm->config_begin();
+    setSync(dSyncWord);
+    tune(freqI = FREQ_HOME);
+    rfm->config_commit();
     if (bufAnn == NULL) {
         bufAnn = (uint8_t *) malloc(BUF_ANN_SIZE);
     }
     bufAnn[0] = 0;
     LOG_INFO("[SCAN] Start");
     time += tim_cnt = tx_time_get();
-    while (tim_cnt < time) {
-        if (RFM_Rx(buf, &tmp, time - tim_cnt) == RFM_OK) {
-            if (bufAnn == NULL) {
-                break;
-            }
-            for (uint8_t i = 0; i < cnt; ++i) {
-                if (memcmp(buf, (bufAnn + 1) + (i * PKT_SIZE), PKT_SIZE) == 0) {
-                    tmp = 0;
-                    break;
-                }
-            }
-            if (tmp != 0) {
-                LOG_INFO("[SCAN] [%d] [%08x] %d %d msg: \"%s\" \n", cnt, *(uint32_t *) buf, *(uint8_t *) (buf + 4),
-                         *(uint16_t *) (buf + 5), buf + 7);
-                memcpy((bufAnn + 1) + (cnt * PKT_SIZE), buf, PKT_SIZE);
-                bufAnn[0] = ++cnt;
+    while (tim_cnt < time && GOD_Rx(buf, &tmp, time - tim_cnt) == RFM_OK && bufAnn != NULL) {
+        tim_cnt = tx_time_get();
+        if (tmp != ANN_SIZE || buf[SYNC_WORD_LEN + 3] > MAX_DATA_SIZE) {
+            continue; /* not an announcement or fragments do not fit our radio */
+        }
+        /* master announces every period, the last one tells its current channel and phase */
+        for (i = 0; i < cnt && memcmp(buf, (bufAnn + 1) + (i * ANN_SIZE), SYNC_WORD_LEN); ++i) {
+        }
+        if (i == cnt) {
+            if (cnt == ANN_MAX) {
+                continue;
             }
-        } else {
-            break;
+            LOG_INFO("[SCAN] [%d] [%08x] %d %d %d msg: \"%.*s\" \n", cnt, *(uint32_t *) buf, *(uint8_t *) (buf + 4),
+                     *(uint16_t *) (buf + 5), *(uint8_t *) (buf + 7), ANN_TEXT_SIZE, buf + ANN_TEXT_OFFSET);
+            bufAnn[0] = ++cnt;
         }
-        tim_cnt = tx_time_get();
+        memcpy((bufAnn + 1) + (i * ANN_SIZE), buf, ANN_SIZE);
+        annTime[i] = tim_cnt;
     }
     LOG_INFO("[SCAN] End");
     return bufAnn;
 }
 
-god_stat_t GOD_Init() {
-    /* assert for mheader_t (or any other one) > PKT_SIZE */
+god_stat_t GOD_Init(const rfm_ops_t *ops) {
+    /* assert for mheader_t (or any other one) > PKT_MAX_SIZE */
+
+    if (ops == NULL) {
+        return GOD_ERROR;
+    }
+    rfm = ops;
 
     if (tx_mutex_create(&muxBufTx, NULL, TX_INHERIT) != TX_SUCCESS ||
         tx_mutex_create(&muxReadMBC, NULL, TX_INHERIT) != TX_SUCCESS ||
@@ -833,14 +2350,22 @@ god_stat_t GOD_Init() {
         initRFM() != RFM_OK) {
         return GOD_ERROR;
     }
+    if (GOD_TIM.Init.Prescaler + 1U != GOD_TIM_PSC) {
+        LOG_ERROR("GOD_TIM prescaler differs from timing profile");
+        return GOD_ERROR;
+    }
 
     for (uint8_t i = 0; i < MAX_CONN_FGC; ++i) {
         if (tx_event_flags_create(&god_ef_mux[i], NULL) != TX_SUCCESS ||
             ((tx_event_flags_set(&god_ef_mux[i], TX_WAIT_FOREVER, TX_OR)),
-             (tx_event_flags_create(&god_ef_ntfy[i], NULL) != TX_SUCCESS))) {
+             (tx_event_flags_create(&god_ef_ntfy[i], NULL) != TX_SUCCESS) ||
+             (tx_event_flags_create(&god_ef_msg[i], NULL) != TX_SUCCESS))) {
             return GOD_ERROR;
         }
     }
+    if (tx_event_flags_create(&god_ef_msgAny, NULL) != TX_SUCCESS) {
+        return GOD_ERROR;
+    }
 
 #if 0
     tx_byte_pool_create(&pool, NULL, pool_buf, BYTE_POLL_SIZE);
@@ -853,18 +2378,45 @@ god_stat_t GOD_Init() {
     PARSER_AddCommand(god_scan, "rfm scan -t 0");
     PARSER_AddCommand(god_ann, "rfm ann -t 0 -m \"\"");
 #endif    // 0
+    PARSER_AddCommand(god_stats, "rfm stats");
+    PARSER_AddCommand(god_link, "rfm link -s 0");
 
     statFlags &= ~STAT_DEINITED;
 
     return GOD_OK; /* normal return value? */
 }
 
+god_stat_t GOD_SetProfile(god_profile_t prof) {
+    rfm_stat_t stat = RFM_OK;
+
+    if ((statFlags & (STAT_DEINITED | STAT_STARTED)) || prof >= countof(profiles)) {
+        return GOD_ERROR;
+    }
+    profile = &profiles[prof];
+    stat |= rfm->set_rate(profile->baud_rate, profile->deviation,
+                          (prof == GOD_PROFILE_FAST) ? BANDWIDTH_FAST : BANDWIDTH);
+    LOG_INFO("profile %d: %d baud, guard %d", prof, (int) profile->baud_rate, profile->guard);
+
+    return (stat == RFM_OK) ? GOD_OK : GOD_ERROR;
+}
+
 god_stat_t GOD_Start(god_node_t nt, void *args) {
 
     if (statFlags & STAT_DEINITED) {
         return GOD_ERROR;
     }
+    statFlags |= STAT_STARTED;
 
+    /* slave learns packing of the cell from the announcement it connects to */
+    packCell = (nt == GOD_NODE_MASTER) ? GOD_COMPRESS : !!(ANN_HDR_SLOTS((uint8_t *) args) & ANN_PACK);
+    packTx = GOD_COMPRESS && packCell;
+
+    if (nt == GOD_NODE_MASTER) {
+        /* scan results are replaced by the announcement text */
+        hopMask = pickHop(bufAnn);
+        free(bufAnn);
+        bufAnn = NULL;
+    }
     createArr(nt);
     EXT_DLOG("Created buffers");
 
@@ -882,38 +2434,42 @@ god_stat_t GOD_Start(god_node_t nt, void *args) {
     return GOD_OK;
 }
 
+god_stat_t GOD_Relay(void) {
+    if (!(statFlags & STAT_STARTED) || node == GOD_NODE_MASTER || viaRelay) {
+        return GOD_ERROR;
+    }
+    relayOn = 1;
+    return GOD_OK;
+}
+
 god_stat_t GOD_Write(uint8_t *data, uint16_t size) {
-    uint16_t tmp;
+    TX_INTERRUPT_SAVE_AREA
     if (size < 1) {
         return GOD_ERROR;
     }
     tx_mutex_get(&muxBufTx, TX_WAIT_FOREVER);
-    do {
-        if (bufTx->full) {
-            tx_semaphore_get(&semBufTx, TX_WAIT_FOREVER);
-        }
-        tmp = (size < bufFEndS(bufTx, BUF_TX_SIZE) ? size : bufFEndS(bufTx, BUF_TX_SIZE));
-        memcpy(bufTx->buf + bufTx->head, data, tmp);
-        bufTx->head += tmp;
-        data += tmp;
-        size -= tmp;
-        if (bufTx->head == BUF_TX_SIZE) {
-            bufTx->head = 0;
-        }
-        if (bufTx->head == bufTx->tail) {
-            bufTx->full = 1;
-        }
-    } while (size);
+    /* mark is in the ring before its bytes are in buffer */
+    if ((uint8_t) (bufTx->markW - bufTx->markR) < TX_MARK_CNT) {
+        TX_DISABLE
+        bufTx->mark[bufTx->markW % TX_MARK_CNT].pos = bufTx->wrPos;
+        bufTx->mark[bufTx->markW % TX_MARK_CNT].time = tx_time_get();
+        bufTx->markW++;
+        TX_RESTORE
+    }
+    txStat.bytes += size;
+    if (packTx) {
+        packWrite(data, size);
+    } else {
+        putTx(data, size);
+    }
     tx_mutex_put(&muxBufTx);
     return GOD_OK;
 }
 
-#define bufUsedSF(_p, _size) (_p->full ? _size : bufUsedS(_p, _size))
-
 /* !tocheck whether it actual !bug For some reason if thread that called this API have higher priority than taskGEODE it
  * works unpredictable (can't read if there is few data) */
 god_stat_t GOD_Read(uint8_t slot, uint8_t *data, uint16_t size, god_mode_t mode) {
-    uint32_t flags;
+    ULONG    flags;
     uint8_t  status = GOD_OK;
     uint8_t  tmp = slot;
 
@@ -923,15 +2479,15 @@ god_stat_t GOD_Read(uint8_t slot, uint8_t *data, uint16_t size, god_mode_t mode)
         // look for enough data
         if (slot == GOD_MBC) {
             tmp = 0;
-            while (tmp < node && (!ARR_EVENT_FLAG_LOOKUP(god_ef_mux, tmp) || arrRx[tmp]->buf == NULL ||
-                                  bufUsedSF(arrRx[tmp]->buf, BUF_RX_SIZE) < size)) {
+            while (tmp < node && (!ARR_EVENT_FLAG_LOOKUP(god_ef_mux, tmp) || arrRx[tmp].buf == NULL ||
+                                  arrRx[tmp].buf->used < size)) {
                 ++tmp;
             }
             if (tmp == node) {
                 return GOD_BUF_EMPTY;
             }
         } else {
-            if (!ARR_EVENT_FLAG_LOOKUP(god_ef_mux, slot) || bufUsedSF(arrRx[slot]->buf, BUF_RX_SIZE) < size) {
+            if (!ARR_EVENT_FLAG_LOOKUP(god_ef_mux, slot) || arrRx[slot].buf->used < size) {
                 return GOD_BUF_EMPTY;
             }
         }
@@ -952,7 +2508,7 @@ god_stat_t GOD_Read(uint8_t slot, uint8_t *data, uint16_t size, god_mode_t mode)
     /* take logic */
     if (tmp == GOD_MBC) {
         tmp = 0;
-        while (tmp < node && (arrRx[tmp]->buf == NULL || bufUsedSF(arrRx[tmp]->buf, BUF_RX_SIZE) < size)) {
+        while (tmp < node && (arrRx[tmp].buf == NULL || arrRx[tmp].buf->used < size)) {
             ++tmp;
         }
     }
@@ -961,37 +2517,19 @@ god_stat_t GOD_Read(uint8_t slot, uint8_t *data, uint16_t size, god_mode_t mode)
             tx_semaphore_get(&semReadMBC, TX_WAIT_FOREVER);
             status = tmp = semReadMBC.tx_semaphore_count;
             semReadMBC.tx_semaphore_count = 0;
-        } while (bufUsedSF(arrRx[tmp]->buf, BUF_RX_SIZE) < size);
+        } while (arrRx[tmp].buf->used < size);
     }
 
     do {
 
-        if (arrRx[tmp]->buf == NULL || (!arrRx[tmp]->buf->full && arrRx[tmp]->buf->head == arrRx[tmp]->buf->tail)) {
+        if (arrRx[tmp].buf == NULL || !arrRx[tmp].buf->used) {
             ARR_EVENT_FLAG_GET(god_ef_ntfy, tmp, TX_OR_CLEAR, &flags, TX_WAIT_FOREVER);
         }
 
-        uint16_t len =
-            ((arrRx[tmp]->buf->full) ?
-                 ((size < BUF_RX_SIZE) ? (size) : (BUF_RX_SIZE)) :
-                 ((size < bufUsedS(arrRx[tmp]->buf, BUF_RX_SIZE)) ? size : bufUsedS(arrRx[tmp]->buf, BUF_RX_SIZE)));
-
-        do {
-            uint16_t write_len =
-                ((arrRx[tmp]->buf->full) ?
-                     ((len < (BUF_RX_SIZE - arrRx[tmp]->buf->tail)) ? (len) : (BUF_RX_SIZE - arrRx[tmp]->buf->tail)) :
-                     ((len < bufUEndS(arrRx[tmp]->buf, BUF_RX_SIZE)) ? len : bufUEndS(arrRx[tmp]->buf, BUF_RX_SIZE)));
-            memcpy(data, arrRx[tmp]->buf->data + arrRx[tmp]->buf->tail, write_len);
-            arrRx[tmp]->buf->tail += write_len;
-            data += write_len;
-            size -= write_len;
-            len -= write_len;
-            if (arrRx[tmp]->buf->tail == BUF_RX_SIZE) {
-                arrRx[tmp]->buf->tail = 0;
-            }
-            if ((arrRx[tmp]->buf->tail != arrRx[tmp]->buf->head) && arrRx[tmp]->buf->full) {
-                arrRx[tmp]->buf->full = 0;
-            }
-        } while (len); /* done at max 2 times */
+        uint16_t len = (size < arrRx[tmp].buf->used) ? size : arrRx[tmp].buf->used;
+        takeRx(tmp, data, len);
+        data += len;
+        size -= len;
 
     } while (size);
 
@@ -1021,9 +2559,155 @@ god_stat_t GOD_Printf(char *data, ...) {
     return stat;
 }
 
+god_stat_t GOD_SendMsg(uint8_t *data, uint16_t size) {
+    uint8_t    hdr[MSG_HDR_SIZE] = { size & 0xFFU, size >> 8 };
+    god_stat_t stat = GOD_ERROR;
+    if (size < 1 || size > GOD_MSG_MAX_SIZE) {
+        return GOD_ERROR;
+    }
+    /* length and message in row */
+    tx_mutex_get(&muxBufTx, TX_WAIT_FOREVER);
+    if (GOD_Write(hdr, MSG_HDR_SIZE) == GOD_OK) {
+        stat = GOD_Write(data, size);
+    }
+    tx_mutex_put(&muxBufTx);
+    return stat;
+}
+
+god_stat_t GOD_MemUsage(god_mem_t *mem) {
+    TX_INTERRUPT_SAVE_AREA
+
+    if (arrRx == NULL || mem == NULL) {
+        return GOD_ERROR;
+    }
+    TX_DISABLE
+    mem->blk_size = RX_BLK_DATA;
+    mem->blks = rxPool.tx_block_pool_total;
+    mem->used = rxPool.tx_block_pool_total - rxPool.tx_block_pool_available;
+    mem->peak = rxPeak;
+    mem->slots = slotPool.tx_block_pool_total - slotPool.tx_block_pool_available;
+    TX_RESTORE
+    return GOD_OK;
+}
+
+god_stat_t GOD_GetLinkStat(uint8_t slot, god_link_stat_t *stat) {
+    if (arrRx == NULL || slot >= node || arrRx[slot].buf == NULL || stat == NULL) {
+        return GOD_ERROR;
+    }
+    memcpy(stat, &arrRx[slot].buf->stat, sizeof(*stat));
+    return GOD_OK;
+}
+
+god_stat_t GOD_GetTxStat(god_tx_stat_t *stat) {
+    if (arrRx == NULL || stat == NULL) {
+        return GOD_ERROR;
+    }
+    memcpy(stat, &txStat, sizeof(*stat));
+    return GOD_OK;
+}
+
+god_stat_t GOD_GetRadioStat(god_radio_stat_t *stat) {
+    static const uint16_t ua[PWR_CNT] = { RFM_UA_IDLE, RFM_UA_RX, RFM_UA_TX, RFM_UA_SLEEP };
+    uint64_t              t[PWR_CNT], all = 0, charge = 0;
+    TX_INTERRUPT_SAVE_AREA
+
+    if (arrRx == NULL || stat == NULL) {
+        return GOD_ERROR;
+    }
+    /* the current state counts till now */
+    TX_DISABLE
+    pwrMark(pwrCur);
+    memcpy(t, pwrTime, sizeof(t));
+    TX_RESTORE
+    for (uint8_t i = 0; i < PWR_CNT; ++i) {
+        all += t[i];
+        charge += t[i] * ua[i];
+    }
+    stat->rx_us = t[PWR_RX] * 1000000U / TIM_FREQ;
+    stat->tx_us = t[PWR_TX] * 1000000U / TIM_FREQ;
+    stat->idle_us = t[PWR_IDLE] * 1000000U / TIM_FREQ;
+    stat->sleep_us = t[PWR_SLEEP] * 1000000U / TIM_FREQ;
+    stat->current_ua = all ? (uint32_t) (charge / all) : 0;
+    return GOD_OK;
+}
+
+#define MSG_PENDING(_n) \
+    (arrRx[_n].buf != NULL && (uint16_t) (arrRx[_n].buf->msgDone - arrRx[_n].buf->msgTaken))
+
+god_stat_t GOD_RecvMsg(uint8_t slot, uint8_t *data, uint16_t size, uint16_t *len, god_mode_t mode) {
+    ULONG    flags;
+    uint8_t  hdr[MSG_HDR_SIZE];
+    uint16_t msgLen;
+    uint8_t  tmp = slot;
+
+    if (slot != GOD_MBC && (slot >= node || arrRx == NULL)) {
+        return GOD_ERROR;
+    }
+
+    /* take the slot with a message. the slot lock is the same one GOD_Read() uses, other slots are not waited */
+    if (slot == GOD_MBC) {
+        while (1) {
+            for (tmp = 0; tmp < node; ++tmp) {
+                if (MSG_PENDING(tmp) &&
+                    ARR_EVENT_FLAG_GET(god_ef_mux, tmp, TX_OR_CLEAR, &flags, TX_NO_WAIT) == TX_SUCCESS) {
+                    if (MSG_PENDING(tmp)) {
+                        break;
+                    }
+                    ARR_EVENT_FLAG_SET(god_ef_mux, tmp, TX_OR);
+                }
+            }
+            if (tmp < node) {
+                break;
+            }
+            if (mode == GOD_NON_BLOCK) {
+                return GOD_BUF_EMPTY;
+            }
+            /* set since the last look means there is something new */
+            tx_event_flags_get(&god_ef_msgAny, TX_WAIT_FOREVER, TX_OR_CLEAR, &flags, TX_WAIT_FOREVER);
+        }
+    } else {
+        if (ARR_EVENT_FLAG_GET(god_ef_mux, slot, TX_OR_CLEAR, &flags,
+                               (mode == GOD_BLOCK) ? TX_WAIT_FOREVER : TX_NO_WAIT) != TX_SUCCESS) {
+            return GOD_BUF_EMPTY;
+        }
+        while (!MSG_PENDING(slot)) {
+            if (mode == GOD_NON_BLOCK) {
+                ARR_EVENT_FLAG_SET(god_ef_mux, slot, TX_OR);
+                return GOD_BUF_EMPTY;
+            }
+            ARR_EVENT_FLAG_GET(god_ef_msg, slot, TX_OR_CLEAR, &flags, TX_WAIT_FOREVER);
+        }
+    }
+
+    /* whole message is in buffer, rest of a longer one is dropped */
+    takeRx(tmp, hdr, MSG_HDR_SIZE);
+    msgLen = hdr[0] | (uint16_t) hdr[1] << 8;
+    takeRx(tmp, data, (size < msgLen) ? size : msgLen);
+    takeRx(tmp, NULL, (size < msgLen) ? (msgLen - size) : 0);
+    ++arrRx[tmp].buf->msgTaken;
+    ARR_EVENT_FLAG_SET(god_ef_mux, tmp, TX_OR);
+
+    if (len != NULL) {
+        *len = msgLen;
+    }
+    return (slot == GOD_MBC) ? tmp : GOD_OK;
+}
+
 void GOD_TIM_Callback(TIM_HandleTypeDef *htim) {
     if (htim == &GOD_TIM) {
+        /* trimmed slot of the drift PLL, preload is off so it is this slot */
+        pllAcc += pllTrim;
+        timTicks += __HAL_TIM_GET_AUTORELOAD(&GOD_TIM) + 1U;
+        TIM_SET_AUTORELOAD(&GOD_TIM, slotTim + (pllAcc >> PLL_FRAC_SHIFT));
+        pllAcc &= (1U << PLL_FRAC_SHIFT) - 1U;
         if (!--tim_val) {
+            if (txArmed) {
+                txArmed = 0;
+                if (rfm->tx_async(txDone) == RFM_OK) {
+                    pwrMark(PWR_TX);
+                    return;
+                }
+            }
             tx_semaphore_put(&semTIM);
         }
     }
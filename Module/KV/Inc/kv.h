@@ -0,0 +1,157 @@
+/**
+ * @file kv.h
+ * @brief Key-value store on the external flash.
+ *        This file provides functions to manage the following
+ *        functionalities of the store:
+ *            + Mounting of the region of the flash
+ *            + Put, get and delete of values by key
+ *            + Counters of the store
+ *        ### How the store works ###
+ *     Values go as records appended to a log in KV_SECTORS sectors from KV_ADDR, so an update costs programming of
+ *     the pages it takes, not erase and rewrite of a sector:
+ *     + Every record carries its key, length and CRC, a delete appends a record without value
+ *     + KV_Init() reads headers of sectors and records and builds a RAM index of the current record of every key,
+ *       so values are found without reading the flash
+ *     + Sectors of superseded records are compacted by a background thread: current records are copied to the log
+ *       head and the sector is erased. A put compacts itself only when the last free sector would be taken
+ *     + Free sectors are taken by the least erases. Sectors of data that is not updated are moved once erase counts
+ *       spread more than KV_WEAR_GAP, so they get erased as well
+ *     + Power loss can tear only the last record of a sector, it is dropped at mount
+ *        ### How to use the store ###
+ *     + Initialize flash by FLASH_Init() and then the store by KV_Init()
+ *     + Keys are numbers from 0 to KV_KEYS_MAX-1 assigned by users
+ *     + KV_Put(), KV_Get() and KV_Delete() are thread safe and block for the flash
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ *  (c) 2026
+ */
+
+#ifndef KV_H
+#define KV_H
+
+#include <stdint.h>
+#include "flash.h"
+
+/* region of the store, sector aligned. blocks 62-63 are kept by the weather app */
+#ifndef KV_ADDR
+#define KV_ADDR (0x300000U)
+#endif    // KV_ADDR
+
+#ifndef KV_SECTORS
+#define KV_SECTORS (32U)
+#endif    // KV_SECTORS
+
+/* keys are indexes of the RAM index, 8 bytes of RAM each */
+#ifndef KV_KEYS_MAX
+#define KV_KEYS_MAX (64U)
+#endif    // KV_KEYS_MAX
+
+/* largest value, a record has to fit a sector */
+#ifndef KV_VALUE_MAX
+#define KV_VALUE_MAX (1024U)
+#endif    // KV_VALUE_MAX
+
+/* background compaction keeps at least as many sectors free */
+#ifndef KV_GC_FREE
+#define KV_GC_FREE (KV_SECTORS / 4U)
+#endif    // KV_GC_FREE
+
+/* erase counts of sectors may spread as much before data that is not updated is moved */
+#ifndef KV_WEAR_GAP
+#define KV_WEAR_GAP (16U)
+#endif    // KV_WEAR_GAP
+
+/* of the compaction thread */
+#ifndef KV_PRIORITY
+#define KV_PRIORITY (14U)
+#endif    // KV_PRIORITY
+
+#if (KV_ADDR % (IS25L_MEMORY_SECTOR_SIZE * 1024U)) || (KV_ADDR + KV_SECTORS * IS25L_MEMORY_SECTOR_SIZE * 1024U > IS25L_EDGE + 1U)
+#error "KV region out of flash or not sector aligned"
+#endif
+#if (KV_SECTORS < 3U) || (KV_SECTORS > 255U) || (KV_GC_FREE >= KV_SECTORS)
+#error "KV_SECTORS: the log head, a free sector for compaction and one of data at least"
+#endif
+#if (KV_KEYS_MAX > 0x7FFFU) || (KV_VALUE_MAX > IS25L_MEMORY_SECTOR_SIZE * 1024U - 64U)
+#error "KV_KEYS_MAX or KV_VALUE_MAX out of range"
+#endif
+
+typedef enum {
+    KV_OK,
+    KV_PARAM_ERR, /* key or size out of range */
+    KV_NOT_FOUND,
+    KV_FULL,      /* no garbage left to compact */
+    KV_CRC_ERR,   /* record is corrupted */
+    KV_FLASH_ERR,
+    KV_TX_ERR
+} kv_state_t;
+
+/**
+ * @brief counters since KV_Init(). programmed / bytes is the write amplification of the store
+ *
+ */
+typedef struct {
+    uint32_t puts;        /* deletes included */
+    uint32_t bytes;       /* of values put */
+    uint32_t programmed;  /* to the flash: records, copies and sector headers */
+    uint32_t copied;      /* records moved by compaction */
+    uint32_t erases;
+    uint32_t compactions;
+    uint32_t background;  /* compactions done by the thread */
+    uint32_t wear;        /* compactions to move data that is not updated */
+    uint32_t mount_ticks; /* KV_Init() */
+    uint16_t keys;        /* present now */
+    uint8_t  free;        /* sectors now */
+    uint32_t erases_min;  /* erase counts of sectors now */
+    uint32_t erases_max;
+} kv_stats_t;
+
+/**
+ * @brief Function for mounting the store, formats sectors without one
+ * @note flash is initialized before
+ * @return Status
+ */
+kv_state_t KV_Init(void);
+
+/**
+ * @brief Function for stopping the store, KV_Init() mounts it again
+ * @return Status
+ */
+kv_state_t KV_Deinit(void);
+
+/**
+ * @brief Function for writing value of a key
+ * @param key Key from 0 to KV_KEYS_MAX-1
+ * @param data Value
+ * @param size Value size, up to KV_VALUE_MAX, 0 is a value too
+ * @return Status, KV_FULL if current values take the whole region
+ */
+kv_state_t KV_Put(uint16_t key, const void *data, uint16_t size);
+
+/**
+ * @brief Function for reading value of a key
+ * @param key Key from 0 to KV_KEYS_MAX-1
+ * @param data Array for the value
+ * @param size Array size, the rest of a longer value is dropped
+ * @param len Size of the value (can be NULL)
+ * @return Status, KV_NOT_FOUND if the key has no value
+ */
+kv_state_t KV_Get(uint16_t key, void *data, uint16_t size, uint16_t *len);
+
+/**
+ * @brief Function for deleting value of a key
+ * @param key Key from 0 to KV_KEYS_MAX-1
+ * @return Status, KV_NOT_FOUND if the key has no value
+ */
+kv_state_t KV_Delete(uint16_t key);
+
+/**
+ * @brief Function for getting counters of the store
+ * @param stats Counters
+ * @return Status, KV_TX_ERR if the store is not mounted
+ */
+kv_state_t KV_GetStats(kv_stats_t *stats);
+
+#endif    // KV_H
@@ -0,0 +1,659 @@
+/**
+ * @file kv.c
+ * @brief Key-value store on the external flash
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ *  (c) 2026
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "main.h"
+#include "kv.h"
+#define LOG_DEFAULT_MODULE LOG_M_KV
+#include "loglib.h"
+
+/* NOTE: layout
+ * sector: kvSect_t, then records up to the first blank header
+ *     + erase count is written right after the erase, the sector is free while seq is blank
+ *     + seq is written when the sector becomes the log head, records of higher seq are newer
+ *     + both are stored with their inversion, so a torn write is not taken for a value
+ * record: kvRec_t, then len bytes of value. CRC covers key, len and the value
+ *     + a tombstone (REC_DEL) hides older records of its key, it is dropped once no older sector is left
+ *     + records go to the flash in one write, so only the last one of a sector can be torn. mount checks CRC of
+ *       the last records only, others are checked when they are read
+ */
+#define KV_MAGIC  (0x3153564BU) /* "KVS1" */
+#define SECT_SIZE (IS25L_MEMORY_SECTOR_SIZE * 1024U)
+#define SECT_DATA (SECT_SIZE - sizeof(kvSect_t))
+#define SECT_NONE (0xFFU)
+#define ADDR_NONE (0xFFFFFFFFU)
+#define KEY_BLANK (0xFFFFU)
+#define REC_DEL   (0x8000U) /* len flag of a tombstone */
+#define REC_SIZE(_len) ((uint16_t) (sizeof(kvRec_t) + ((_len) & ~REC_DEL)))
+
+/* free sectors a put leaves to compaction, it copies a sector at most */
+#define RESERVE (1U)
+/* garbage of a sector worth background compaction */
+#define GC_MIN (SECT_DATA / 4U)
+
+/* mount reads a sector of small records in a few reads instead of one per record */
+#define SCAN_CHUNK ((sizeof(recBuf) < IS25L_MEMORY_PAGE_SIZE) ? sizeof(recBuf) : IS25L_MEMORY_PAGE_SIZE)
+
+#define STACK_SIZE (1024U)
+#define FLAG_GC    (1U)
+
+typedef struct {
+    uint32_t magic;
+    uint32_t erases;
+    uint32_t erases_inv;
+    uint32_t seq;
+    uint32_t seq_inv;
+} kvSect_t;
+
+typedef struct {
+    uint16_t key;
+    uint16_t len;
+    uint32_t crc;
+} kvRec_t;
+
+/* sector as known in RAM */
+typedef struct {
+    uint32_t seq; /* 0 while free */
+    uint32_t erases;
+    uint16_t used; /* write offset of the head */
+    uint16_t live; /* bytes of current records */
+    uint8_t  fmt;   /* erase count is written */
+    uint8_t  blank; /* known to be erased past the header */
+} sect_t;
+
+/* current record of a key */
+typedef struct {
+    uint32_t addr;
+    uint16_t len;
+} entry_t;
+
+static TX_MUTEX             muxKV;
+static TX_EVENT_FLAGS_GROUP efKV;
+static TX_THREAD            taskKV;
+static ULONG                stackKV[STACK_SIZE / sizeof(ULONG)];
+static uint8_t              mounted;
+
+static sect_t     sect[KV_SECTORS];
+static entry_t    table[KV_KEYS_MAX];
+static uint8_t    head;
+static uint8_t    freeCnt;
+static uint32_t   seqTop;
+static kv_stats_t stats;
+
+/* record being written or read, so values do not take stacks of callers */
+static uint32_t recBuf[(sizeof(kvRec_t) + KV_VALUE_MAX + sizeof(uint32_t) - 1U) / sizeof(uint32_t)];
+#define REC ((kvRec_t *) recBuf)
+
+/* CRC-32 (IEEE) by nibbles */
+static uint32_t crc32(uint32_t crc, const uint8_t *data, uint32_t size) {
+    static const uint32_t tbl[16] = { 0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4,
+                                      0x4DB26158, 0x5005713C, 0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+                                      0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C };
+
+    crc = ~crc;
+    while (size--) {
+        crc = tbl[(crc ^ *data) & 0x0FU] ^ (crc >> 4);
+        crc = tbl[(crc ^ (*data++ >> 4)) & 0x0FU] ^ (crc >> 4);
+    }
+    return ~crc;
+}
+
+/* of the record in recBuf */
+static uint32_t recCrc(void) {
+    const uint8_t *rec = (const uint8_t *) recBuf;
+    return crc32(crc32(0, rec, offsetof(kvRec_t, crc)), rec + sizeof(kvRec_t), REC->len & ~REC_DEL);
+}
+
+static inline uint32_t sectAddr(uint8_t s) {
+    return KV_ADDR + s * SECT_SIZE;
+}
+
+static inline uint8_t addrSect(uint32_t addr) {
+    return (addr - KV_ADDR) / SECT_SIZE;
+}
+
+/* reclaimable by compaction, the head does not count */
+static inline uint16_t garbage(uint8_t s) {
+    return SECT_DATA - sect[s].live;
+}
+
+static uint8_t recValid(const kvRec_t *rec, uint16_t off) {
+    const uint16_t len = rec->len & ~REC_DEL;
+    return rec->key < KV_KEYS_MAX && len <= KV_VALUE_MAX && (!(rec->len & REC_DEL) || !len) &&
+           off + REC_SIZE(rec->len) <= SECT_SIZE;
+}
+
+/* the record at off of the sector becomes the current one of its key */
+static void apply(uint8_t s, uint16_t off, const kvRec_t *rec) {
+    entry_t *e = &table[rec->key];
+
+    if (e->addr != ADDR_NONE) {
+        sect[addrSect(e->addr)].live -= REC_SIZE(e->len);
+    }
+    e->addr = sectAddr(s) + off;
+    e->len = rec->len;
+    sect[s].live += REC_SIZE(rec->len);
+}
+
+static uint8_t isBlank(uint8_t s, uint16_t from) {
+    const uint8_t *buf = (const uint8_t *) recBuf;
+
+    for (uint32_t off = from; off < SECT_SIZE; off += sizeof(recBuf)) {
+        const uint16_t size = (SECT_SIZE - off < sizeof(recBuf)) ? SECT_SIZE - off : sizeof(recBuf);
+        if (FLASH_Read((uint8_t *) recBuf, sectAddr(s) + off, size) != FLASH_OK) {
+            return 0;
+        }
+        for (uint16_t i = 0; i < size; ++i) {
+            if (buf[i] != 0xFFU) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+static kv_state_t writeCount(uint8_t s) {
+    kvSect_t hdr = { .magic = KV_MAGIC, .erases = sect[s].erases, .erases_inv = ~sect[s].erases };
+
+    if (FLASH_Write((uint8_t *) &hdr, sectAddr(s), offsetof(kvSect_t, seq)) != FLASH_OK) {
+        return KV_FLASH_ERR;
+    }
+    stats.programmed += offsetof(kvSect_t, seq);
+    sect[s].fmt = 1;
+    return KV_OK;
+}
+
+/* the sector is free afterwards */
+static kv_state_t erase(uint8_t s) {
+    if (FLASH_EraseSector(sectAddr(s)) != FLASH_OK) {
+        return KV_FLASH_ERR;
+    }
+    ++stats.erases;
+    sect[s] = (sect_t) { .erases = sect[s].erases + 1U, .blank = 1 };
+    return writeCount(s);
+}
+
+/* takes the free sector of the least erases for the log head */
+static kv_state_t openHead(void) {
+    kvSect_t   hdr;
+    kv_state_t state = KV_OK;
+    uint8_t    s = SECT_NONE;
+
+    for (uint8_t i = 0; i < KV_SECTORS; ++i) {
+        if (!sect[i].seq && (s == SECT_NONE || sect[i].erases < sect[s].erases)) {
+            s = i;
+        }
+    }
+    if (s == SECT_NONE) {
+        return KV_FULL;
+    }
+    /* free ones found at mount may hold a torn erase or seq */
+    if (!sect[s].blank) {
+        sect[s].blank = isBlank(s, sect[s].fmt ? offsetof(kvSect_t, seq) : 0);
+    }
+    if (!sect[s].blank) {
+        state = erase(s);
+    } else if (!sect[s].fmt) {
+        state = writeCount(s);
+    }
+    if (state != KV_OK) {
+        return state;
+    }
+
+    hdr.seq = ++seqTop;
+    hdr.seq_inv = ~hdr.seq;
+    if (FLASH_Write((uint8_t *) &hdr.seq, sectAddr(s) + offsetof(kvSect_t, seq), 2U * sizeof(uint32_t)) != FLASH_OK) {
+        sect[s].blank = 0;
+        return KV_FLASH_ERR;
+    }
+    stats.programmed += 2U * sizeof(uint32_t);
+    sect[s].seq = hdr.seq;
+    sect[s].used = sizeof(kvSect_t);
+    sect[s].live = 0;
+    sect[s].blank = 0;
+    head = s;
+    --freeCnt;
+    /* the thread sees if it has work */
+    tx_event_flags_set(&efKV, FLAG_GC, TX_OR);
+    return KV_OK;
+}
+
+/* head has room for size bytes or a new one is opened */
+static kv_state_t headRoom(uint16_t size) {
+    if (head != SECT_NONE && sect[head].used + size <= SECT_SIZE) {
+        return KV_OK;
+    }
+    return openHead();
+}
+
+/* writes the record of recBuf to the head, room is made before */
+static kv_state_t append(void) {
+    const uint16_t size = REC_SIZE(REC->len);
+    const uint16_t off = sect[head].used;
+
+    /* taken even if the write fails, part of it may be programmed */
+    sect[head].used += size;
+    if (FLASH_Write((uint8_t *) recBuf, sectAddr(head) + off, size) != FLASH_OK) {
+        return KV_FLASH_ERR;
+    }
+    stats.programmed += size;
+    apply(head, off, REC);
+    return KV_OK;
+}
+
+/* moves current records of the sector to the head and erases it */
+static kv_state_t compact(uint8_t v) {
+    kvRec_t    rec;
+    kv_state_t state;
+    uint8_t    oldest = 1;
+
+    for (uint8_t i = 0; i < KV_SECTORS; ++i) {
+        if (sect[i].seq && sect[i].seq < sect[v].seq) {
+            oldest = 0;
+        }
+    }
+
+    for (uint16_t off = sizeof(kvSect_t); sect[v].live && off + sizeof(rec) <= SECT_SIZE; off += REC_SIZE(rec.len)) {
+        const uint32_t addr = sectAddr(v) + off;
+        entry_t       *e;
+
+        if (FLASH_Read((uint8_t *) &rec, addr, sizeof(rec)) != FLASH_OK) {
+            return KV_FLASH_ERR;
+        }
+        if (!recValid(&rec, off)) {
+            break;
+        }
+        e = &table[rec.key];
+        if (e->addr != addr) {
+            continue;
+        }
+        if ((rec.len & REC_DEL) && oldest) {
+            /* nothing older to hide */
+            sect[v].live -= sizeof(rec);
+            e->addr = ADDR_NONE;
+            continue;
+        }
+        if ((state = headRoom(REC_SIZE(rec.len))) != KV_OK) {
+            return state;
+        }
+        if (FLASH_Read((uint8_t *) recBuf, addr, REC_SIZE(rec.len)) != FLASH_OK) {
+            return KV_FLASH_ERR;
+        }
+        if (recCrc() != rec.crc) {
+            LOG_ERROR("value of key %u is corrupted, dropped", rec.key);
+            sect[v].live -= REC_SIZE(rec.len);
+            e->addr = ADDR_NONE;
+            continue;
+        }
+        if ((state = append()) != KV_OK) {
+            return state;
+        }
+        stats.copied += REC_SIZE(rec.len);
+    }
+
+    if ((state = erase(v)) != KV_OK) {
+        return state;
+    }
+    ++freeCnt;
+    ++stats.compactions;
+    return KV_OK;
+}
+
+/* sector of the most garbage but the head */
+static uint8_t dirtiest(void) {
+    uint8_t v = SECT_NONE;
+
+    for (uint8_t i = 0; i < KV_SECTORS; ++i) {
+        if (sect[i].seq && i != head && garbage(i) && (v == SECT_NONE || garbage(i) > garbage(v))) {
+            v = i;
+        }
+    }
+    return v;
+}
+
+/* sector of data that is not updated while erase counts spread too much */
+static uint8_t coldest(void) {
+    uint8_t  v = SECT_NONE;
+    uint32_t most = 0;
+
+    for (uint8_t i = 0; i < KV_SECTORS; ++i) {
+        if (sect[i].erases > most) {
+            most = sect[i].erases;
+        }
+        if (sect[i].seq && i != head && (v == SECT_NONE || sect[i].erases < sect[v].erases)) {
+            v = i;
+        }
+    }
+    return (v != SECT_NONE && most - sect[v].erases > KV_WEAR_GAP) ? v : SECT_NONE;
+}
+
+/* room for a record of size bytes, compacts first if a new head would take the reserve */
+static kv_state_t makeRoom(uint16_t size) {
+    for (uint8_t n = 0; (head == SECT_NONE || sect[head].used + size > SECT_SIZE) && freeCnt <= RESERVE; ++n) {
+        uint8_t    v = dirtiest();
+        kv_state_t state;
+
+        /* a compaction may give back little more than the tail of the head it closes */
+        if (n == KV_SECTORS) {
+            return KV_FULL;
+        }
+        if (v == SECT_NONE) {
+            /* garbage is left in the head only, the reserve takes its current records and the room */
+            if (head == SECT_NONE || !freeCnt || garbage(head) < size) {
+                return KV_FULL;
+            }
+            v = head;
+            if ((state = openHead()) != KV_OK) {
+                return state;
+            }
+        }
+        if ((state = compact(v)) != KV_OK) {
+            return state;
+        }
+    }
+    return headRoom(size);
+}
+
+static void compactTask(ULONG arg) {
+    ULONG   flags;
+    uint8_t v;
+
+    UNUSED(arg);
+
+    while (1) {
+        tx_event_flags_get(&efKV, FLAG_GC, TX_OR_CLEAR, &flags, TX_WAIT_FOREVER);
+        /* a sector at a time so puts go in between, a round is bounded as in makeRoom() */
+        for (uint8_t n = 0; n < KV_SECTORS; ++n) {
+            kv_state_t state = KV_OK;
+
+            tx_mutex_get(&muxKV, TX_WAIT_FOREVER);
+            if (freeCnt > RESERVE && (v = coldest()) != SECT_NONE) {
+                if ((state = compact(v)) == KV_OK) {
+                    ++stats.wear;
+                    ++stats.background;
+                }
+            } else if ((v = dirtiest()) != SECT_NONE && freeCnt < KV_GC_FREE && garbage(v) >= GC_MIN) {
+                if ((state = compact(v)) == KV_OK) {
+                    ++stats.background;
+                }
+            } else {
+                v = SECT_NONE;
+            }
+            tx_mutex_put(&muxKV);
+
+            if (state != KV_OK) {
+                LOG_ERROR("compaction of sector %u failed: %d", v, state);
+            }
+            if (state != KV_OK || v == SECT_NONE) {
+                break;
+            }
+        }
+    }
+}
+
+/* indexes records of the sector, headers are walked in recBuf filled by reads of SCAN_CHUNK */
+static kv_state_t scan(uint8_t s) {
+    kvRec_t  rec;
+    kvRec_t  last;
+    uint16_t lastOff = 0;
+    uint16_t off = sizeof(kvSect_t);
+    uint16_t from = 0;
+    uint16_t to = 0;
+
+    while (off + sizeof(rec) <= SECT_SIZE) {
+        if (off < from || off + sizeof(rec) > to) {
+            from = off;
+            to = (SECT_SIZE - off < SCAN_CHUNK) ? SECT_SIZE : off + SCAN_CHUNK;
+            if (FLASH_Read((uint8_t *) recBuf, sectAddr(s) + from, to - from) != FLASH_OK) {
+                return KV_FLASH_ERR;
+            }
+        }
+        memcpy(&rec, (const uint8_t *) recBuf + off - from, sizeof(rec));
+        if (rec.key == KEY_BLANK && rec.len == 0xFFFFU && rec.crc == 0xFFFFFFFFU) {
+            break;
+        }
+        if (!recValid(&rec, off)) {
+            /* torn header, nothing goes after it */
+            off = SECT_SIZE;
+            break;
+        }
+        if (lastOff) {
+            apply(s, lastOff, &last);
+        }
+        last = rec;
+        lastOff = off;
+        off += REC_SIZE(rec.len);
+    }
+
+    if (lastOff) {
+        if (FLASH_Read((uint8_t *) recBuf, sectAddr(s) + lastOff, REC_SIZE(last.len)) != FLASH_OK) {
+            return KV_FLASH_ERR;
+        }
+        if (recCrc() == last.crc) {
+            apply(s, lastOff, &last);
+        } else {
+            LOG_WARN("torn record of key %u dropped", last.key);
+            off = SECT_SIZE;
+        }
+    }
+    sect[s].used = off;
+    return KV_OK;
+}
+
+static kv_state_t mount(void) {
+    kvSect_t hdr;
+    uint8_t  order[KV_SECTORS];
+    uint8_t  used = 0;
+    uint32_t known = 0;
+
+    memset(table, 0xFF, sizeof(table));
+    head = SECT_NONE;
+    freeCnt = 0;
+    seqTop = 0;
+
+    for (uint8_t s = 0; s < KV_SECTORS; ++s) {
+        if (FLASH_Read((uint8_t *) &hdr, sectAddr(s), sizeof(hdr)) != FLASH_OK) {
+            return KV_FLASH_ERR;
+        }
+        sect[s] = (sect_t) { .fmt = hdr.magic == KV_MAGIC && hdr.erases == ~hdr.erases_inv };
+        if (sect[s].fmt) {
+            sect[s].erases = hdr.erases;
+            known = (hdr.erases > known) ? hdr.erases : known;
+        }
+        if (!sect[s].fmt || hdr.seq != ~hdr.seq_inv || !hdr.seq || hdr.seq == 0xFFFFFFFFU) {
+            ++freeCnt;
+            continue;
+        }
+        /* ordered by seq */
+        sect[s].seq = hdr.seq;
+        uint8_t i = used++;
+        for (; i && sect[order[i - 1]].seq > hdr.seq; --i) {
+            order[i] = order[i - 1];
+        }
+        order[i] = s;
+        seqTop = (hdr.seq > seqTop) ? hdr.seq : seqTop;
+    }
+    /* counts lost by a torn erase are not taken below the known ones */
+    for (uint8_t s = 0; s < KV_SECTORS; ++s) {
+        if (!sect[s].fmt) {
+            sect[s].erases = known;
+        }
+    }
+
+    for (uint8_t i = 0; i < used; ++i) {
+        kv_state_t state = scan(order[i]);
+        if (state != KV_OK) {
+            return state;
+        }
+    }
+    if (used && sect[order[used - 1]].used < SECT_SIZE) {
+        head = order[used - 1];
+    }
+    return KV_OK;
+}
+
+kv_state_t KV_Init(void) {
+    kv_state_t state;
+    ULONG      start;
+
+    if (mounted) {
+        return KV_OK;
+    }
+    if (tx_mutex_create(&muxKV, "KV Mutex", TX_INHERIT) != TX_SUCCESS) {
+        return KV_TX_ERR;
+    }
+    if (tx_event_flags_create(&efKV, "KV Events") != TX_SUCCESS) {
+        tx_mutex_delete(&muxKV);
+        return KV_TX_ERR;
+    }
+
+    tx_mutex_get(&muxKV, TX_WAIT_FOREVER);
+    memset(&stats, 0, sizeof(stats));
+    start = tx_time_get();
+    state = mount();
+    stats.mount_ticks = tx_time_get() - start;
+    tx_mutex_put(&muxKV);
+
+    if (state == KV_OK &&
+        tx_thread_create(&taskKV, "KV Compaction", compactTask, 0, stackKV, sizeof(stackKV), KV_PRIORITY,
+                         KV_PRIORITY, TX_NO_TIME_SLICE, TX_AUTO_START) != TX_SUCCESS) {
+        state = KV_TX_ERR;
+    }
+    if (state != KV_OK) {
+        tx_mutex_delete(&muxKV);
+        tx_event_flags_delete(&efKV);
+        return state;
+    }
+    mounted = 1;
+    LOG_INFO("KV mounted: %u free sectors, %lu ticks", freeCnt, (unsigned long) stats.mount_ticks);
+    tx_event_flags_set(&efKV, FLAG_GC, TX_OR);
+    return KV_OK;
+}
+
+kv_state_t KV_Deinit(void) {
+    if (!mounted) {
+        return KV_TX_ERR;
+    }
+    /* the thread is not in the middle of compaction while the mutex is held */
+    tx_mutex_get(&muxKV, TX_WAIT_FOREVER);
+    mounted = 0;
+    tx_thread_terminate(&taskKV);
+    tx_thread_delete(&taskKV);
+    tx_mutex_put(&muxKV);
+    tx_mutex_delete(&muxKV);
+    tx_event_flags_delete(&efKV);
+    return KV_OK;
+}
+
+/* size with REC_DEL for a tombstone */
+static kv_state_t put(uint16_t key, const void *data, uint16_t size) {
+    kv_state_t state;
+
+    if ((state = makeRoom(REC_SIZE(size))) != KV_OK) {
+        return state;
+    }
+    REC->key = key;
+    REC->len = size;
+    if (!(size & REC_DEL)) {
+        memcpy(REC + 1, data, size);
+    }
+    REC->crc = recCrc();
+    if ((state = append()) != KV_OK) {
+        return state;
+    }
+    ++stats.puts;
+    stats.bytes += size & ~REC_DEL;
+    return KV_OK;
+}
+
+kv_state_t KV_Put(uint16_t key, const void *data, uint16_t size) {
+    kv_state_t state;
+
+    if (!mounted) {
+        return KV_TX_ERR;
+    }
+    if (key >= KV_KEYS_MAX || size > KV_VALUE_MAX || (size && data == NULL)) {
+        return KV_PARAM_ERR;
+    }
+    tx_mutex_get(&muxKV, TX_WAIT_FOREVER);
+    state = put(key, data, size);
+    tx_mutex_put(&muxKV);
+    return state;
+}
+
+kv_state_t KV_Get(uint16_t key, void *data, uint16_t size, uint16_t *len) {
+    kv_state_t state = KV_OK;
+    entry_t   *e;
+
+    if (!mounted) {
+        return KV_TX_ERR;
+    }
+    if (key >= KV_KEYS_MAX || (size && data == NULL)) {
+        return KV_PARAM_ERR;
+    }
+    tx_mutex_get(&muxKV, TX_WAIT_FOREVER);
+    e = &table[key];
+    if (e->addr == ADDR_NONE || (e->len & REC_DEL)) {
+        state = KV_NOT_FOUND;
+    } else if (FLASH_Read((uint8_t *) recBuf, e->addr, REC_SIZE(e->len)) != FLASH_OK) {
+        state = KV_FLASH_ERR;
+    } else if (REC->key != key || REC->len != e->len || recCrc() != REC->crc) {
+        state = KV_CRC_ERR;
+    } else {
+        if (size) {
+            memcpy(data, REC + 1, (size < e->len) ? size : e->len);
+        }
+        if (len != NULL) {
+            *len = e->len;
+        }
+    }
+    tx_mutex_put(&muxKV);
+    return state;
+}
+
+kv_state_t KV_Delete(uint16_t key) {
+    kv_state_t state;
+
+    if (!mounted) {
+        return KV_TX_ERR;
+    }
+    if (key >= KV_KEYS_MAX) {
+        return KV_PARAM_ERR;
+    }
+    tx_mutex_get(&muxKV, TX_WAIT_FOREVER);
+    if (table[key].addr == ADDR_NONE || (table[key].len & REC_DEL)) {
+        state = KV_NOT_FOUND;
+    } else {
+        state = put(key, NULL, REC_DEL);
+    }
+    tx_mutex_put(&muxKV);
+    return state;
+}
+
+kv_state_t KV_GetStats(kv_stats_t *st) {
+    if (!mounted) {
+        return KV_TX_ERR;
+    }
+    tx_mutex_get(&muxKV, TX_WAIT_FOREVER);
+    *st = stats;
+    st->keys = 0;
+    for (uint16_t k = 0; k < KV_KEYS_MAX; ++k) {
+        st->keys += table[k].addr != ADDR_NONE && !(table[k].len & REC_DEL);
+    }
+    st->free = freeCnt;
+    st->erases_min = 0xFFFFFFFFU;
+    st->erases_max = 0;
+    for (uint8_t s = 0; s < KV_SECTORS; ++s) {
+        st->erases_min = (sect[s].erases < st->erases_min) ? sect[s].erases : st->erases_min;
+        st->erases_max = (sect[s].erases > st->erases_max) ? sect[s].erases : st->erases_max;
+    }
+    tx_mutex_put(&muxKV);
+    return KV_OK;
+}
@@ -41,6 +41,7 @@ typedef enum {
     LOG_M_SHT40,
     LOG_M_DISPLAY,
     LOG_M_TOUCH,
+    LOG_M_KV,
     LOG_MODS_MAX
 } log_module_t;
 
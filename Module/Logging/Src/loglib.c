@@ -36,7 +36,8 @@ static const char *logtypeTable[LOG_TYPES_MAX] = { "[DEBUG]", "[INFO]", "[WARN]"
 static const char *logmoduleTable[LOG_MODS_MAX] = { "[DEFAULT]: ", "[W5500]: ",   "[RFM]: ",         "[INDICATION]: ",
                                                     "[FLASH]: ",   "[LOGGING]: ", "[MODEM]: ",       "[I2C]: ",
                                                     "[BMP390]: ",  "[ESP32]: ",   "[BOOT REASON]: ", "[LIS3DH]: ",
-                                                    "[BUZZER]: ",  "[SHT40]: ",   "[DISPLAY]: ",     "[TOUCH]: " };
+                                                    "[BUZZER]: ",  "[SHT40]: ",   "[DISPLAY]: ",     "[TOUCH]: ",
+                                                    "[KV]: " };
 
 static log_type_t modulesPriorityTable[LOG_MODS_MAX] = { LOG_T_DEBUG };
 
@@ -68,8 +69,8 @@ static void LOG_UART_Transmit_DMA(const uint8_t *pData, uint16_t Size) {
 static void setTimestamp(char *timeBuff) {
     memset(timeBuff, 0, LOG_TIMESTAMP_LEN);
     uint64_t ms = (uint64_t) ((1000.0 / TX_TIMER_TICKS_PER_SECOND) * tx_time_get());
-    snprintf(timeBuff + strlen(timeBuff), LOG_TIMESTAMP_LEN, "%lu:%.2lu:%.2lu:%.3lu ", (uint32_t) (ms / 3600000 % 1000),
-             (uint32_t) (ms / 60000 % 60), (uint32_t) (ms / 1000 % 60), (uint32_t) (ms % 1000));
+    snprintf(timeBuff + strlen(timeBuff), LOG_TIMESTAMP_LEN, "%lu:%.2lu:%.2lu:%.3lu ", (unsigned long) (ms / 3600000 % 1000),
+             (unsigned long) (ms / 60000 % 60), (unsigned long) (ms / 1000 % 60), (unsigned long) (ms % 1000));
 }
 
 // Output log messages thread implementation
@@ -215,7 +215,7 @@ static parser_retVal_t commandLexer(const char *str) {
     for (uint8_t i = 0; i < LEX_MAX_NUM; ++i) {
         memset(lexBuffer[i], TERMINATOR, LEX_MAX_LEN);
     }
-    memset(lexCodeBuffer, TERMINATOR, LEX_MAX_NUM);
+    memset(lexCodeBuffer, TERMINATOR, sizeof(lexCodeBuffer));
 
     for (uint8_t SI = 0, DI = 0, lexNum = 0; str[SI] != TERMINATOR;
          ++SI) {    // SI - Source index(str); DI - Destination index (lexBuffer)
@@ -451,7 +451,7 @@ static void PARSER_Term(const char *str) {
         for (uint8_t i = 0; i < LEX_MAX_NUM; ++i) {
             memset(lexBuffer[i], TERMINATOR, LEX_MAX_LEN);
         }
-        memset(lexCodeBuffer, TERMINATOR, LEX_MAX_NUM);
+        memset(lexCodeBuffer, TERMINATOR, sizeof(lexCodeBuffer));
         return;
     }
 
@@ -460,7 +460,7 @@ static void PARSER_Term(const char *str) {
         for (uint8_t i = 0; i < LEX_MAX_NUM; ++i) {
             memset(lexBuffer[i], TERMINATOR, LEX_MAX_LEN);
         }
-        memset(lexCodeBuffer, TERMINATOR, LEX_MAX_NUM);
+        memset(lexCodeBuffer, TERMINATOR, sizeof(lexCodeBuffer));
         return;
     }
 
@@ -469,7 +469,7 @@ static void PARSER_Term(const char *str) {
         for (uint8_t i = 0; i < LEX_MAX_NUM; ++i) {
             memset(lexBuffer[i], TERMINATOR, LEX_MAX_LEN);
         }
-        memset(lexCodeBuffer, TERMINATOR, LEX_MAX_NUM);
+        memset(lexCodeBuffer, TERMINATOR, sizeof(lexCodeBuffer));
         return;
     }
 
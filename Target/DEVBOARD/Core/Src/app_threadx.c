@@ -32,6 +32,7 @@
 #include "parser.h"
 #include "LED.h"
 #include "flash.h"
+#include "kv.h"
 #include "platform_i2c.h"
 #include "buzzer.h"
 #include "bmp390.h"
@@ -168,6 +169,12 @@ void INIT_StartInitThread(ULONG arg) {
         GENERAL_OutputMessage("FLASH not inited", LOG_T_WARN, LOG_M_FLASH);
     } else {
         GENERAL_OutputMessage("FLASH init OK", LOG_T_DEBUG, LOG_M_FLASH);
+
+        if (KV_Init() != KV_OK) {
+            GENERAL_OutputMessage("KV store not mounted", LOG_T_WARN, LOG_M_KV);
+        } else {
+            GENERAL_OutputMessage("KV store mount OK", LOG_T_DEBUG, LOG_M_KV);
+        }
     }
     LOG_INFO("----INITIALIZATION ENDED----");
 
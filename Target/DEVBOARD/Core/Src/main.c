@@ -226,6 +226,12 @@ void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi) {
     }
 }
 
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi) {
+    if (hspi == &RFM_SPI) {
+        RFM_SPI_SemRelease();
+    }
+}
+
 void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) {
     // if (huart == &MODEM_UART) {
     //     MOD_TxCpltCallback();
@@ -0,0 +1,175 @@
+/* USER CODE BEGIN Header */
+/**
+ ******************************************************************************
+ * @file    app_threadx.c
+ * @brief   ThreadX applicative file of the host build
+ ******************************************************************************
+ * @attention
+ *
+ * Same initialization sequence as DEVBOARD without the peripherals
+ * the host build does not carry (display, ethernet, sensors on
+ * third party APIs, ADC and watchdog).
+ *
+ ******************************************************************************
+ */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "app_threadx.h"
+
+/* Private includes ----------------------------------------------------------*/
+/* USER CODE BEGIN Includes */
+#include <string.h>
+#include "main.h"
+#include "loglib.h"
+#include "parser.h"
+#include "LED.h"
+#include "flash.h"
+#include "kv.h"
+#include "platform_i2c.h"
+#include "buzzer.h"
+#include "boot_reason.h"
+#include "sht40.h"
+#include "esp32.h"
+/* USER CODE END Includes */
+
+/* Private define ------------------------------------------------------------*/
+/* USER CODE BEGIN PD */
+#define INIT_THREAD_STACK_SIZE 1024
+#define LOG_INIT_OK            (1 << 0)
+/* USER CODE END PD */
+
+/* Private variables ---------------------------------------------------------*/
+/* USER CODE BEGIN PV */
+i2c_bus_t            i2c;
+TX_MUTEX             i2c_mux;
+TX_EVENT_FLAGS_GROUP i2c_ef;
+
+static TX_THREAD INIT_InitThread;
+static uint8_t   general_outputInitStatus;
+/* USER CODE END PV */
+
+/* Private function prototypes -----------------------------------------------*/
+/* USER CODE BEGIN PFP */
+static void GENERAL_OutputMessage(char *text, log_type_t logType, log_module_t logModule);
+static void GENERAL_BootReason();
+
+void INIT_StartInitThread(ULONG arg) {
+    TX_BYTE_POOL *byte_pool = (TX_BYTE_POOL *) arg;
+
+    if (LOG_Init(byte_pool) == LOG_S_OK) {
+        general_outputInitStatus |= LOG_INIT_OK;
+    }
+
+    GENERAL_BootReason();
+
+    LOG_INFO("---INITIALIZATION STARTED---");
+
+    if (I2C_Init(&i2c, &I2C, &i2c_mux, &i2c_ef) != I2C_OK) {
+        GENERAL_OutputMessage("I2C bus not inited", LOG_T_WARN, LOG_M_I2C);
+    } else {
+        GENERAL_OutputMessage("I2C bus init OK", LOG_T_DEBUG, LOG_M_I2C);
+    }
+
+    if (LED_Init(byte_pool) != LED_S_OK) {
+        GENERAL_OutputMessage("LED not inited", LOG_T_WARN, LOG_M_INDICATION);
+    } else {
+        GENERAL_OutputMessage("LED init OK", LOG_T_DEBUG, LOG_M_INDICATION);
+    }
+
+    if (ESP32_Init(byte_pool) != ESP32_S_OK) {
+        GENERAL_OutputMessage("ESP32 not inited", LOG_T_WARN, LOG_M_ESP32);
+    } else {
+        GENERAL_OutputMessage("ESP32 init OK", LOG_T_DEBUG, LOG_M_ESP32);
+    }
+
+    if (BUZZER_Init() != BUZZER_OK) {
+        GENERAL_OutputMessage("Buzzer not inited", LOG_T_WARN, LOG_M_BUZZER);
+    } else {
+        GENERAL_OutputMessage("Buzzer init OK", LOG_T_DEBUG, LOG_M_BUZZER);
+    }
+
+    if (HUMID_Init() != HUMID_S_OK) {
+        GENERAL_OutputMessage("SHT40 not inited", LOG_T_WARN, LOG_M_SHT40);
+    } else {
+        GENERAL_OutputMessage("SHT40 init OK", LOG_T_DEBUG, LOG_M_SHT40);
+    }
+
+    if (FLASH_Init() != FLASH_OK) {
+        GENERAL_OutputMessage("FLASH not inited", LOG_T_WARN, LOG_M_FLASH);
+    } else {
+        GENERAL_OutputMessage("FLASH init OK", LOG_T_DEBUG, LOG_M_FLASH);
+
+        if (KV_Init() != KV_OK) {
+            GENERAL_OutputMessage("KV store not mounted", LOG_T_WARN, LOG_M_KV);
+        } else {
+            GENERAL_OutputMessage("KV store mount OK", LOG_T_DEBUG, LOG_M_KV);
+        }
+    }
+
+    LOG_INFO("----INITIALIZATION ENDED----");
+}
+/* USER CODE END PFP */
+
+/**
+ * @brief  Application ThreadX Initialization.
+ * @param memory_ptr: memory pointer
+ * @retval int
+ */
+UINT App_ThreadX_Init(VOID *memory_ptr) {
+    UINT          ret = TX_SUCCESS;
+    TX_BYTE_POOL *byte_pool = (TX_BYTE_POOL *) memory_ptr;
+
+    /* USER CODE BEGIN App_ThreadX_Init */
+    CHAR *INIT_InitThreadStackPointer;
+
+    tx_byte_allocate(byte_pool, (void **) &INIT_InitThreadStackPointer, INIT_THREAD_STACK_SIZE, TX_NO_WAIT);
+    tx_thread_create(&INIT_InitThread, "Init Thread", INIT_StartInitThread, (ULONG) byte_pool,
+                     INIT_InitThreadStackPointer, INIT_THREAD_STACK_SIZE, 0, 0, TX_NO_TIME_SLICE, TX_AUTO_START);
+    /* USER CODE END App_ThreadX_Init */
+
+    return ret;
+}
+
+/**
+ * @brief  MX_ThreadX_Init
+ * @param  None
+ * @retval None
+ */
+void MX_ThreadX_Init(void) {
+    tx_kernel_enter();
+}
+
+/* USER CODE BEGIN 1 */
+static void GENERAL_OutputMessage(char *text, log_type_t logType, log_module_t logModule) {
+    if (strlen(text) == 0) {
+        return;
+    }
+
+    if (general_outputInitStatus & LOG_INIT_OK) {
+        LOG_Put(logType, logModule, text);
+    }
+}
+
+static void GENERAL_BootReason() {
+    uint32_t resStatus = GENERAL_GetResetStatus();
+
+    if (resStatus & RESET_S_OPTION_BYTE_LOADER) {
+        GENERAL_OutputMessage("Option byte loader reset", LOG_T_DEBUG, LOB_M_BOOT);
+    } else if (resStatus & RESET_S_LOW_POWER) {
+        GENERAL_OutputMessage("Low power reset", LOG_T_DEBUG, LOB_M_BOOT);
+    } else if (resStatus & RESET_S_POWER) {
+        GENERAL_OutputMessage("Power on", LOG_T_DEBUG, LOB_M_BOOT);
+    } else if (resStatus & RESET_S_SOFTWARE) {
+        GENERAL_OutputMessage("Software reset", LOG_T_DEBUG, LOB_M_BOOT);
+    } else if (resStatus & RESET_S_INDEPENDENT_WATCHDOG) {
+        GENERAL_OutputMessage("Independent watchdog reset", LOG_T_WARN, LOB_M_BOOT);
+    } else if (resStatus & RESET_S_WINDOW_WATCHDOG) {
+        GENERAL_OutputMessage("Window watchdog reset", LOG_T_WARN, LOB_M_BOOT);
+    } else if (resStatus & RESET_S_EXTERNAL) {
+        GENERAL_OutputMessage("Target reset button pressed", LOG_T_DEBUG, LOB_M_BOOT);
+    } else {
+        GENERAL_OutputMessage("Unknown reason", LOG_T_WARN, LOB_M_BOOT);
+    }
+}
+/* USER CODE END 1 */
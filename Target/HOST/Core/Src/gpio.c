@@ -0,0 +1,35 @@
+/* USER CODE BEGIN Header */
+/**
+ ******************************************************************************
+ * @file    gpio.c
+ * @brief   This file provides code for the configuration of all used GPIO pins.
+ ******************************************************************************
+ * @attention
+ *
+ * Host build of DEVBOARD, peripherals are served by the host HAL.
+ *
+ ******************************************************************************
+ */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "gpio.h"
+
+/**
+ * @brief Configure pins, output levels are the same as on DEVBOARD
+ */
+void MX_GPIO_Init(void) {
+    HAL_GPIO_WritePin(GPIOE, ISM_RFSW_Pin | ISM_RDIO5_Pin | PP3V1_DISP_ON_Pin | PP3V1_WIFI_ON_Pin, GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(DISP_RESET_GPIO_Port, DISP_RESET_Pin, GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(DISP_DCX_GPIO_Port, DISP_DCX_Pin, GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(ETH_NSS_GPIO_Port, ETH_NSS_Pin, GPIO_PIN_SET);
+    HAL_GPIO_WritePin(GPIOB,
+                      PP4VD_ON_Pin | PMIC_STAT_Pin | ETH_RESET_Pin | ISM_RST_Pin | DISP_TS_RESET_Pin | PP3V1_EHT_ON_Pin,
+                      GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(GPIOD, BMP_CS_Pin | DISP_NSS_Pin, GPIO_PIN_SET);
+    HAL_GPIO_WritePin(ISM_NSS_GPIO_Port, ISM_NSS_Pin, GPIO_PIN_SET);
+    HAL_GPIO_WritePin(GPIOD, GSM_ON_Pin | GSM_DTR_Pin, GPIO_PIN_RESET);
+
+    /* pulled up inputs */
+    HOST_GPIO_Drive(GPIOD, JOY_U_Pin | JOY_L_Pin | JOY_OK_Pin | JOY_R_Pin | JOY_D_Pin, GPIO_PIN_SET);
+}
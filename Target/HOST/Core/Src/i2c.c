@@ -0,0 +1,36 @@
+/* USER CODE BEGIN Header */
+/**
+ ******************************************************************************
+ * @file    i2c.c
+ * @brief   This file provides code for the configuration of the I2C instances.
+ ******************************************************************************
+ * @attention
+ *
+ * Host build of DEVBOARD, peripherals are served by the host HAL.
+ *
+ ******************************************************************************
+ */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "i2c.h"
+
+I2C_HandleTypeDef hi2c1;
+I2C_HandleTypeDef hi2c3;
+
+static void I2C_BusInit(I2C_HandleTypeDef *hi2c, I2C_TypeDef *instance) {
+    hi2c->Instance = instance;
+    if (HAL_I2C_Init(hi2c) != HAL_OK) {
+        Error_Handler();
+    }
+}
+
+/* I2C1 init function */
+void MX_I2C1_Init(void) {
+    I2C_BusInit(&hi2c1, I2C1);
+}
+
+/* I2C3 init function */
+void MX_I2C3_Init(void) {
+    I2C_BusInit(&hi2c3, I2C3);
+}
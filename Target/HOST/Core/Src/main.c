@@ -0,0 +1,196 @@
+/* USER CODE BEGIN Header */
+/**
+ ******************************************************************************
+ * @file           : main.c
+ * @brief          : Main program body of the host build.
+ *                   Board bring-up of DEVBOARD on top of the host HAL,
+ *                   the console UART is connected to stdin/stdout.
+ ******************************************************************************
+ */
+/* USER CODE END Header */
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "main.h"
+#include "app_threadx.h"
+#include "i2c.h"
+#include "usart.h"
+#include "octospi.h"
+#include "spi.h"
+#include "tim.h"
+#include "gpio.h"
+
+/* Private includes ----------------------------------------------------------*/
+/* USER CODE BEGIN Includes */
+#include "loglib.h"
+#include "esp32.h"
+#include "parser.h"
+#include "buzzer.h"
+#include "boot_reason.h"
+#include "flash.h"
+#include "rfm66a.h"
+#include "geode.h"
+#include "sim_is25l.h"
+/* USER CODE END Includes */
+
+/* Private function prototypes -----------------------------------------------*/
+/* USER CODE BEGIN PFP */
+static void HOST_ConsoleOut(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t size);
+static void HOST_ConsoleIn(const uint8_t *data, size_t len);
+/* USER CODE END PFP */
+
+/**
+ * @brief  The application entry point.
+ * @retval int
+ */
+int main(int argc, char **argv) {
+    /* USER CODE BEGIN 1 */
+    HOST_SimInit(argc, argv);
+    /* USER CODE END 1 */
+
+    /* MCU Configuration--------------------------------------------------------*/
+
+    /* Reset of all peripherals, Initializes the Flash interface and the Systick. */
+    HAL_Init();
+
+    /* USER CODE BEGIN SysInit */
+    GENERAL_GetResetStatus();
+    /* USER CODE END SysInit */
+
+    /* Initialize all configured peripherals */
+    MX_GPIO_Init();
+    MX_SPI2_Init();
+    MX_TIM4_Init();
+    MX_I2C1_Init();
+    MX_I2C3_Init();
+    MX_USART1_UART_Init();
+    MX_SPI3_Init();
+    MX_SPI1_Init();
+    MX_USART2_UART_Init();
+    MX_LPUART1_UART_Init();
+    MX_USART3_UART_Init();
+    MX_TIM3_Init();
+    MX_OCTOSPI1_Init();
+    MX_TIM2_Init();
+    MX_TIM7_Init();
+    /* USER CODE BEGIN 2 */
+    HOST_UART_Sink(&LOG_UART, HOST_ConsoleOut);
+    HOST_InputRegister(HOST_ConsoleIn);
+    SIM_IS25L_Attach(&FLASH_QSPI, 1);
+    /* USER CODE END 2 */
+
+    MX_ThreadX_Init();
+
+    /* We should never get here as control is now taken by the scheduler */
+    return EXIT_FAILURE;
+}
+
+/* USER CODE BEGIN 4 */
+static void HOST_ConsoleOut(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t size) {
+    UNUSED(huart);
+    fwrite(data, 1, size, stdout);
+    fflush(stdout);
+}
+
+static void HOST_ConsoleIn(const uint8_t *data, size_t len) {
+    HOST_UART_Inject(&LOG_UART, data, len);
+}
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi) {
+    if (hspi == &RFM_SPI) {
+        RFM_SPI_SemRelease();
+    }
+}
+
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi) {
+    if (hspi == &RFM_SPI) {
+        RFM_SPI_SemRelease();
+    }
+}
+
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi) {
+    if (hspi == &RFM_SPI) {
+        RFM_SPI_SemRelease();
+    }
+}
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) {
+    if (huart == &LOG_UART) {
+        LOG_TxCpltCallback();
+    }
+    if (huart == &EXT_UART) {
+        ESP32_TxCallback();
+    }
+}
+
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart) {
+    if (huart == &LOG_UART) {
+        PARSER_RxCpltCallback();
+    }
+    if (huart == &EXT_UART) {
+        ESP32_RxCallback();
+    }
+}
+
+void HAL_TIM_PWM_PulseFinishedCallback(TIM_HandleTypeDef *htim) {
+    if (htim->Instance == TIM2) {
+        BUZZER_TIM_PWM_PulseFinishedCallback(htim);
+    }
+}
+
+void HAL_GPIO_EXTI_Rising_Callback(uint16_t GPIO_Pin) {
+    if (GPIO_Pin == ISM_RDIO2_Pin) {
+        RFM_SemRelease();
+    }
+}
+
+void HAL_GPIO_EXTI_Falling_Callback(uint16_t GPIO_Pin) {
+    if (GPIO_Pin == ISM_RDIO0_Pin || GPIO_Pin == ISM_RDIO4_Pin) {
+        RFM_SemRelease();
+    }
+}
+
+void HAL_OSPI_StatusMatchCallback(OSPI_HandleTypeDef *hospi) {
+    if (hospi == &FLASH_QSPI) {
+        IS25L_StatusMatchCallback();
+    }
+}
+
+void HAL_OSPI_RxCpltCallback(OSPI_HandleTypeDef *hospi) {
+    if (hospi == &FLASH_QSPI) {
+        IS25L_RxCompleteCallback();
+    }
+}
+
+void HAL_OSPI_TxCpltCallback(OSPI_HandleTypeDef *hospi) {
+    if (hospi == &FLASH_QSPI) {
+        IS25L_TxCompleteCallback();
+    }
+}
+
+void HAL_OSPI_CmdCpltCallback(OSPI_HandleTypeDef *hospi) {
+    if (hospi == &FLASH_QSPI) {
+        IS25L_CmdCompleteCallback();
+    }
+}
+/* USER CODE END 4 */
+
+/**
+ * @brief  Period elapsed callback in non blocking mode
+ * @note   The HAL time base is driven by the simulator tick, so there is no TIM17 here.
+ * @param  htim : TIM handle
+ * @retval None
+ */
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim) {
+    GOD_TIM_Callback(htim);
+}
+
+/**
+ * @brief  This function is executed in case of error occurrence.
+ * @retval None
+ */
+void Error_Handler(void) {
+    fprintf(stderr, "Error_Handler at %llu ns\n", (unsigned long long) HOST_Now());
+    HOST_Exit(EXIT_FAILURE);
+}
@@ -0,0 +1,26 @@
+/* USER CODE BEGIN Header */
+/**
+ ******************************************************************************
+ * @file    octospi.c
+ * @brief   This file provides code for the configuration of the OCTOSPI instances.
+ ******************************************************************************
+ * @attention
+ *
+ * Host build of DEVBOARD, peripherals are served by the host HAL.
+ *
+ ******************************************************************************
+ */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "octospi.h"
+
+OSPI_HandleTypeDef hospi1;
+
+/* OCTOSPI1 init function */
+void MX_OCTOSPI1_Init(void) {
+    hospi1.Instance = OCTOSPI1;
+    if (HAL_OSPI_Init(&hospi1) != HAL_OK) {
+        Error_Handler();
+    }
+}
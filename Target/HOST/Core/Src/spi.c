@@ -0,0 +1,42 @@
+/* USER CODE BEGIN Header */
+/**
+ ******************************************************************************
+ * @file    spi.c
+ * @brief   This file provides code for the configuration of the SPI instances.
+ ******************************************************************************
+ * @attention
+ *
+ * Host build of DEVBOARD, peripherals are served by the host HAL.
+ *
+ ******************************************************************************
+ */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "spi.h"
+
+SPI_HandleTypeDef hspi1;
+SPI_HandleTypeDef hspi2;
+SPI_HandleTypeDef hspi3;
+
+static void SPI_Init(SPI_HandleTypeDef *hspi, SPI_TypeDef *instance) {
+    hspi->Instance = instance;
+    if (HAL_SPI_Init(hspi) != HAL_OK) {
+        Error_Handler();
+    }
+}
+
+/* SPI1 init function */
+void MX_SPI1_Init(void) {
+    SPI_Init(&hspi1, SPI1);
+}
+
+/* SPI2 init function */
+void MX_SPI2_Init(void) {
+    SPI_Init(&hspi2, SPI2);
+}
+
+/* SPI3 init function */
+void MX_SPI3_Init(void) {
+    SPI_Init(&hspi3, SPI3);
+}
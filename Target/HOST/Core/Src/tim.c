@@ -0,0 +1,57 @@
+/* USER CODE BEGIN Header */
+/**
+ ******************************************************************************
+ * @file    tim.c
+ * @brief   This file provides code for the configuration of the TIM instances.
+ ******************************************************************************
+ * @attention
+ *
+ * Host build of DEVBOARD, peripherals are served by the host HAL.
+ *
+ ******************************************************************************
+ */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "tim.h"
+
+TIM_HandleTypeDef htim2;
+TIM_HandleTypeDef htim3;
+TIM_HandleTypeDef htim4;
+TIM_HandleTypeDef htim7;
+
+static void TIM_Init(TIM_HandleTypeDef *htim, TIM_TypeDef *instance, uint32_t prescaler, uint32_t period) {
+    htim->Instance = instance;
+    htim->Init.Prescaler = prescaler;
+    htim->Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim->Init.Period = period;
+    htim->Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    htim->Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+    if (HAL_TIM_Base_Init(htim) != HAL_OK) {
+        Error_Handler();
+    }
+}
+
+/* TIM2 init function */
+void MX_TIM2_Init(void) {
+    TIM_Init(&htim2, TIM2, 5 - 1, 255);
+}
+
+/* TIM3 init function */
+void MX_TIM3_Init(void) {
+    TIM_Init(&htim3, TIM3, 19200, 100);
+}
+
+/* TIM4 init function */
+void MX_TIM4_Init(void) {
+    TIM_Init(&htim4, TIM4, 5000, 100);
+}
+
+/* TIM7 init function */
+void MX_TIM7_Init(void) {
+    TIM_Init(&htim7, TIM7, 100 - 1, 63999);
+}
+
+void HAL_TIM_MspPostInit(TIM_HandleTypeDef *htim) {
+    UNUSED(htim);
+}
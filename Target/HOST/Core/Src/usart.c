@@ -0,0 +1,54 @@
+/* USER CODE BEGIN Header */
+/**
+ ******************************************************************************
+ * @file    usart.c
+ * @brief   This file provides code for the configuration of the USART instances.
+ ******************************************************************************
+ * @attention
+ *
+ * Host build of DEVBOARD, peripherals are served by the host HAL.
+ *
+ ******************************************************************************
+ */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "usart.h"
+
+UART_HandleTypeDef hlpuart1;
+UART_HandleTypeDef huart1;
+UART_HandleTypeDef huart2;
+UART_HandleTypeDef huart3;
+
+static void UART_Init(UART_HandleTypeDef *huart, USART_TypeDef *instance) {
+    huart->Instance = instance;
+    huart->Init.BaudRate = 115200;
+    huart->Init.WordLength = UART_WORDLENGTH_8B;
+    huart->Init.StopBits = UART_STOPBITS_1;
+    huart->Init.Parity = UART_PARITY_NONE;
+    huart->Init.Mode = UART_MODE_TX_RX;
+    huart->Init.HwFlowCtl = UART_HWCONTROL_NONE;
+    if (HAL_UART_Init(huart) != HAL_OK) {
+        Error_Handler();
+    }
+}
+
+/* LPUART1 init function */
+void MX_LPUART1_UART_Init(void) {
+    UART_Init(&hlpuart1, LPUART1);
+}
+
+/* USART1 init function */
+void MX_USART1_UART_Init(void) {
+    UART_Init(&huart1, USART1);
+}
+
+/* USART2 init function */
+void MX_USART2_UART_Init(void) {
+    UART_Init(&huart2, USART2);
+}
+
+/* USART3 init function */
+void MX_USART3_UART_Init(void) {
+    UART_Init(&huart3, USART3);
+}
@@ -0,0 +1,35 @@
+/**
+ * @file host_core.h
+ * @brief Core peripherals of the host HAL (core_cmXX.h counterpart).
+ *        DWT registers exist for EXT_DEBUG builds, CYCCNT is updated on every
+ *        simulated interrupt entry.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#ifndef HOST_CORE_H
+#define HOST_CORE_H
+
+#include "host_hal_def.h"
+
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+#define DWT_CTRL_CYCCNTENA_Msk     (1UL)
+
+typedef struct {
+    __IO uint32_t CTRL;
+    __IO uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct {
+    __IO uint32_t DEMCR;
+} CoreDebug_Type;
+
+extern DWT_Type       HOST_DWT;
+extern CoreDebug_Type HOST_CoreDebug;
+
+#define DWT       (&HOST_DWT)
+#define CoreDebug (&HOST_CoreDebug)
+
+#endif    // HOST_CORE_H
@@ -0,0 +1,35 @@
+/**
+ * @file host_hal.h
+ * @brief Host HAL umbrella header (stm32xxxx_hal.h counterpart).
+ *        This file provides the subset of the STM32 HAL used by the firmware
+ *        implemented on top of the simulator:
+ *            + GPIO with EXTI
+ *            + SPI, I2C, UART, OCTOSPI with blocking, IT and DMA transfers
+ *            + Basic and PWM timers
+ *        ### How to use host HAL ###
+ *     Firmware code is compiled unchanged, peripheral handles are declared by
+ *     Target/HOST/Core exactly as CubeMX does. Device models are attached to
+ *     buses with HOST_*_Attach() and drive interrupts through the simulator.
+ *     + Callbacks are dispatched per handle (as with USE_HAL_*_REGISTER_CALLBACKS),
+ *       by default to the weak HAL_*Callback() functions
+ *     + Transfer latencies are set with --sim-* options (see host_sim.h)
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#ifndef HOST_HAL_H
+#define HOST_HAL_H
+
+#include "host_hal_def.h"
+#include "host_hal_rcc.h"
+#include "host_hal_gpio.h"
+#include "host_hal_tim.h"
+#include "host_hal_spi.h"
+#include "host_hal_i2c.h"
+#include "host_hal_uart.h"
+#include "host_hal_ospi.h"
+
+#endif    // HOST_HAL_H
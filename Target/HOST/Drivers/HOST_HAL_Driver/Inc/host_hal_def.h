@@ -0,0 +1,87 @@
+/**
+ * @file host_hal_def.h
+ * @brief Common definitions of the host HAL.
+ *        Mirrors the part of stm32xxxx_hal_def.h used by the firmware.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#ifndef HOST_HAL_DEF_H
+#define HOST_HAL_DEF_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "host_sim.h"
+
+typedef enum {
+    HAL_OK = 0x00U,
+    HAL_ERROR = 0x01U,
+    HAL_BUSY = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+typedef enum {
+    HAL_UNLOCKED = 0x00U,
+    HAL_LOCKED = 0x01U
+} HAL_LockTypeDef;
+
+typedef enum {
+    RESET = 0U,
+    SET = !RESET
+} FlagStatus, ITStatus;
+
+typedef enum {
+    DISABLE = 0U,
+    ENABLE = !DISABLE
+} FunctionalState;
+
+#define HAL_MAX_DELAY 0xFFFFFFFFU
+
+#define __IO volatile
+#define __I  volatile const
+
+#ifndef __weak
+#define __weak __attribute__((weak))
+#endif
+#ifndef __packed
+#define __packed __attribute__((packed))
+#endif
+#ifndef __unused
+#define __unused __attribute__((unused))
+#endif
+#ifndef __ALIGN_BEGIN
+#define __ALIGN_BEGIN
+#define __ALIGN_END __attribute__((aligned(4)))
+#endif
+
+#define UNUSED(X) (void) X
+
+/* interrupts are simulated by the host port, there is nothing to mask */
+#define __disable_irq()
+#define __enable_irq()
+#define __NOP()
+
+/**
+ * @brief Operation state of handles, shared by all simulated peripherals
+ */
+typedef enum {
+    HOST_HAL_STATE_RESET,
+    HOST_HAL_STATE_READY,
+    HOST_HAL_STATE_BUSY
+} host_hal_state_t;
+
+extern __IO uint32_t uwTick;
+
+HAL_StatusTypeDef HAL_Init(void);
+
+void     HAL_IncTick(void);
+uint32_t HAL_GetTick(void);
+void     HAL_Delay(uint32_t Delay);
+
+/* newlib extension used by the firmware, glibc does not provide it */
+char *itoa(int value, char *str, int base);
+
+#endif    // HOST_HAL_DEF_H
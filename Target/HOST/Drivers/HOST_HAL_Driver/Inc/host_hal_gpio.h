@@ -0,0 +1,87 @@
+/**
+ * @file host_hal_gpio.h
+ * @brief GPIO and EXTI of the host HAL.
+ *        Output pins notify attached models, input pins driven by models raise EXTI callbacks.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#ifndef HOST_HAL_GPIO_H
+#define HOST_HAL_GPIO_H
+
+#include "host_hal_def.h"
+
+#define GPIO_PIN_0   ((uint16_t) 0x0001)
+#define GPIO_PIN_1   ((uint16_t) 0x0002)
+#define GPIO_PIN_2   ((uint16_t) 0x0004)
+#define GPIO_PIN_3   ((uint16_t) 0x0008)
+#define GPIO_PIN_4   ((uint16_t) 0x0010)
+#define GPIO_PIN_5   ((uint16_t) 0x0020)
+#define GPIO_PIN_6   ((uint16_t) 0x0040)
+#define GPIO_PIN_7   ((uint16_t) 0x0080)
+#define GPIO_PIN_8   ((uint16_t) 0x0100)
+#define GPIO_PIN_9   ((uint16_t) 0x0200)
+#define GPIO_PIN_10  ((uint16_t) 0x0400)
+#define GPIO_PIN_11  ((uint16_t) 0x0800)
+#define GPIO_PIN_12  ((uint16_t) 0x1000)
+#define GPIO_PIN_13  ((uint16_t) 0x2000)
+#define GPIO_PIN_14  ((uint16_t) 0x4000)
+#define GPIO_PIN_15  ((uint16_t) 0x8000)
+#define GPIO_PIN_All ((uint16_t) 0xFFFF)
+
+typedef enum {
+    GPIO_PIN_RESET = 0U,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+typedef struct host_gpio_listener host_gpio_listener_t;
+
+/**
+ * @brief Model attached to output pins of a port
+ */
+struct host_gpio_listener {
+    uint16_t mask;
+    void (*changed)(host_gpio_listener_t *l, uint16_t pins, uint16_t odr);
+    host_gpio_listener_t *next;
+};
+
+typedef struct {
+    __IO uint32_t ODR;
+    __IO uint32_t IDR;
+    __IO uint32_t BSRR; /* plain stores are applied before the clock advances */
+    __IO uint32_t BRR;
+    void (*RisingCallback)(uint16_t GPIO_Pin);
+    void (*FallingCallback)(uint16_t GPIO_Pin);
+    host_gpio_listener_t *listeners;
+    uint32_t              odr_seen;
+} GPIO_TypeDef;
+
+extern GPIO_TypeDef HOST_GPIOA, HOST_GPIOB, HOST_GPIOC, HOST_GPIOD, HOST_GPIOE;
+
+#define GPIOA (&HOST_GPIOA)
+#define GPIOB (&HOST_GPIOB)
+#define GPIOC (&HOST_GPIOC)
+#define GPIOD (&HOST_GPIOD)
+#define GPIOE (&HOST_GPIOE)
+
+void          HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void          HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+
+void HAL_GPIO_EXTI_Rising_Callback(uint16_t GPIO_Pin);
+void HAL_GPIO_EXTI_Falling_Callback(uint16_t GPIO_Pin);
+
+/**
+ * @brief Attach model to output pins of the port
+ */
+void HOST_GPIO_Listen(GPIO_TypeDef *GPIOx, host_gpio_listener_t *l);
+
+/**
+ * @brief Drive input pin from a model, edges raise EXTI callbacks of the port
+ * @note Must be called from an event handler (interrupt context)
+ */
+void HOST_GPIO_Drive(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+
+#endif    // HOST_HAL_GPIO_H
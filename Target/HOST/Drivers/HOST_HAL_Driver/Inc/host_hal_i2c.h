@@ -0,0 +1,110 @@
+/**
+ * @file host_hal_i2c.h
+ * @brief I2C master of the host HAL.
+ *        Transfers to an address without attached device end with NACK.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#ifndef HOST_HAL_I2C_H
+#define HOST_HAL_I2C_H
+
+#include "host_hal_def.h"
+
+#define HAL_I2C_ERROR_NONE (0x00000000U)
+#define HAL_I2C_ERROR_BERR (0x00000001U)
+#define HAL_I2C_ERROR_ARLO (0x00000002U)
+#define HAL_I2C_ERROR_AF   (0x00000004U)
+
+#define I2C_MEMADD_SIZE_8BIT  (0x00000001U)
+#define I2C_MEMADD_SIZE_16BIT (0x00000002U)
+
+typedef struct {
+    uint32_t id;
+} I2C_TypeDef;
+
+extern I2C_TypeDef HOST_I2C1, HOST_I2C3;
+
+#define I2C1 (&HOST_I2C1)
+#define I2C3 (&HOST_I2C3)
+
+typedef struct host_i2c_dev host_i2c_dev_t;
+
+/**
+ * @brief Device model attached to the bus
+ */
+struct host_i2c_dev {
+    uint16_t addr; /* 8-bit address as passed to HAL */
+    HAL_StatusTypeDef (*write)(host_i2c_dev_t *dev, const uint8_t *data, uint16_t size);
+    HAL_StatusTypeDef (*read)(host_i2c_dev_t *dev, uint8_t *data, uint16_t size);
+    host_i2c_dev_t *next;
+};
+
+typedef struct __I2C_HandleTypeDef {
+    I2C_TypeDef     *Instance;
+    host_hal_state_t State;
+    __IO uint32_t    ErrorCode;
+    void (*MasterTxCpltCallback)(struct __I2C_HandleTypeDef *hi2c);
+    void (*MasterRxCpltCallback)(struct __I2C_HandleTypeDef *hi2c);
+    void (*MemTxCpltCallback)(struct __I2C_HandleTypeDef *hi2c);
+    void (*MemRxCpltCallback)(struct __I2C_HandleTypeDef *hi2c);
+    void (*ErrorCallback)(struct __I2C_HandleTypeDef *hi2c);
+    void (*AbortCpltCallback)(struct __I2C_HandleTypeDef *hi2c);
+
+    /* simulation state */
+    host_i2c_dev_t *devs;
+    host_event_t    done;
+    uint8_t         nack;
+    void (*cplt)(struct __I2C_HandleTypeDef *hi2c);
+} I2C_HandleTypeDef;
+
+#define HAL_I2C_MASTER_TX_COMPLETE_CB_ID (0x00U)
+#define HAL_I2C_MASTER_RX_COMPLETE_CB_ID (0x01U)
+#define HAL_I2C_MEM_TX_COMPLETE_CB_ID    (0x06U)
+#define HAL_I2C_MEM_RX_COMPLETE_CB_ID    (0x07U)
+#define HAL_I2C_ERROR_CB_ID              (0x08U)
+#define HAL_I2C_ABORT_CB_ID              (0x09U)
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size,
+                                          uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size,
+                                         uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                    uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                   uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                             uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                            uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Mem_Write_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                       uint16_t MemAddSize, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Mem_Read_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                      uint16_t MemAddSize, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                              uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Master_Receive_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                             uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                        uint16_t MemAddSize, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Mem_Read_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                       uint16_t MemAddSize, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_RegisterCallback(I2C_HandleTypeDef *hi2c, uint32_t CallbackID,
+                                           void (*pCallback)(I2C_HandleTypeDef *hi2c));
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_AbortCpltCallback(I2C_HandleTypeDef *hi2c);
+
+/**
+ * @brief Attach device model to the bus
+ */
+void HOST_I2C_Attach(I2C_HandleTypeDef *hi2c, host_i2c_dev_t *dev);
+
+#endif    // HOST_HAL_I2C_H
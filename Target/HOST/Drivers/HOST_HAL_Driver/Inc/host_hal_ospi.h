@@ -0,0 +1,189 @@
+/**
+ * @file host_hal_ospi.h
+ * @brief OCTOSPI of the host HAL (indirect, auto-polling and memory-mapped modes).
+ *        Commands are executed by the attached memory model, in memory-mapped mode
+ *        OCTOSPI1_BASE points to the array of the model.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#ifndef HOST_HAL_OSPI_H
+#define HOST_HAL_OSPI_H
+
+#include "host_hal_def.h"
+
+#define HAL_OSPI_ERROR_NONE    (0x00000000U)
+#define HAL_OSPI_ERROR_TIMEOUT (0x00000001U)
+
+#define HAL_OSPI_TIMEOUT_DEFAULT_VALUE (5000U)
+
+#define HAL_OSPI_OPTYPE_COMMON_CFG (0x00000000U)
+#define HAL_OSPI_OPTYPE_READ_CFG   (0x00000001U)
+#define HAL_OSPI_OPTYPE_WRITE_CFG  (0x00000002U)
+#define HAL_OSPI_FLASH_ID_1        (0x00000000U)
+
+#define HAL_OSPI_INSTRUCTION_NONE    (0x00000000U)
+#define HAL_OSPI_INSTRUCTION_1_LINE  (0x00000001U)
+#define HAL_OSPI_INSTRUCTION_2_LINES (0x00000002U)
+#define HAL_OSPI_INSTRUCTION_4_LINES (0x00000003U)
+#define HAL_OSPI_INSTRUCTION_8_LINES (0x00000004U)
+
+#define HAL_OSPI_INSTRUCTION_8_BITS  (0x00000000U)
+#define HAL_OSPI_INSTRUCTION_16_BITS (0x00000010U)
+
+#define HAL_OSPI_INSTRUCTION_DTR_DISABLE (0x00000000U)
+
+#define HAL_OSPI_ADDRESS_NONE    (0x00000000U)
+#define HAL_OSPI_ADDRESS_1_LINE  (0x00000100U)
+#define HAL_OSPI_ADDRESS_2_LINES (0x00000200U)
+#define HAL_OSPI_ADDRESS_4_LINES (0x00000300U)
+#define HAL_OSPI_ADDRESS_8_LINES (0x00000400U)
+
+#define HAL_OSPI_ADDRESS_8_BITS  (0x00000000U)
+#define HAL_OSPI_ADDRESS_16_BITS (0x00001000U)
+#define HAL_OSPI_ADDRESS_24_BITS (0x00002000U)
+#define HAL_OSPI_ADDRESS_32_BITS (0x00003000U)
+
+#define HAL_OSPI_ADDRESS_DTR_DISABLE (0x00000000U)
+
+#define HAL_OSPI_ALTERNATE_BYTES_NONE        (0x00000000U)
+#define HAL_OSPI_ALTERNATE_BYTES_DTR_DISABLE (0x00000000U)
+
+#define HAL_OSPI_DATA_NONE    (0x00000000U)
+#define HAL_OSPI_DATA_1_LINE  (0x01000000U)
+#define HAL_OSPI_DATA_2_LINES (0x02000000U)
+#define HAL_OSPI_DATA_4_LINES (0x03000000U)
+#define HAL_OSPI_DATA_8_LINES (0x04000000U)
+
+#define HAL_OSPI_DATA_DTR_DISABLE (0x00000000U)
+#define HAL_OSPI_DQS_DISABLE      (0x00000000U)
+
+#define HAL_OSPI_SIOO_INST_EVERY_CMD (0x00000000U)
+#define HAL_OSPI_SIOO_INST_ONLY_FIRST_CMD (0x80000000U)
+
+#define HAL_OSPI_MATCH_MODE_AND (0x00000000U)
+#define HAL_OSPI_MATCH_MODE_OR  (0x00400000U)
+
+#define HAL_OSPI_AUTOMATIC_STOP_DISABLE (0x00000000U)
+#define HAL_OSPI_AUTOMATIC_STOP_ENABLE  (0x00400000U)
+
+#define HAL_OSPI_TIMEOUT_COUNTER_DISABLE (0x00000000U)
+#define HAL_OSPI_TIMEOUT_COUNTER_ENABLE  (0x00000008U)
+
+typedef struct {
+    uint32_t id;
+    uint8_t *window; /* array of the memory in memory-mapped mode */
+} OCTOSPI_TypeDef;
+
+extern OCTOSPI_TypeDef HOST_OCTOSPI1;
+
+#define OCTOSPI1      (&HOST_OCTOSPI1)
+#define OCTOSPI1_BASE ((uintptr_t) HOST_OCTOSPI1.window)
+
+typedef struct {
+    uint32_t OperationType;
+    uint32_t FlashId;
+    uint32_t Instruction;
+    uint32_t InstructionMode;
+    uint32_t InstructionSize;
+    uint32_t InstructionDtrMode;
+    uint32_t Address;
+    uint32_t AddressMode;
+    uint32_t AddressSize;
+    uint32_t AddressDtrMode;
+    uint32_t AlternateBytes;
+    uint32_t AlternateBytesMode;
+    uint32_t AlternateBytesSize;
+    uint32_t AlternateBytesDtrMode;
+    uint32_t DataMode;
+    uint32_t NbData;
+    uint32_t DataDtrMode;
+    uint32_t DummyCycles;
+    uint32_t DQSMode;
+    uint32_t SIOOMode;
+} OSPI_RegularCmdTypeDef;
+
+typedef struct {
+    uint32_t Match;
+    uint32_t Mask;
+    uint32_t MatchMode;
+    uint32_t AutomaticStop;
+    uint32_t Interval;
+} OSPI_AutoPollingTypeDef;
+
+typedef struct {
+    uint32_t TimeOutActivation;
+    uint32_t TimeOutPeriod;
+} OSPI_MemoryMappedTypeDef;
+
+typedef struct host_ospi_dev host_ospi_dev_t;
+
+/**
+ * @brief Memory model attached to the interface
+ */
+struct host_ospi_dev {
+    /* executes the command at its end, data direction is given by the call that started the data phase */
+    void (*exec)(host_ospi_dev_t *dev, const OSPI_RegularCmdTypeDef *cmd, const uint8_t *tx, uint8_t *rx);
+    /* returns the time the result of the (status) command can change next, 0 - never */
+    uint64_t (*next_change)(host_ospi_dev_t *dev);
+    /* returns the array read by the command in memory-mapped mode, NULL - the memory can not be read so */
+    uint8_t *(*map)(host_ospi_dev_t *dev, const OSPI_RegularCmdTypeDef *cmd);
+};
+
+typedef struct __OSPI_HandleTypeDef {
+    OCTOSPI_TypeDef *Instance;
+    host_hal_state_t State;
+    __IO uint32_t    ErrorCode;
+    void (*CmdCpltCallback)(struct __OSPI_HandleTypeDef *hospi);
+    void (*RxCpltCallback)(struct __OSPI_HandleTypeDef *hospi);
+    void (*TxCpltCallback)(struct __OSPI_HandleTypeDef *hospi);
+    void (*StatusMatchCallback)(struct __OSPI_HandleTypeDef *hospi);
+    void (*ErrorCallback)(struct __OSPI_HandleTypeDef *hospi);
+
+    /* simulation state */
+    host_ospi_dev_t        *dev;
+    OSPI_RegularCmdTypeDef  cmd;
+    OSPI_RegularCmdTypeDef  read_cfg; /* of memory-mapped mode */
+    OSPI_AutoPollingTypeDef poll;
+    host_event_t            done;
+    const uint8_t          *tx;
+    uint8_t                *rx;
+    void (*cplt)(struct __OSPI_HandleTypeDef *hospi);
+} OSPI_HandleTypeDef;
+
+#define HAL_OSPI_RX_CPLT_CB_ID       (0x03U)
+#define HAL_OSPI_TX_CPLT_CB_ID       (0x04U)
+#define HAL_OSPI_CMD_CPLT_CB_ID      (0x07U)
+#define HAL_OSPI_STATUS_MATCH_CB_ID  (0x08U)
+#define HAL_OSPI_ERROR_CB_ID         (0x00U)
+
+HAL_StatusTypeDef HAL_OSPI_Init(OSPI_HandleTypeDef *hospi);
+HAL_StatusTypeDef HAL_OSPI_Command(OSPI_HandleTypeDef *hospi, OSPI_RegularCmdTypeDef *cmd, uint32_t Timeout);
+HAL_StatusTypeDef HAL_OSPI_Command_IT(OSPI_HandleTypeDef *hospi, OSPI_RegularCmdTypeDef *cmd);
+HAL_StatusTypeDef HAL_OSPI_Transmit(OSPI_HandleTypeDef *hospi, uint8_t *pData, uint32_t Timeout);
+HAL_StatusTypeDef HAL_OSPI_Receive(OSPI_HandleTypeDef *hospi, uint8_t *pData, uint32_t Timeout);
+HAL_StatusTypeDef HAL_OSPI_Transmit_IT(OSPI_HandleTypeDef *hospi, uint8_t *pData);
+HAL_StatusTypeDef HAL_OSPI_Receive_IT(OSPI_HandleTypeDef *hospi, uint8_t *pData);
+HAL_StatusTypeDef HAL_OSPI_Transmit_DMA(OSPI_HandleTypeDef *hospi, uint8_t *pData);
+HAL_StatusTypeDef HAL_OSPI_Receive_DMA(OSPI_HandleTypeDef *hospi, uint8_t *pData);
+HAL_StatusTypeDef HAL_OSPI_AutoPolling(OSPI_HandleTypeDef *hospi, OSPI_AutoPollingTypeDef *cfg, uint32_t Timeout);
+HAL_StatusTypeDef HAL_OSPI_AutoPolling_IT(OSPI_HandleTypeDef *hospi, OSPI_AutoPollingTypeDef *cfg);
+HAL_StatusTypeDef HAL_OSPI_MemoryMapped(OSPI_HandleTypeDef *hospi, OSPI_MemoryMappedTypeDef *cfg);
+HAL_StatusTypeDef HAL_OSPI_Abort(OSPI_HandleTypeDef *hospi);
+HAL_StatusTypeDef HAL_OSPI_RegisterCallback(OSPI_HandleTypeDef *hospi, uint32_t CallbackID,
+                                            void (*pCallback)(OSPI_HandleTypeDef *hospi));
+
+void HAL_OSPI_CmdCpltCallback(OSPI_HandleTypeDef *hospi);
+void HAL_OSPI_RxCpltCallback(OSPI_HandleTypeDef *hospi);
+void HAL_OSPI_TxCpltCallback(OSPI_HandleTypeDef *hospi);
+void HAL_OSPI_StatusMatchCallback(OSPI_HandleTypeDef *hospi);
+void HAL_OSPI_ErrorCallback(OSPI_HandleTypeDef *hospi);
+
+/**
+ * @brief Attach memory model
+ */
+void HOST_OSPI_Attach(OSPI_HandleTypeDef *hospi, host_ospi_dev_t *dev);
+
+#endif    // HOST_HAL_OSPI_H
@@ -0,0 +1,36 @@
+/**
+ * @file host_hal_rcc.h
+ * @brief Reset and clock control of the host HAL. Only reset flags are modelled.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#ifndef HOST_HAL_RCC_H
+#define HOST_HAL_RCC_H
+
+#include "host_hal_def.h"
+
+#define RCC_CSR_RMVF     (0x00800000U)
+#define RCC_CSR_OBLRSTF  (0x02000000U)
+#define RCC_CSR_PINRSTF  (0x04000000U)
+#define RCC_CSR_BORRSTF  (0x08000000U)
+#define RCC_CSR_SFTRSTF  (0x10000000U)
+#define RCC_CSR_IWDGRSTF (0x20000000U)
+#define RCC_CSR_WWDGRSTF (0x40000000U)
+#define RCC_CSR_LPWRRSTF (0x80000000U)
+
+typedef struct {
+    __IO uint32_t CSR;
+} RCC_TypeDef;
+
+extern RCC_TypeDef HOST_RCC;
+
+#define RCC (&HOST_RCC)
+
+#define __HAL_RCC_CLEAR_RESET_FLAGS() (RCC->CSR &= ~(RCC_CSR_OBLRSTF | RCC_CSR_PINRSTF | RCC_CSR_BORRSTF | \
+                                                      RCC_CSR_SFTRSTF | RCC_CSR_IWDGRSTF | RCC_CSR_WWDGRSTF |  \
+                                                      RCC_CSR_LPWRRSTF))
+
+#endif    // HOST_HAL_RCC_H
@@ -0,0 +1,97 @@
+/**
+ * @file host_hal_spi.h
+ * @brief SPI master of the host HAL.
+ *        Devices are attached to the bus with their chip select pin, data is
+ *        exchanged with the selected devices when the transfer completes.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#ifndef HOST_HAL_SPI_H
+#define HOST_HAL_SPI_H
+
+#include "host_hal_def.h"
+#include "host_hal_gpio.h"
+
+#define HAL_SPI_ERROR_NONE (0x00000000U)
+
+typedef struct {
+    uint32_t id;
+} SPI_TypeDef;
+
+extern SPI_TypeDef HOST_SPI1, HOST_SPI2, HOST_SPI3;
+
+#define SPI1 (&HOST_SPI1)
+#define SPI2 (&HOST_SPI2)
+#define SPI3 (&HOST_SPI3)
+
+typedef struct host_spi_dev host_spi_dev_t;
+
+/**
+ * @brief Device model attached to the bus
+ */
+struct host_spi_dev {
+    GPIO_TypeDef *cs_port;
+    uint16_t      cs_pin;
+    /* chip select edge, active - NSS is low */
+    void (*select)(host_spi_dev_t *dev, uint8_t active);
+    /* full duplex exchange while selected, tx or rx may be NULL */
+    void (*xfer)(host_spi_dev_t *dev, const uint8_t *tx, uint8_t *rx, uint16_t size);
+
+    uint8_t              selected;
+    host_gpio_listener_t cs;
+    host_spi_dev_t      *next;
+};
+
+typedef struct __SPI_HandleTypeDef {
+    SPI_TypeDef     *Instance;
+    host_hal_state_t State;
+    uint32_t         ErrorCode;
+    void (*TxCpltCallback)(struct __SPI_HandleTypeDef *hspi);
+    void (*RxCpltCallback)(struct __SPI_HandleTypeDef *hspi);
+    void (*TxRxCpltCallback)(struct __SPI_HandleTypeDef *hspi);
+    void (*ErrorCallback)(struct __SPI_HandleTypeDef *hspi);
+
+    /* simulation state */
+    host_spi_dev_t *devs;
+    host_event_t    done;
+    const uint8_t  *tx;
+    uint8_t        *rx;
+    uint16_t        size;
+    void (*cplt)(struct __SPI_HandleTypeDef *hspi);
+} SPI_HandleTypeDef;
+
+#define HAL_SPI_TX_COMPLETE_CB_ID   (0x00U)
+#define HAL_SPI_RX_COMPLETE_CB_ID   (0x01U)
+#define HAL_SPI_TX_RX_COMPLETE_CB_ID (0x02U)
+#define HAL_SPI_ERROR_CB_ID         (0x06U)
+
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef *hspi);
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData,
+                                          uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_Transmit_IT(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_Receive_IT(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_IT(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData,
+                                             uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_Receive_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData,
+                                              uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_RegisterCallback(SPI_HandleTypeDef *hspi, uint32_t CallbackID,
+                                           void (*pCallback)(SPI_HandleTypeDef *hspi));
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi);
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi);
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi);
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi);
+
+/**
+ * @brief Attach device model to the bus
+ */
+void HOST_SPI_Attach(SPI_HandleTypeDef *hspi, host_spi_dev_t *dev);
+
+#endif    // HOST_HAL_SPI_H
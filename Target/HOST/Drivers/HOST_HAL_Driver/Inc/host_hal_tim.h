@@ -0,0 +1,139 @@
+/**
+ * @file host_hal_tim.h
+ * @brief Basic and PWM timers of the host HAL.
+ *        The counter is derived from virtual time, so reading it and changing
+ *        CNT/ARR at any moment behaves as on the hardware.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#ifndef HOST_HAL_TIM_H
+#define HOST_HAL_TIM_H
+
+#include "host_hal_def.h"
+
+/* kernel clock of all timers, same as APB clocks of DEVBOARD */
+#ifndef HOST_TIM_CLOCK_HZ
+#define HOST_TIM_CLOCK_HZ (160000000U)
+#endif
+
+#define TIM_CHANNEL_1   (0x00000000U)
+#define TIM_CHANNEL_2   (0x00000004U)
+#define TIM_CHANNEL_3   (0x00000008U)
+#define TIM_CHANNEL_4   (0x0000000CU)
+#define TIM_CHANNEL_ALL (0x0000003CU)
+
+#define TIM_COUNTERMODE_UP             (0x00000000U)
+#define TIM_CLOCKDIVISION_DIV1         (0x00000000U)
+#define TIM_AUTORELOAD_PRELOAD_DISABLE (0x00000000U)
+#define TIM_AUTORELOAD_PRELOAD_ENABLE  (0x00000080U)
+
+#define TIM_EVENTSOURCE_UPDATE (0x00000001U)
+
+typedef enum {
+    HAL_TIM_ACTIVE_CHANNEL_1 = 0x01U,
+    HAL_TIM_ACTIVE_CHANNEL_2 = 0x02U,
+    HAL_TIM_ACTIVE_CHANNEL_3 = 0x04U,
+    HAL_TIM_ACTIVE_CHANNEL_4 = 0x08U,
+    HAL_TIM_ACTIVE_CHANNEL_CLEARED = 0x00U
+} HAL_TIM_ActiveChannel;
+
+/**
+ * @brief Register block. CNT is only meaningful through __HAL_TIM_GET_COUNTER()
+ */
+typedef struct {
+    __IO uint32_t CR1;
+    __IO uint32_t DIER;
+    __IO uint32_t SR;
+    __IO uint32_t CNT;
+    __IO uint32_t PSC;
+    __IO uint32_t ARR;
+    __IO uint32_t CCR1;
+    __IO uint32_t CCR2;
+    __IO uint32_t CCR3;
+    __IO uint32_t CCR4;
+    uint32_t      width; /* counter width, bits */
+} TIM_TypeDef;
+
+extern TIM_TypeDef HOST_TIM2, HOST_TIM3, HOST_TIM4, HOST_TIM7, HOST_TIM17;
+
+#define TIM2  (&HOST_TIM2)
+#define TIM3  (&HOST_TIM3)
+#define TIM4  (&HOST_TIM4)
+#define TIM7  (&HOST_TIM7)
+#define TIM17 (&HOST_TIM17)
+
+typedef struct {
+    uint32_t Prescaler;
+    uint32_t CounterMode;
+    uint32_t Period;
+    uint32_t ClockDivision;
+    uint32_t RepetitionCounter;
+    uint32_t AutoReloadPreload;
+} TIM_Base_InitTypeDef;
+
+typedef struct __TIM_HandleTypeDef {
+    TIM_TypeDef          *Instance;
+    TIM_Base_InitTypeDef  Init;
+    HAL_TIM_ActiveChannel Channel;
+    host_hal_state_t      State;
+    void (*PeriodElapsedCallback)(struct __TIM_HandleTypeDef *htim);
+    void (*PWM_PulseFinishedCallback)(struct __TIM_HandleTypeDef *htim);
+
+    /* simulation state */
+    host_event_t                update;
+    uint64_t                    t0;       /* time of the last counter reload */
+    uint32_t                    cnt0;     /* counter value at t0 */
+    uint32_t                    arr_seen; /* ARR the update event is armed for */
+    uint32_t                    psc_seen;
+    uint8_t                     it;       /* update interrupt enabled */
+    uint8_t                     pwm_it;   /* channels with pulse interrupt */
+    int32_t                     ppm;      /* clock deviation of the board */
+    struct __TIM_HandleTypeDef *next;
+} TIM_HandleTypeDef;
+
+#define HAL_TIM_CB_PERIOD_ELAPSED   (0x00U)
+#define HAL_TIM_CB_PWM_PULSE_FINISH (0x01U)
+
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Stop(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_PWM_Init(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_PWM_Start_IT(TIM_HandleTypeDef *htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_PWM_Stop(TIM_HandleTypeDef *htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_PWM_Stop_IT(TIM_HandleTypeDef *htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_GenerateEvent(TIM_HandleTypeDef *htim, uint32_t EventSource);
+HAL_StatusTypeDef HAL_TIM_RegisterCallback(TIM_HandleTypeDef *htim, uint32_t CallbackID,
+                                           void (*pCallback)(TIM_HandleTypeDef *htim));
+
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim);
+void HAL_TIM_PWM_PulseFinishedCallback(TIM_HandleTypeDef *htim);
+
+uint32_t HOST_TIM_GetCounter(TIM_HandleTypeDef *htim);
+void     HOST_TIM_SetCounter(TIM_HandleTypeDef *htim, uint32_t cnt);
+
+/**
+ * @brief Virtual time of the given number of counter ticks
+ */
+uint64_t HOST_TIM_TicksToNs(TIM_HandleTypeDef *htim, uint64_t ticks);
+
+#define __HAL_TIM_GET_COUNTER(__HANDLE__)       HOST_TIM_GetCounter(__HANDLE__)
+#define __HAL_TIM_SET_COUNTER(__HANDLE__, __C__) HOST_TIM_SetCounter((__HANDLE__), (__C__))
+#define __HAL_TIM_GET_AUTORELOAD(__HANDLE__)    ((__HANDLE__)->Instance->ARR)
+#define __HAL_TIM_SET_AUTORELOAD(__HANDLE__, __AUTORELOAD__)  \
+    do {                                                      \
+        (__HANDLE__)->Instance->ARR = (__AUTORELOAD__);       \
+        (__HANDLE__)->Init.Period = (__AUTORELOAD__);         \
+    } while (0)
+#define __HAL_TIM_SetAutoreload __HAL_TIM_SET_AUTORELOAD
+#define __HAL_TIM_SET_COMPARE(__HANDLE__, __CHANNEL__, __COMPARE__) \
+    (*(&(__HANDLE__)->Instance->CCR1 + ((__CHANNEL__) >> 2)) = (__COMPARE__))
+#define __HAL_TIM_GET_COMPARE(__HANDLE__, __CHANNEL__) (*(&(__HANDLE__)->Instance->CCR1 + ((__CHANNEL__) >> 2)))
+#define __HAL_TIM_SET_PRESCALER(__HANDLE__, __PRESC__) ((__HANDLE__)->Instance->PSC = (__PRESC__))
+
+#endif    // HOST_HAL_TIM_H
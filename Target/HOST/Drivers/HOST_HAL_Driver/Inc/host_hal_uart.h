@@ -0,0 +1,114 @@
+/**
+ * @file host_hal_uart.h
+ * @brief UART of the host HAL.
+ *        Transmitted data goes to a sink (stdout for the console), received
+ *        data is injected by models or by the simulator console.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#ifndef HOST_HAL_UART_H
+#define HOST_HAL_UART_H
+
+#include "host_hal_def.h"
+
+#define HAL_UART_ERROR_NONE (0x00000000U)
+
+#define UART_WORDLENGTH_8B  (0x00000000U)
+#define UART_STOPBITS_1     (0x00000000U)
+#define UART_PARITY_NONE    (0x00000000U)
+#define UART_MODE_TX_RX     (0x0000000CU)
+#define UART_HWCONTROL_NONE (0x00000000U)
+
+#ifndef HOST_UART_RX_FIFO_SIZE
+#define HOST_UART_RX_FIFO_SIZE (1024U)
+#endif
+
+typedef struct {
+    uint32_t id;
+} USART_TypeDef;
+
+extern USART_TypeDef HOST_LPUART1, HOST_USART1, HOST_USART2, HOST_USART3;
+
+#define LPUART1 (&HOST_LPUART1)
+#define USART1  (&HOST_USART1)
+#define USART2  (&HOST_USART2)
+#define USART3  (&HOST_USART3)
+
+typedef struct {
+    uint32_t BaudRate;
+    uint32_t WordLength;
+    uint32_t StopBits;
+    uint32_t Parity;
+    uint32_t Mode;
+    uint32_t HwFlowCtl;
+} UART_InitTypeDef;
+
+/**
+ * @brief Receive DMA channel, only the remaining counter is modelled
+ */
+typedef struct {
+    __IO uint32_t remaining;
+} DMA_HandleTypeDef;
+
+#define __HAL_DMA_GET_COUNTER(__HANDLE__) ((__HANDLE__)->remaining)
+
+typedef struct __UART_HandleTypeDef {
+    USART_TypeDef     *Instance;
+    UART_InitTypeDef   Init;
+    DMA_HandleTypeDef *hdmarx;
+    host_hal_state_t   gState;
+    host_hal_state_t   RxState;
+    __IO uint32_t      ErrorCode;
+    void (*TxCpltCallback)(struct __UART_HandleTypeDef *huart);
+    void (*RxCpltCallback)(struct __UART_HandleTypeDef *huart);
+    void (*RxHalfCpltCallback)(struct __UART_HandleTypeDef *huart);
+    void (*ErrorCallback)(struct __UART_HandleTypeDef *huart);
+
+    /* simulation state */
+    void (*sink)(struct __UART_HandleTypeDef *huart, const uint8_t *data, uint16_t size);
+    DMA_HandleTypeDef dmarx;
+    host_event_t      tx_done;
+    host_event_t      rx_byte;
+    uint8_t           fifo[HOST_UART_RX_FIFO_SIZE];
+    uint32_t          fifo_head;
+    uint32_t          fifo_tail;
+    uint8_t          *rx_buf;
+    uint16_t          rx_size;
+    uint16_t          rx_pos;
+    uint8_t           rx_circular;
+} UART_HandleTypeDef;
+
+#define HAL_UART_TX_COMPLETE_CB_ID      (0x01U)
+#define HAL_UART_RX_HALFCOMPLETE_CB_ID  (0x02U)
+#define HAL_UART_RX_COMPLETE_CB_ID      (0x03U)
+#define HAL_UART_ERROR_CB_ID            (0x04U)
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Receive_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_RegisterCallback(UART_HandleTypeDef *huart, uint32_t CallbackID,
+                                            void (*pCallback)(UART_HandleTypeDef *huart));
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_RxHalfCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart);
+
+/**
+ * @brief Set consumer of transmitted data
+ */
+void HOST_UART_Sink(UART_HandleTypeDef *huart, void (*sink)(UART_HandleTypeDef *huart, const uint8_t *data,
+                                                            uint16_t size));
+
+/**
+ * @brief Put data on the RX line. Bytes arrive at the configured baud rate.
+ */
+void HOST_UART_Inject(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t size);
+
+#endif    // HOST_HAL_UART_H
@@ -0,0 +1,30 @@
+/**
+ * @file host_ll_utils.h
+ * @brief Device identification of the host HAL (stm32xxxx_ll_utils.h counterpart).
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#ifndef HOST_LL_UTILS_H
+#define HOST_LL_UTILS_H
+
+#include <stdint.h>
+
+/* unique device ID, set by the simulator for every simulated board */
+extern uint32_t HOST_UID[3];
+
+static inline uint32_t LL_GetUID_Word0(void) {
+    return HOST_UID[0];
+}
+
+static inline uint32_t LL_GetUID_Word1(void) {
+    return HOST_UID[1];
+}
+
+static inline uint32_t LL_GetUID_Word2(void) {
+    return HOST_UID[2];
+}
+
+#endif    // HOST_LL_UTILS_H
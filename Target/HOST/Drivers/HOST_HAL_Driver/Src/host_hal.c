@@ -0,0 +1,75 @@
+/**
+ * @file host_hal.c
+ * @brief Common part of the host HAL
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#include "host_hal.h"
+#include "host_core.h"
+#include "host_ll_utils.h"
+
+#define HOST_CORE_CLOCK_MHZ (160U)
+
+void HOST_GPIO_Sync(void);
+void HOST_TIM_Sync(void);
+
+__IO uint32_t uwTick;
+
+uint32_t HOST_UID[3] = { 0x00480037U, 0x31325111U, 0x34383730U };
+
+RCC_TypeDef    HOST_RCC = { .CSR = RCC_CSR_BORRSTF | RCC_CSR_PINRSTF };
+DWT_Type       HOST_DWT;
+CoreDebug_Type HOST_CoreDebug;
+
+static void coreSync(void) {
+    if ((HOST_CoreDebug.DEMCR & CoreDebug_DEMCR_TRCENA_Msk) && (HOST_DWT.CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        HOST_DWT.CYCCNT = HOST_Now() * HOST_CORE_CLOCK_MHZ / HOST_NS_PER_US;
+    }
+}
+
+HAL_StatusTypeDef HAL_Init(void) {
+    HOST_SyncRegister(HOST_GPIO_Sync);
+    HOST_SyncRegister(HOST_TIM_Sync);
+    HOST_SyncRegister(coreSync);
+    return HAL_OK;
+}
+
+void HAL_IncTick(void) {
+    ++uwTick;
+}
+
+uint32_t HAL_GetTick(void) {
+    return uwTick;
+}
+
+void HAL_Delay(uint32_t Delay) {
+    HOST_Spin((uint64_t) Delay * HOST_NS_PER_MS);
+}
+
+char *itoa(int value, char *str, int base) {
+    unsigned int v = (value < 0 && base == 10) ? -(unsigned int) value : (unsigned int) value;
+    char        *p = str, *q;
+    char         c;
+
+    if (base < 2 || base > 36) {
+        *str = '\0';
+        return str;
+    }
+    do {
+        *p++ = "0123456789abcdefghijklmnopqrstuvwxyz"[v % base];
+        v /= base;
+    } while (v);
+    if (value < 0 && base == 10) {
+        *p++ = '-';
+    }
+    *p = '\0';
+    for (q = str, --p; q < p; ++q, --p) {
+        c = *q;
+        *q = *p;
+        *p = c;
+    }
+    return str;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file host_hal_gpio.c
+ * @brief GPIO and EXTI of the host HAL
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#include "host_hal.h"
+
+#define PORT_INIT                                                                                 \
+    {                                                                                             \
+        .RisingCallback = HAL_GPIO_EXTI_Rising_Callback,                                          \
+        .FallingCallback = HAL_GPIO_EXTI_Falling_Callback                                         \
+    }
+
+GPIO_TypeDef HOST_GPIOA = PORT_INIT, HOST_GPIOB = PORT_INIT, HOST_GPIOC = PORT_INIT, HOST_GPIOD = PORT_INIT,
+             HOST_GPIOE = PORT_INIT;
+
+static GPIO_TypeDef *const ports[] = { GPIOA, GPIOB, GPIOC, GPIOD, GPIOE };
+
+static void notify(GPIO_TypeDef *GPIOx) {
+    uint16_t changed = GPIOx->ODR ^ GPIOx->odr_seen;
+    if (!changed) {
+        return;
+    }
+    GPIOx->odr_seen = GPIOx->ODR;
+    for (host_gpio_listener_t *l = GPIOx->listeners; l != NULL; l = l->next) {
+        if (l->mask & changed) {
+            l->changed(l, l->mask & changed, GPIOx->ODR);
+        }
+    }
+}
+
+/* applies plain stores to BSRR/BRR (PIN_SET() and PIN_RESET() of main.h) */
+void HOST_GPIO_Sync(void) {
+    for (uint8_t i = 0; i < sizeof(ports) / sizeof(*ports); ++i) {
+        GPIO_TypeDef *GPIOx = ports[i];
+        if (GPIOx->BSRR || GPIOx->BRR) {
+            GPIOx->ODR = (GPIOx->ODR | (GPIOx->BSRR & 0xFFFFU)) & ~((GPIOx->BSRR >> 16) | GPIOx->BRR);
+            GPIOx->BSRR = GPIOx->BRR = 0;
+        }
+        notify(GPIOx);
+    }
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState) {
+    if (PinState != GPIO_PIN_RESET) {
+        GPIOx->ODR |= GPIO_Pin;
+    } else {
+        GPIOx->ODR &= ~(uint32_t) GPIO_Pin;
+    }
+    notify(GPIOx);
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin) {
+    return ((GPIOx->IDR | GPIOx->ODR) & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin) {
+    GPIOx->ODR ^= GPIO_Pin;
+    notify(GPIOx);
+}
+
+__weak void HAL_GPIO_EXTI_Rising_Callback(uint16_t GPIO_Pin) {
+    UNUSED(GPIO_Pin);
+}
+
+__weak void HAL_GPIO_EXTI_Falling_Callback(uint16_t GPIO_Pin) {
+    UNUSED(GPIO_Pin);
+}
+
+void HOST_GPIO_Listen(GPIO_TypeDef *GPIOx, host_gpio_listener_t *l) {
+    l->next = GPIOx->listeners;
+    GPIOx->listeners = l;
+}
+
+void HOST_GPIO_Drive(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState) {
+    uint32_t idr = (PinState != GPIO_PIN_RESET) ? (GPIOx->IDR | GPIO_Pin) : (GPIOx->IDR & ~(uint32_t) GPIO_Pin);
+    uint16_t changed = idr ^ GPIOx->IDR;
+
+    GPIOx->IDR = idr;
+    for (uint16_t pin = 1; changed; pin <<= 1) {
+        if (changed & pin) {
+            changed &= ~pin;
+            if (idr & pin) {
+                GPIOx->RisingCallback(pin);
+            } else {
+                GPIOx->FallingCallback(pin);
+            }
+        }
+    }
+}
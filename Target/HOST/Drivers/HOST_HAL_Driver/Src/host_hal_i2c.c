@@ -0,0 +1,244 @@
+/**
+ * @file host_hal_i2c.c
+ * @brief I2C master of the host HAL
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#include "host_hal.h"
+
+I2C_TypeDef HOST_I2C1 = { 1 }, HOST_I2C3 = { 3 };
+
+/* start + address + data bytes with ACK bits + stop */
+static uint64_t xferTime(uint16_t size) {
+    return HOST_XFER_NS(2U + 9U * (1U + size), HOST_Latency.i2c_hz);
+}
+
+static host_i2c_dev_t *find(I2C_HandleTypeDef *hi2c, uint16_t addr) {
+    for (host_i2c_dev_t *dev = hi2c->devs; dev != NULL; dev = dev->next) {
+        if ((dev->addr & 0xFEU) == (addr & 0xFEU)) {
+            return dev;
+        }
+    }
+    return NULL;
+}
+
+/* performs the bus transaction, returns its duration */
+static HAL_StatusTypeDef transfer(I2C_HandleTypeDef *hi2c, uint16_t addr, int32_t mem, uint16_t mem_size,
+                                  uint8_t *data, uint16_t size, uint8_t read, uint64_t *time) {
+    host_i2c_dev_t *dev = find(hi2c, addr);
+    uint8_t         mem_bytes[2] = { mem >> 8, mem };
+
+    *time = xferTime(size) + ((mem >= 0) ? xferTime(mem_size) : 0);
+    if (dev == NULL) {
+        *time = xferTime(0);
+        return HAL_ERROR;
+    }
+    if (mem >= 0 && dev->write(dev, mem_bytes + 2 - mem_size, mem_size) != HAL_OK) {
+        return HAL_ERROR;
+    }
+    return read ? dev->read(dev, data, size) : dev->write(dev, data, size);
+}
+
+static HAL_StatusTypeDef blocking(I2C_HandleTypeDef *hi2c, uint16_t addr, int32_t mem, uint16_t mem_size,
+                                  uint8_t *data, uint16_t size, uint8_t read) {
+    HAL_StatusTypeDef st;
+    uint64_t          time;
+
+    if (hi2c->State != HOST_HAL_STATE_READY) {
+        return HAL_BUSY;
+    }
+    hi2c->State = HOST_HAL_STATE_BUSY;
+    st = transfer(hi2c, addr, mem, mem_size, data, size, read, &time);
+    HOST_Spin(time);
+    hi2c->ErrorCode = (st == HAL_OK) ? HAL_I2C_ERROR_NONE : HAL_I2C_ERROR_AF;
+    hi2c->State = HOST_HAL_STATE_READY;
+    return st;
+}
+
+static void done(host_event_t *ev) {
+    I2C_HandleTypeDef *hi2c = HOST_CONTAINER_OF(ev, I2C_HandleTypeDef, done);
+
+    hi2c->State = HOST_HAL_STATE_READY;
+    if (hi2c->nack) {
+        hi2c->ErrorCode = HAL_I2C_ERROR_AF;
+        hi2c->ErrorCallback(hi2c);
+    } else {
+        hi2c->cplt(hi2c);
+    }
+}
+
+/* data is exchanged at start, the model sees the transaction a bit earlier than the hardware would */
+static HAL_StatusTypeDef async(I2C_HandleTypeDef *hi2c, uint16_t addr, int32_t mem, uint16_t mem_size, uint8_t *data,
+                               uint16_t size, uint8_t read, uint32_t setup, void (*cplt)(I2C_HandleTypeDef *hi2c)) {
+    uint64_t time;
+
+    if (hi2c->State != HOST_HAL_STATE_READY) {
+        return HAL_BUSY;
+    }
+    hi2c->State = HOST_HAL_STATE_BUSY;
+    hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+    hi2c->nack = transfer(hi2c, addr, mem, mem_size, data, size, read, &time) != HAL_OK;
+    hi2c->cplt = cplt;
+    HOST_EventArmIn(&hi2c->done, setup + time + HOST_Latency.irq_ns);
+    return HAL_OK;
+}
+
+static void masterTxCplt(I2C_HandleTypeDef *hi2c) {
+    hi2c->MasterTxCpltCallback(hi2c);
+}
+
+static void masterRxCplt(I2C_HandleTypeDef *hi2c) {
+    hi2c->MasterRxCpltCallback(hi2c);
+}
+
+static void memTxCplt(I2C_HandleTypeDef *hi2c) {
+    hi2c->MemTxCpltCallback(hi2c);
+}
+
+static void memRxCplt(I2C_HandleTypeDef *hi2c) {
+    hi2c->MemRxCpltCallback(hi2c);
+}
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c) {
+    if (hi2c == NULL || hi2c->Instance == NULL) {
+        return HAL_ERROR;
+    }
+    if (hi2c->State == HOST_HAL_STATE_RESET) {
+        hi2c->MasterTxCpltCallback = HAL_I2C_MasterTxCpltCallback;
+        hi2c->MasterRxCpltCallback = HAL_I2C_MasterRxCpltCallback;
+        hi2c->MemTxCpltCallback = HAL_I2C_MemTxCpltCallback;
+        hi2c->MemRxCpltCallback = HAL_I2C_MemRxCpltCallback;
+        hi2c->ErrorCallback = HAL_I2C_ErrorCallback;
+        hi2c->AbortCpltCallback = HAL_I2C_AbortCpltCallback;
+        HOST_EventInit(&hi2c->done, done);
+    }
+    hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+    hi2c->State = HOST_HAL_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size,
+                                          uint32_t Timeout) {
+    UNUSED(Timeout);
+    return blocking(hi2c, DevAddress, -1, 0, pData, Size, 0);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size,
+                                         uint32_t Timeout) {
+    UNUSED(Timeout);
+    return blocking(hi2c, DevAddress, -1, 0, pData, Size, 1);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                    uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout) {
+    UNUSED(Timeout);
+    return blocking(hi2c, DevAddress, MemAddress, MemAddSize, pData, Size, 0);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                   uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout) {
+    UNUSED(Timeout);
+    return blocking(hi2c, DevAddress, MemAddress, MemAddSize, pData, Size, 1);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                             uint16_t Size) {
+    return async(hi2c, DevAddress, -1, 0, pData, Size, 0, 0, masterTxCplt);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                            uint16_t Size) {
+    return async(hi2c, DevAddress, -1, 0, pData, Size, 1, 0, masterRxCplt);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                       uint16_t MemAddSize, uint8_t *pData, uint16_t Size) {
+    return async(hi2c, DevAddress, MemAddress, MemAddSize, pData, Size, 0, 0, memTxCplt);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                      uint16_t MemAddSize, uint8_t *pData, uint16_t Size) {
+    return async(hi2c, DevAddress, MemAddress, MemAddSize, pData, Size, 1, 0, memRxCplt);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                              uint16_t Size) {
+    return async(hi2c, DevAddress, -1, 0, pData, Size, 0, HOST_Latency.dma_ns, masterTxCplt);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                             uint16_t Size) {
+    return async(hi2c, DevAddress, -1, 0, pData, Size, 1, HOST_Latency.dma_ns, masterRxCplt);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                        uint16_t MemAddSize, uint8_t *pData, uint16_t Size) {
+    return async(hi2c, DevAddress, MemAddress, MemAddSize, pData, Size, 0, HOST_Latency.dma_ns, memTxCplt);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                       uint16_t MemAddSize, uint8_t *pData, uint16_t Size) {
+    return async(hi2c, DevAddress, MemAddress, MemAddSize, pData, Size, 1, HOST_Latency.dma_ns, memRxCplt);
+}
+
+HAL_StatusTypeDef HAL_I2C_RegisterCallback(I2C_HandleTypeDef *hi2c, uint32_t CallbackID,
+                                           void (*pCallback)(I2C_HandleTypeDef *hi2c)) {
+    if (pCallback == NULL) {
+        return HAL_ERROR;
+    }
+    switch (CallbackID) {
+        case HAL_I2C_MASTER_TX_COMPLETE_CB_ID:
+            hi2c->MasterTxCpltCallback = pCallback;
+            break;
+        case HAL_I2C_MASTER_RX_COMPLETE_CB_ID:
+            hi2c->MasterRxCpltCallback = pCallback;
+            break;
+        case HAL_I2C_MEM_TX_COMPLETE_CB_ID:
+            hi2c->MemTxCpltCallback = pCallback;
+            break;
+        case HAL_I2C_MEM_RX_COMPLETE_CB_ID:
+            hi2c->MemRxCpltCallback = pCallback;
+            break;
+        case HAL_I2C_ERROR_CB_ID:
+            hi2c->ErrorCallback = pCallback;
+            break;
+        case HAL_I2C_ABORT_CB_ID:
+            hi2c->AbortCpltCallback = pCallback;
+            break;
+        default:
+            return HAL_ERROR;
+    }
+    return HAL_OK;
+}
+
+__weak void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c) {
+    UNUSED(hi2c);
+}
+
+__weak void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c) {
+    UNUSED(hi2c);
+}
+
+__weak void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c) {
+    UNUSED(hi2c);
+}
+
+__weak void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c) {
+    UNUSED(hi2c);
+}
+
+__weak void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) {
+    UNUSED(hi2c);
+}
+
+__weak void HAL_I2C_AbortCpltCallback(I2C_HandleTypeDef *hi2c) {
+    UNUSED(hi2c);
+}
+
+void HOST_I2C_Attach(I2C_HandleTypeDef *hi2c, host_i2c_dev_t *dev) {
+    dev->next = hi2c->devs;
+    hi2c->devs = dev;
+}
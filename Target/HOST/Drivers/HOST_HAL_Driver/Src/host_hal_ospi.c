@@ -0,0 +1,298 @@
+/**
+ * @file host_hal_ospi.c
+ * @brief OCTOSPI of the host HAL
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#include <string.h>
+
+#include "host_hal.h"
+
+OCTOSPI_TypeDef HOST_OCTOSPI1 = { 1, NULL };
+
+static inline uint32_t lines(uint32_t mode) {
+    return mode ? 1U << (mode - 1) : 0;
+}
+
+/* bus cycles of the command with its data phase */
+static uint64_t cmdTime(const OSPI_RegularCmdTypeDef *cmd) {
+    uint32_t cycles = cmd->DummyCycles;
+    uint32_t l;
+
+    if ((l = lines(cmd->InstructionMode)) != 0) {
+        cycles += (8U << (cmd->InstructionSize >> 4)) / l;
+    }
+    if ((l = lines(cmd->AddressMode >> 8)) != 0) {
+        cycles += (8U * ((cmd->AddressSize >> 12) + 1)) / l;
+    }
+    if ((l = lines(cmd->DataMode >> 24)) != 0) {
+        cycles += (8U * cmd->NbData + l - 1) / l;
+    }
+    return HOST_XFER_NS(cycles, HOST_Latency.ospi_hz);
+}
+
+static void exec(OSPI_HandleTypeDef *hospi, const uint8_t *tx, uint8_t *rx) {
+    if (rx != NULL) {
+        memset(rx, 0xFF, hospi->cmd.NbData);
+    }
+    if (hospi->dev != NULL) {
+        hospi->dev->exec(hospi->dev, &hospi->cmd, tx, rx);
+    }
+}
+
+static void done(host_event_t *ev) {
+    OSPI_HandleTypeDef *hospi = HOST_CONTAINER_OF(ev, OSPI_HandleTypeDef, done);
+
+    exec(hospi, hospi->tx, hospi->rx);
+    hospi->State = HOST_HAL_STATE_READY;
+    hospi->cplt(hospi);
+}
+
+static uint8_t matched(OSPI_HandleTypeDef *hospi) {
+    uint32_t status = 0;
+
+    exec(hospi, NULL, (uint8_t *) &status);
+    status &= hospi->poll.Mask;
+    if (hospi->poll.MatchMode == HAL_OSPI_MATCH_MODE_OR) {
+        return (status & hospi->poll.Match) != 0;
+    }
+    return status == hospi->poll.Match;
+}
+
+/* time the next status read could match */
+static uint64_t nextPoll(OSPI_HandleTypeDef *hospi) {
+    uint64_t next = HOST_Now() + cmdTime(&hospi->cmd) + HOST_XFER_NS(hospi->poll.Interval, HOST_Latency.ospi_hz);
+    uint64_t change = (hospi->dev != NULL) ? hospi->dev->next_change(hospi->dev) : 0;
+
+    if (change == 0) {
+        return 0;
+    }
+    return (change > next) ? change : next;
+}
+
+static void pollDone(host_event_t *ev) {
+    OSPI_HandleTypeDef *hospi = HOST_CONTAINER_OF(ev, OSPI_HandleTypeDef, done);
+    uint64_t            next;
+
+    if (matched(hospi)) {
+        hospi->State = HOST_HAL_STATE_READY;
+        hospi->StatusMatchCallback(hospi);
+    } else if ((next = nextPoll(hospi)) != 0) {
+        HOST_EventArm(&hospi->done, next);
+    }
+}
+
+static HAL_StatusTypeDef async(OSPI_HandleTypeDef *hospi, const uint8_t *tx, uint8_t *rx, uint32_t setup,
+                               void (*cplt)(OSPI_HandleTypeDef *hospi)) {
+    if (hospi->State != HOST_HAL_STATE_READY) {
+        return HAL_BUSY;
+    }
+    hospi->State = HOST_HAL_STATE_BUSY;
+    hospi->tx = tx;
+    hospi->rx = rx;
+    hospi->cplt = cplt;
+    hospi->done.fn = done;
+    HOST_EventArmIn(&hospi->done, setup + cmdTime(&hospi->cmd) + HOST_Latency.irq_ns);
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef blocking(OSPI_HandleTypeDef *hospi, const uint8_t *tx, uint8_t *rx) {
+    if (hospi->State != HOST_HAL_STATE_READY) {
+        return HAL_BUSY;
+    }
+    hospi->State = HOST_HAL_STATE_BUSY;
+    HOST_Spin(cmdTime(&hospi->cmd));
+    exec(hospi, tx, rx);
+    hospi->State = HOST_HAL_STATE_READY;
+    return HAL_OK;
+}
+
+static void cmdCplt(OSPI_HandleTypeDef *hospi) {
+    hospi->CmdCpltCallback(hospi);
+}
+
+static void txCplt(OSPI_HandleTypeDef *hospi) {
+    hospi->TxCpltCallback(hospi);
+}
+
+static void rxCplt(OSPI_HandleTypeDef *hospi) {
+    hospi->RxCpltCallback(hospi);
+}
+
+HAL_StatusTypeDef HAL_OSPI_Init(OSPI_HandleTypeDef *hospi) {
+    if (hospi == NULL || hospi->Instance == NULL) {
+        return HAL_ERROR;
+    }
+    if (hospi->State == HOST_HAL_STATE_RESET) {
+        hospi->CmdCpltCallback = HAL_OSPI_CmdCpltCallback;
+        hospi->RxCpltCallback = HAL_OSPI_RxCpltCallback;
+        hospi->TxCpltCallback = HAL_OSPI_TxCpltCallback;
+        hospi->StatusMatchCallback = HAL_OSPI_StatusMatchCallback;
+        hospi->ErrorCallback = HAL_OSPI_ErrorCallback;
+        HOST_EventInit(&hospi->done, done);
+    }
+    hospi->ErrorCode = HAL_OSPI_ERROR_NONE;
+    hospi->State = HOST_HAL_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_OSPI_Command(OSPI_HandleTypeDef *hospi, OSPI_RegularCmdTypeDef *cmd, uint32_t Timeout) {
+    UNUSED(Timeout);
+    if (hospi->State != HOST_HAL_STATE_READY) {
+        return HAL_BUSY;
+    }
+    /* configuration of memory-mapped mode, writes through the map are not modelled */
+    if (cmd->OperationType == HAL_OSPI_OPTYPE_READ_CFG) {
+        hospi->read_cfg = *cmd;
+        return HAL_OK;
+    }
+    if (cmd->OperationType == HAL_OSPI_OPTYPE_WRITE_CFG) {
+        return HAL_OK;
+    }
+    hospi->cmd = *cmd;
+    return (cmd->DataMode == HAL_OSPI_DATA_NONE) ? blocking(hospi, NULL, NULL) : HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_OSPI_Command_IT(OSPI_HandleTypeDef *hospi, OSPI_RegularCmdTypeDef *cmd) {
+    if (hospi->State != HOST_HAL_STATE_READY) {
+        return HAL_BUSY;
+    }
+    if (cmd->DataMode != HAL_OSPI_DATA_NONE) {
+        return HAL_ERROR;
+    }
+    hospi->cmd = *cmd;
+    return async(hospi, NULL, NULL, 0, cmdCplt);
+}
+
+HAL_StatusTypeDef HAL_OSPI_Transmit(OSPI_HandleTypeDef *hospi, uint8_t *pData, uint32_t Timeout) {
+    UNUSED(Timeout);
+    return blocking(hospi, pData, NULL);
+}
+
+HAL_StatusTypeDef HAL_OSPI_Receive(OSPI_HandleTypeDef *hospi, uint8_t *pData, uint32_t Timeout) {
+    UNUSED(Timeout);
+    return blocking(hospi, NULL, pData);
+}
+
+HAL_StatusTypeDef HAL_OSPI_Transmit_IT(OSPI_HandleTypeDef *hospi, uint8_t *pData) {
+    return async(hospi, pData, NULL, 0, txCplt);
+}
+
+HAL_StatusTypeDef HAL_OSPI_Receive_IT(OSPI_HandleTypeDef *hospi, uint8_t *pData) {
+    return async(hospi, NULL, pData, 0, rxCplt);
+}
+
+HAL_StatusTypeDef HAL_OSPI_Transmit_DMA(OSPI_HandleTypeDef *hospi, uint8_t *pData) {
+    return async(hospi, pData, NULL, HOST_Latency.dma_ns, txCplt);
+}
+
+HAL_StatusTypeDef HAL_OSPI_Receive_DMA(OSPI_HandleTypeDef *hospi, uint8_t *pData) {
+    return async(hospi, NULL, pData, HOST_Latency.dma_ns, rxCplt);
+}
+
+HAL_StatusTypeDef HAL_OSPI_AutoPolling(OSPI_HandleTypeDef *hospi, OSPI_AutoPollingTypeDef *cfg, uint32_t Timeout) {
+    uint64_t deadline = HOST_Now() + (uint64_t) Timeout * HOST_NS_PER_MS;
+    uint64_t next;
+
+    if (hospi->State != HOST_HAL_STATE_READY) {
+        return HAL_BUSY;
+    }
+    hospi->poll = *cfg;
+    HOST_Spin(cmdTime(&hospi->cmd));
+    while (!matched(hospi)) {
+        if ((next = nextPoll(hospi)) == 0 || next > deadline) {
+            hospi->ErrorCode = HAL_OSPI_ERROR_TIMEOUT;
+            return HAL_TIMEOUT;
+        }
+        HOST_Spin(next - HOST_Now());
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_OSPI_AutoPolling_IT(OSPI_HandleTypeDef *hospi, OSPI_AutoPollingTypeDef *cfg) {
+    if (hospi->State != HOST_HAL_STATE_READY) {
+        return HAL_BUSY;
+    }
+    hospi->State = HOST_HAL_STATE_BUSY;
+    hospi->poll = *cfg;
+    hospi->done.fn = pollDone;
+    HOST_EventArmIn(&hospi->done, cmdTime(&hospi->cmd) + HOST_Latency.irq_ns);
+    return HAL_OK;
+}
+
+/* the handle stays busy until HAL_OSPI_Abort(), other calls fail as on the chip */
+HAL_StatusTypeDef HAL_OSPI_MemoryMapped(OSPI_HandleTypeDef *hospi, OSPI_MemoryMappedTypeDef *cfg) {
+    uint8_t *window;
+
+    UNUSED(cfg);
+    if (hospi->State != HOST_HAL_STATE_READY) {
+        return HAL_BUSY;
+    }
+    window = (hospi->dev != NULL && hospi->dev->map != NULL) ? hospi->dev->map(hospi->dev, &hospi->read_cfg) : NULL;
+    if (window == NULL) {
+        return HAL_ERROR;
+    }
+    hospi->Instance->window = window;
+    hospi->State = HOST_HAL_STATE_BUSY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_OSPI_Abort(OSPI_HandleTypeDef *hospi) {
+    HOST_EventDisarm(&hospi->done);
+    hospi->State = HOST_HAL_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_OSPI_RegisterCallback(OSPI_HandleTypeDef *hospi, uint32_t CallbackID,
+                                            void (*pCallback)(OSPI_HandleTypeDef *hospi)) {
+    if (pCallback == NULL) {
+        return HAL_ERROR;
+    }
+    switch (CallbackID) {
+        case HAL_OSPI_RX_CPLT_CB_ID:
+            hospi->RxCpltCallback = pCallback;
+            break;
+        case HAL_OSPI_TX_CPLT_CB_ID:
+            hospi->TxCpltCallback = pCallback;
+            break;
+        case HAL_OSPI_CMD_CPLT_CB_ID:
+            hospi->CmdCpltCallback = pCallback;
+            break;
+        case HAL_OSPI_STATUS_MATCH_CB_ID:
+            hospi->StatusMatchCallback = pCallback;
+            break;
+        case HAL_OSPI_ERROR_CB_ID:
+            hospi->ErrorCallback = pCallback;
+            break;
+        default:
+            return HAL_ERROR;
+    }
+    return HAL_OK;
+}
+
+__weak void HAL_OSPI_CmdCpltCallback(OSPI_HandleTypeDef *hospi) {
+    UNUSED(hospi);
+}
+
+__weak void HAL_OSPI_RxCpltCallback(OSPI_HandleTypeDef *hospi) {
+    UNUSED(hospi);
+}
+
+__weak void HAL_OSPI_TxCpltCallback(OSPI_HandleTypeDef *hospi) {
+    UNUSED(hospi);
+}
+
+__weak void HAL_OSPI_StatusMatchCallback(OSPI_HandleTypeDef *hospi) {
+    UNUSED(hospi);
+}
+
+__weak void HAL_OSPI_ErrorCallback(OSPI_HandleTypeDef *hospi) {
+    UNUSED(hospi);
+}
+
+void HOST_OSPI_Attach(OSPI_HandleTypeDef *hospi, host_ospi_dev_t *dev) {
+    hospi->dev = dev;
+}
@@ -0,0 +1,197 @@
+/**
+ * @file host_hal_spi.c
+ * @brief SPI master of the host HAL
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#include <string.h>
+
+#include "host_hal.h"
+
+SPI_TypeDef HOST_SPI1 = { 1 }, HOST_SPI2 = { 2 }, HOST_SPI3 = { 3 };
+
+static uint64_t xferTime(uint16_t size) {
+    return HOST_XFER_NS(size * 8U, HOST_Latency.spi_hz);
+}
+
+static void exchange(SPI_HandleTypeDef *hspi, const uint8_t *tx, uint8_t *rx, uint16_t size) {
+    if (rx != NULL) {
+        memset(rx, 0xFF, size); /* MISO is pulled up when nobody drives it */
+    }
+    for (host_spi_dev_t *dev = hspi->devs; dev != NULL; dev = dev->next) {
+        if (dev->selected) {
+            dev->xfer(dev, tx, rx, size);
+        }
+    }
+}
+
+static void done(host_event_t *ev) {
+    SPI_HandleTypeDef *hspi = HOST_CONTAINER_OF(ev, SPI_HandleTypeDef, done);
+
+    exchange(hspi, hspi->tx, hspi->rx, hspi->size);
+    hspi->State = HOST_HAL_STATE_READY;
+    hspi->cplt(hspi);
+}
+
+static HAL_StatusTypeDef blocking(SPI_HandleTypeDef *hspi, const uint8_t *tx, uint8_t *rx, uint16_t size) {
+    if (hspi->State != HOST_HAL_STATE_READY) {
+        return HAL_BUSY;
+    }
+    hspi->State = HOST_HAL_STATE_BUSY;
+    HOST_Spin(xferTime(size));
+    exchange(hspi, tx, rx, size);
+    hspi->State = HOST_HAL_STATE_READY;
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef async(SPI_HandleTypeDef *hspi, const uint8_t *tx, uint8_t *rx, uint16_t size, uint32_t setup,
+                               void (*cplt)(SPI_HandleTypeDef *hspi)) {
+    if (hspi->State != HOST_HAL_STATE_READY) {
+        return HAL_BUSY;
+    }
+    if (size == 0) {
+        return HAL_ERROR;
+    }
+    hspi->State = HOST_HAL_STATE_BUSY;
+    hspi->tx = tx;
+    hspi->rx = rx;
+    hspi->size = size;
+    hspi->cplt = cplt;
+    HOST_EventArmIn(&hspi->done, setup + xferTime(size) + HOST_Latency.irq_ns);
+    return HAL_OK;
+}
+
+static void txCplt(SPI_HandleTypeDef *hspi) {
+    hspi->TxCpltCallback(hspi);
+}
+
+static void rxCplt(SPI_HandleTypeDef *hspi) {
+    hspi->RxCpltCallback(hspi);
+}
+
+static void txRxCplt(SPI_HandleTypeDef *hspi) {
+    hspi->TxRxCpltCallback(hspi);
+}
+
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef *hspi) {
+    if (hspi == NULL || hspi->Instance == NULL) {
+        return HAL_ERROR;
+    }
+    if (hspi->State == HOST_HAL_STATE_RESET) {
+        hspi->TxCpltCallback = HAL_SPI_TxCpltCallback;
+        hspi->RxCpltCallback = HAL_SPI_RxCpltCallback;
+        hspi->TxRxCpltCallback = HAL_SPI_TxRxCpltCallback;
+        hspi->ErrorCallback = HAL_SPI_ErrorCallback;
+        HOST_EventInit(&hspi->done, done);
+    }
+    hspi->ErrorCode = HAL_SPI_ERROR_NONE;
+    hspi->State = HOST_HAL_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout) {
+    UNUSED(Timeout);
+    return blocking(hspi, pData, NULL, Size);
+}
+
+HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout) {
+    UNUSED(Timeout);
+    return blocking(hspi, NULL, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData,
+                                          uint16_t Size, uint32_t Timeout) {
+    UNUSED(Timeout);
+    return blocking(hspi, pTxData, pRxData, Size);
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit_IT(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size) {
+    return async(hspi, pData, NULL, Size, 0, txCplt);
+}
+
+HAL_StatusTypeDef HAL_SPI_Receive_IT(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size) {
+    return async(hspi, NULL, pData, Size, 0, rxCplt);
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_IT(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData,
+                                             uint16_t Size) {
+    return async(hspi, pTxData, pRxData, Size, 0, txRxCplt);
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size) {
+    return async(hspi, pData, NULL, Size, HOST_Latency.dma_ns, txCplt);
+}
+
+HAL_StatusTypeDef HAL_SPI_Receive_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size) {
+    return async(hspi, NULL, pData, Size, HOST_Latency.dma_ns, rxCplt);
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData,
+                                              uint16_t Size) {
+    return async(hspi, pTxData, pRxData, Size, HOST_Latency.dma_ns, txRxCplt);
+}
+
+HAL_StatusTypeDef HAL_SPI_RegisterCallback(SPI_HandleTypeDef *hspi, uint32_t CallbackID,
+                                           void (*pCallback)(SPI_HandleTypeDef *hspi)) {
+    if (pCallback == NULL) {
+        return HAL_ERROR;
+    }
+    switch (CallbackID) {
+        case HAL_SPI_TX_COMPLETE_CB_ID:
+            hspi->TxCpltCallback = pCallback;
+            break;
+        case HAL_SPI_RX_COMPLETE_CB_ID:
+            hspi->RxCpltCallback = pCallback;
+            break;
+        case HAL_SPI_TX_RX_COMPLETE_CB_ID:
+            hspi->TxRxCpltCallback = pCallback;
+            break;
+        case HAL_SPI_ERROR_CB_ID:
+            hspi->ErrorCallback = pCallback;
+            break;
+        default:
+            return HAL_ERROR;
+    }
+    return HAL_OK;
+}
+
+__weak void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi) {
+    UNUSED(hspi);
+}
+
+__weak void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi) {
+    UNUSED(hspi);
+}
+
+__weak void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi) {
+    UNUSED(hspi);
+}
+
+__weak void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi) {
+    UNUSED(hspi);
+}
+
+static void csChanged(host_gpio_listener_t *l, uint16_t pins, uint16_t odr) {
+    host_spi_dev_t *dev = HOST_CONTAINER_OF(l, host_spi_dev_t, cs);
+    uint8_t         active = !(odr & dev->cs_pin);
+
+    UNUSED(pins);
+    if (active != dev->selected) {
+        dev->selected = active;
+        if (dev->select != NULL) {
+            dev->select(dev, active);
+        }
+    }
+}
+
+void HOST_SPI_Attach(SPI_HandleTypeDef *hspi, host_spi_dev_t *dev) {
+    dev->cs.mask = dev->cs_pin;
+    dev->cs.changed = csChanged;
+    dev->selected = !(dev->cs_port->ODR & dev->cs_pin);
+    HOST_GPIO_Listen(dev->cs_port, &dev->cs);
+    dev->next = hspi->devs;
+    hspi->devs = dev;
+}
@@ -0,0 +1,240 @@
+/**
+ * @file host_hal_tim.c
+ * @brief Basic and PWM timers of the host HAL
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#include "host_hal.h"
+
+#define TIM_CR1_CEN (0x0001U)
+
+#define PPM (1000000)
+
+TIM_TypeDef HOST_TIM2 = { .width = 32 }, HOST_TIM3 = { .width = 16 }, HOST_TIM4 = { .width = 16 },
+            HOST_TIM7 = { .width = 16 }, HOST_TIM17 = { .width = 16 };
+
+static TIM_HandleTypeDef *timers;
+
+uint64_t HOST_TIM_TicksToNs(TIM_HandleTypeDef *htim, uint64_t ticks) {
+    unsigned __int128 num = (unsigned __int128) ticks * (htim->psc_seen + 1) * HOST_NS_PER_S * PPM;
+    unsigned __int128 den = (unsigned __int128) HOST_TIM_CLOCK_HZ * (PPM + htim->ppm);
+    return (uint64_t) ((num + den - 1) / den);
+}
+
+static uint64_t nsToTicks(TIM_HandleTypeDef *htim, uint64_t ns) {
+    unsigned __int128 num = (unsigned __int128) ns * HOST_TIM_CLOCK_HZ * (PPM + htim->ppm);
+    unsigned __int128 den = (unsigned __int128) (htim->psc_seen + 1) * HOST_NS_PER_S * PPM;
+    return (uint64_t) (num / den);
+}
+
+static inline uint64_t top(TIM_HandleTypeDef *htim) {
+    return 1ULL << htim->Instance->width;
+}
+
+/* counter value at the current time with the settings the timer runs with */
+static uint32_t counter(TIM_HandleTypeDef *htim) {
+    uint64_t cnt = htim->cnt0;
+    uint64_t period = (uint64_t) htim->arr_seen + 1;
+
+    if (!(htim->Instance->CR1 & TIM_CR1_CEN)) {
+        return htim->cnt0;
+    }
+    cnt += nsToTicks(htim, HOST_Now() - htim->t0);
+    if (htim->cnt0 > htim->arr_seen) {
+        if (cnt < top(htim)) {
+            return cnt;
+        }
+        cnt -= top(htim);
+    }
+    return cnt % period;
+}
+
+static void arm(TIM_HandleTypeDef *htim) {
+    uint64_t left;
+
+    if (!(htim->Instance->CR1 & TIM_CR1_CEN) || !(htim->it || htim->pwm_it)) {
+        HOST_EventDisarm(&htim->update);
+        return;
+    }
+    left = (htim->cnt0 > htim->arr_seen) ? top(htim) - htim->cnt0 : (uint64_t) htim->arr_seen + 1 - htim->cnt0;
+    HOST_EventArm(&htim->update, htim->t0 + HOST_TIM_TicksToNs(htim, left));
+}
+
+/* restarts counting from the current value with the current registers */
+static void rebase(TIM_HandleTypeDef *htim, uint32_t cnt) {
+    htim->cnt0 = cnt;
+    htim->t0 = HOST_Now();
+    htim->arr_seen = htim->Instance->ARR;
+    htim->psc_seen = htim->Instance->PSC;
+    arm(htim);
+}
+
+static void check(TIM_HandleTypeDef *htim) {
+    if (htim->arr_seen != htim->Instance->ARR || htim->psc_seen != htim->Instance->PSC) {
+        rebase(htim, counter(htim));
+    }
+}
+
+/* notices ARR and PSC written directly to registers */
+void HOST_TIM_Sync(void) {
+    for (TIM_HandleTypeDef *htim = timers; htim != NULL; htim = htim->next) {
+        check(htim);
+    }
+}
+
+static void update(host_event_t *ev) {
+    TIM_HandleTypeDef *htim = HOST_CONTAINER_OF(ev, TIM_HandleTypeDef, update);
+
+    htim->cnt0 = 0;
+    htim->t0 = ev->time;
+    arm(htim);
+
+    if (htim->it) {
+        htim->PeriodElapsedCallback(htim);
+    }
+    for (uint8_t ch = 0; ch < 4; ++ch) {
+        if (htim->pwm_it & (1U << ch)) {
+            htim->Channel = (HAL_TIM_ActiveChannel) (1U << ch);
+            htim->PWM_PulseFinishedCallback(htim);
+            htim->Channel = HAL_TIM_ACTIVE_CHANNEL_CLEARED;
+        }
+    }
+}
+
+static HAL_StatusTypeDef init(TIM_HandleTypeDef *htim) {
+    if (htim == NULL || htim->Instance == NULL) {
+        return HAL_ERROR;
+    }
+    if (htim->State == HOST_HAL_STATE_RESET) {
+        htim->PeriodElapsedCallback = HAL_TIM_PeriodElapsedCallback;
+        htim->PWM_PulseFinishedCallback = HAL_TIM_PWM_PulseFinishedCallback;
+        HOST_EventInit(&htim->update, update);
+        htim->next = timers;
+        timers = htim;
+    }
+    htim->Instance->PSC = htim->Init.Prescaler;
+    htim->Instance->ARR = htim->Init.Period;
+    rebase(htim, 0);
+    htim->State = HOST_HAL_STATE_READY;
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef start(TIM_HandleTypeDef *htim) {
+    if (htim->State == HOST_HAL_STATE_RESET) {
+        return HAL_ERROR;
+    }
+    if (!(htim->Instance->CR1 & TIM_CR1_CEN)) {
+        htim->Instance->CR1 |= TIM_CR1_CEN;
+        rebase(htim, htim->cnt0);
+    } else {
+        check(htim);
+        arm(htim);
+    }
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef stop(TIM_HandleTypeDef *htim) {
+    if (!htim->it && !htim->pwm_it) {
+        htim->cnt0 = counter(htim);
+        htim->Instance->CR1 &= ~TIM_CR1_CEN;
+    }
+    arm(htim);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim) {
+    return init(htim);
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Init(TIM_HandleTypeDef *htim) {
+    return init(htim);
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim) {
+    return start(htim);
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim) {
+    htim->it = 1;
+    return start(htim);
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop(TIM_HandleTypeDef *htim) {
+    return stop(htim);
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim) {
+    htim->it = 0;
+    return stop(htim);
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t Channel) {
+    UNUSED(Channel);
+    return start(htim);
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start_IT(TIM_HandleTypeDef *htim, uint32_t Channel) {
+    htim->pwm_it |= 1U << (Channel >> 2);
+    return start(htim);
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Stop(TIM_HandleTypeDef *htim, uint32_t Channel) {
+    UNUSED(Channel);
+    return stop(htim);
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Stop_IT(TIM_HandleTypeDef *htim, uint32_t Channel) {
+    htim->pwm_it &= ~(1U << (Channel >> 2));
+    return stop(htim);
+}
+
+HAL_StatusTypeDef HAL_TIM_GenerateEvent(TIM_HandleTypeDef *htim, uint32_t EventSource) {
+    if (!(EventSource & TIM_EVENTSOURCE_UPDATE)) {
+        return HAL_OK;
+    }
+    rebase(htim, 0);
+    if ((htim->Instance->CR1 & TIM_CR1_CEN) && htim->it) {
+        /* UG raises the update interrupt right away */
+        HOST_EventArm(&htim->update, HOST_Now());
+        HOST_Spin(0);
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_RegisterCallback(TIM_HandleTypeDef *htim, uint32_t CallbackID,
+                                           void (*pCallback)(TIM_HandleTypeDef *htim)) {
+    if (pCallback == NULL) {
+        return HAL_ERROR;
+    }
+    switch (CallbackID) {
+        case HAL_TIM_CB_PERIOD_ELAPSED:
+            htim->PeriodElapsedCallback = pCallback;
+            break;
+        case HAL_TIM_CB_PWM_PULSE_FINISH:
+            htim->PWM_PulseFinishedCallback = pCallback;
+            break;
+        default:
+            return HAL_ERROR;
+    }
+    return HAL_OK;
+}
+
+uint32_t HOST_TIM_GetCounter(TIM_HandleTypeDef *htim) {
+    check(htim);
+    return counter(htim);
+}
+
+void HOST_TIM_SetCounter(TIM_HandleTypeDef *htim, uint32_t cnt) {
+    rebase(htim, cnt);
+}
+
+__weak void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim) {
+    UNUSED(htim);
+}
+
+__weak void HAL_TIM_PWM_PulseFinishedCallback(TIM_HandleTypeDef *htim) {
+    UNUSED(htim);
+}
@@ -0,0 +1,193 @@
+/**
+ * @file host_hal_uart.c
+ * @brief UART of the host HAL
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#include "host_hal.h"
+
+#define UART_DEFAULT_BAUD (115200U)
+
+USART_TypeDef HOST_LPUART1 = { 0 }, HOST_USART1 = { 1 }, HOST_USART2 = { 2 }, HOST_USART3 = { 3 };
+
+/* start + 8 data + stop bits */
+static uint64_t byteTime(UART_HandleTypeDef *huart) {
+    return HOST_XFER_NS(10U, huart->Init.BaudRate ? huart->Init.BaudRate : UART_DEFAULT_BAUD);
+}
+
+static inline uint32_t fifoLen(UART_HandleTypeDef *huart) {
+    return huart->fifo_head - huart->fifo_tail;
+}
+
+static void armRx(UART_HandleTypeDef *huart) {
+    if (huart->RxState == HOST_HAL_STATE_BUSY && fifoLen(huart) && !HOST_EventArmed(&huart->rx_byte)) {
+        HOST_EventArmIn(&huart->rx_byte, byteTime(huart));
+    }
+}
+
+static void rxByte(host_event_t *ev) {
+    UART_HandleTypeDef *huart = HOST_CONTAINER_OF(ev, UART_HandleTypeDef, rx_byte);
+
+    if (huart->RxState != HOST_HAL_STATE_BUSY || !fifoLen(huart)) {
+        return;
+    }
+    huart->rx_buf[huart->rx_pos++] = huart->fifo[huart->fifo_tail++ % HOST_UART_RX_FIFO_SIZE];
+    huart->dmarx.remaining = huart->rx_size - huart->rx_pos;
+
+    if (huart->rx_circular) {
+        if (huart->rx_pos == huart->rx_size / 2) {
+            huart->RxHalfCpltCallback(huart);
+        }
+        if (huart->rx_pos == huart->rx_size) {
+            huart->rx_pos = 0;
+            huart->dmarx.remaining = huart->rx_size;
+            huart->RxCpltCallback(huart);
+        }
+    } else if (huart->rx_pos == huart->rx_size) {
+        huart->RxState = HOST_HAL_STATE_READY;
+        huart->RxCpltCallback(huart);
+    }
+    armRx(huart);
+}
+
+static void txDone(host_event_t *ev) {
+    UART_HandleTypeDef *huart = HOST_CONTAINER_OF(ev, UART_HandleTypeDef, tx_done);
+
+    huart->gState = HOST_HAL_STATE_READY;
+    huart->TxCpltCallback(huart);
+}
+
+static HAL_StatusTypeDef transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t setup) {
+    if (huart->gState != HOST_HAL_STATE_READY) {
+        return HAL_BUSY;
+    }
+    if (pData == NULL || Size == 0) {
+        return HAL_ERROR;
+    }
+    huart->gState = HOST_HAL_STATE_BUSY;
+    if (huart->sink != NULL) {
+        huart->sink(huart, pData, Size);
+    }
+    HOST_EventArmIn(&huart->tx_done, setup + Size * byteTime(huart) + HOST_Latency.irq_ns);
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef receive(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint8_t circular) {
+    if (huart->RxState != HOST_HAL_STATE_READY) {
+        return HAL_BUSY;
+    }
+    if (pData == NULL || Size == 0) {
+        return HAL_ERROR;
+    }
+    huart->RxState = HOST_HAL_STATE_BUSY;
+    huart->rx_buf = pData;
+    huart->rx_size = Size;
+    huart->rx_pos = 0;
+    huart->rx_circular = circular;
+    huart->dmarx.remaining = Size;
+    armRx(huart);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart) {
+    if (huart == NULL || huart->Instance == NULL) {
+        return HAL_ERROR;
+    }
+    if (huart->gState == HOST_HAL_STATE_RESET) {
+        huart->TxCpltCallback = HAL_UART_TxCpltCallback;
+        huart->RxCpltCallback = HAL_UART_RxCpltCallback;
+        huart->RxHalfCpltCallback = HAL_UART_RxHalfCpltCallback;
+        huart->ErrorCallback = HAL_UART_ErrorCallback;
+        huart->hdmarx = &huart->dmarx;
+        HOST_EventInit(&huart->tx_done, txDone);
+        HOST_EventInit(&huart->rx_byte, rxByte);
+    }
+    huart->ErrorCode = HAL_UART_ERROR_NONE;
+    huart->gState = HOST_HAL_STATE_READY;
+    huart->RxState = HOST_HAL_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout) {
+    UNUSED(Timeout);
+    if (huart->gState != HOST_HAL_STATE_READY) {
+        return HAL_BUSY;
+    }
+    if (huart->sink != NULL) {
+        huart->sink(huart, pData, Size);
+    }
+    HOST_Spin(Size * byteTime(huart));
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size) {
+    return transmit(huart, pData, Size, 0);
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size) {
+    return transmit(huart, pData, Size, HOST_Latency.dma_ns);
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size) {
+    return receive(huart, pData, Size, 0);
+}
+
+/* receive DMA channels of the firmware are circular */
+HAL_StatusTypeDef HAL_UART_Receive_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size) {
+    return receive(huart, pData, Size, 1);
+}
+
+HAL_StatusTypeDef HAL_UART_RegisterCallback(UART_HandleTypeDef *huart, uint32_t CallbackID,
+                                            void (*pCallback)(UART_HandleTypeDef *huart)) {
+    if (pCallback == NULL) {
+        return HAL_ERROR;
+    }
+    switch (CallbackID) {
+        case HAL_UART_TX_COMPLETE_CB_ID:
+            huart->TxCpltCallback = pCallback;
+            break;
+        case HAL_UART_RX_HALFCOMPLETE_CB_ID:
+            huart->RxHalfCpltCallback = pCallback;
+            break;
+        case HAL_UART_RX_COMPLETE_CB_ID:
+            huart->RxCpltCallback = pCallback;
+            break;
+        case HAL_UART_ERROR_CB_ID:
+            huart->ErrorCallback = pCallback;
+            break;
+        default:
+            return HAL_ERROR;
+    }
+    return HAL_OK;
+}
+
+__weak void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) {
+    UNUSED(huart);
+}
+
+__weak void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart) {
+    UNUSED(huart);
+}
+
+__weak void HAL_UART_RxHalfCpltCallback(UART_HandleTypeDef *huart) {
+    UNUSED(huart);
+}
+
+__weak void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart) {
+    UNUSED(huart);
+}
+
+void HOST_UART_Sink(UART_HandleTypeDef *huart, void (*sink)(UART_HandleTypeDef *huart, const uint8_t *data,
+                                                            uint16_t size)) {
+    huart->sink = sink;
+}
+
+void HOST_UART_Inject(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t size) {
+    for (uint16_t i = 0; i < size && fifoLen(huart) < HOST_UART_RX_FIFO_SIZE; ++i) {
+        huart->fifo[huart->fifo_head++ % HOST_UART_RX_FIFO_SIZE] = data[i];
+    }
+    armRx(huart);
+}
@@ -0,0 +1,50 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  PORT SPECIFIC C INFORMATION                            RELEASE        */
+/*                                                                        */
+/*    tx_linux.h                                      Linux/GCC (host)    */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    Private definitions shared by the host port sources. Not part of   */
+/*    the ThreadX API, do not include from application code.              */
+/*                                                                        */
+/**************************************************************************/
+
+#ifndef TX_LINUX_H
+#define TX_LINUX_H
+
+#include <ucontext.h>
+
+/* Host execution context of a thread, referenced by tx_thread_linux_context.  */
+
+typedef struct TX_LINUX_CONTEXT_STRUCT
+{
+    ucontext_t                  tx_linux_context;
+    VOID                        *tx_linux_stack;
+} TX_LINUX_CONTEXT;
+
+
+/* Context of the scheduler loop, the threads switch back to it on system return.  */
+
+extern ucontext_t               _tx_linux_scheduler_context;
+
+
+/* Current simulated interrupt posture.  */
+
+extern UINT                     _tx_linux_interrupt_posture;
+
+#endif
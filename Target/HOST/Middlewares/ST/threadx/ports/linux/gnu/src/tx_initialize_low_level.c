@@ -0,0 +1,60 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** ThreadX Component                                                     */
+/**                                                                       */
+/**   Initialize                                                          */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define TX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "tx_api.h"
+#include "tx_initialize.h"
+#include "tx_thread.h"
+#include "tx_linux.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_initialize_low_level                        Linux/GCC (host)    */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is responsible for any low-level processor            */
+/*    initialization. On the host there is no interrupt controller or     */
+/*    tick timer to program: the simulator owns both, so only the system  */
+/*    stack and the interrupt posture are set up here.                    */
+/*                                                                        */
+/**************************************************************************/
+VOID   _tx_initialize_low_level(VOID)
+{
+
+    /* The scheduler runs on the process stack.  */
+    _tx_thread_system_stack_ptr =  (VOID *) &_tx_linux_scheduler_context;
+
+    /* Memory is handed out by the application pools, nothing is free past them.  */
+    _tx_initialize_unused_memory =  TX_NULL;
+
+    /* Interrupts stay locked out until the scheduler starts.  */
+    _tx_linux_interrupt_posture =  TX_INT_DISABLE;
+}
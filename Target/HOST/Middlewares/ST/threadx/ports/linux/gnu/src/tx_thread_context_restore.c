@@ -0,0 +1,68 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** ThreadX Component                                                     */
+/**                                                                       */
+/**   Thread                                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define TX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "tx_api.h"
+#include "tx_thread.h"
+#include "tx_linux.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_thread_context_restore                      Linux/GCC (host)    */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function restores the interrupt context if it is processing a  */
+/*    nested interrupt.  If not, it returns to the interrupt thread if no */
+/*    preemption is necessary.  Otherwise, if preemption is necessary the */
+/*    interrupted thread gives the processor back to the scheduler.       */
+/*                                                                        */
+/**************************************************************************/
+VOID   _tx_thread_context_restore(VOID)
+{
+
+    /* Decrement the nested interrupt counter.  */
+    _tx_thread_system_state--;
+    if (_tx_thread_system_state != ((ULONG) 0))
+    {
+
+        /* Nested interrupt, just return to the outer one.  */
+        return;
+    }
+
+    _tx_linux_interrupt_posture =  TX_INT_ENABLE;
+
+    /* Determine if a thread was interrupted and has to be preempted.  */
+    if ((_tx_thread_current_ptr != TX_NULL) && (_tx_thread_preempt_disable == ((UINT) 0)) &&
+        (_tx_thread_current_ptr != _tx_thread_execute_ptr))
+    {
+        _tx_thread_system_return();
+    }
+}
@@ -0,0 +1,59 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** ThreadX Component                                                     */
+/**                                                                       */
+/**   Thread                                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define TX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "tx_api.h"
+#include "tx_linux.h"
+
+
+UINT    _tx_linux_interrupt_posture =  TX_INT_DISABLE;
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_thread_interrupt_control                    Linux/GCC (host)    */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is responsible for changing the interrupt lockout     */
+/*    posture of the system. Only one context executes at a time on this  */
+/*    port, so the posture just tells the simulator whether interrupts    */
+/*    may be delivered while a thread busy-waits.                         */
+/*                                                                        */
+/**************************************************************************/
+UINT   _tx_thread_interrupt_control(UINT new_posture)
+{
+
+UINT    old_posture;
+
+
+    old_posture =  _tx_linux_interrupt_posture;
+    _tx_linux_interrupt_posture =  new_posture;
+    return(old_posture);
+}
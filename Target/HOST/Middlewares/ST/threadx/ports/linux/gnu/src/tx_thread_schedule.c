@@ -0,0 +1,89 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** ThreadX Component                                                     */
+/**                                                                       */
+/**   Thread                                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define TX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "tx_api.h"
+#include "tx_thread.h"
+#include "tx_timer.h"
+#include "tx_linux.h"
+
+
+ucontext_t  _tx_linux_scheduler_context;
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_thread_schedule                             Linux/GCC (host)    */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function waits for a thread control block pointer to appear in */
+/*    the _tx_thread_execute_ptr variable.  Once a thread pointer appears  */
+/*    in the variable, the corresponding thread is resumed. While no      */
+/*    thread is ready, the simulator idle hook advances the virtual time  */
+/*    and delivers interrupts. This function never returns.               */
+/*                                                                        */
+/**************************************************************************/
+VOID   _tx_thread_schedule(VOID)
+{
+
+TX_THREAD           *thread_ptr;
+TX_LINUX_CONTEXT    *context_ptr;
+
+
+    /* Enter the scheduling loop.  */
+    while (1)
+    {
+
+        /* Interrupts are enabled while the scheduler waits for work.  */
+        _tx_linux_interrupt_posture =  TX_INT_ENABLE;
+
+        /* Wait for a thread to execute.  */
+        while (_tx_thread_execute_ptr == TX_NULL)
+        {
+
+            /* Let the simulator advance the time and run the next ISR.  */
+            _tx_linux_idle();
+        }
+
+        /* Yes! We have a thread to execute.  Setup the current thread pointer.  */
+        thread_ptr =  _tx_thread_execute_ptr;
+        _tx_thread_current_ptr =  thread_ptr;
+
+        /* Increment the run count for this thread.  */
+        thread_ptr -> tx_thread_run_count++;
+
+        /* Setup time-slice, if present.  */
+        _tx_timer_time_slice =  thread_ptr -> tx_thread_time_slice;
+
+        /* Switch to the thread, it comes back here through _tx_thread_system_return.  */
+        context_ptr =  (TX_LINUX_CONTEXT *) thread_ptr -> tx_thread_linux_context;
+        swapcontext(&_tx_linux_scheduler_context, &context_ptr -> tx_linux_context);
+    }
+}
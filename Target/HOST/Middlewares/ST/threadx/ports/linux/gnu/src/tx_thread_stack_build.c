@@ -0,0 +1,104 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** ThreadX Component                                                     */
+/**                                                                       */
+/**   Thread                                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define TX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "tx_api.h"
+#include "tx_thread.h"
+#include "tx_linux.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_thread_stack_build                          Linux/GCC (host)    */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function builds a stack frame on the supplied thread's stack.  */
+/*    The stack frame results in a fake interrupt return to the supplied  */
+/*    function pointer. On the host the frame is an ucontext running on a */
+/*    host stack, because the small stacks sized for the target are not   */
+/*    enough for the C library.                                           */
+/*                                                                        */
+/**************************************************************************/
+VOID   _tx_thread_stack_build(TX_THREAD *thread_ptr, VOID (*function_ptr)(VOID))
+{
+
+TX_LINUX_CONTEXT    *context_ptr;
+
+
+    /* Reuse the context when the thread is reset.  */
+    context_ptr =  (TX_LINUX_CONTEXT *) thread_ptr -> tx_thread_linux_context;
+    if (context_ptr == TX_NULL)
+    {
+        context_ptr =  (TX_LINUX_CONTEXT *) malloc(sizeof(TX_LINUX_CONTEXT));
+        context_ptr -> tx_linux_stack =  malloc(TX_LINUX_THREAD_STACK_SIZE);
+        if ((context_ptr == TX_NULL) || (context_ptr -> tx_linux_stack == TX_NULL))
+        {
+            abort();
+        }
+        thread_ptr -> tx_thread_linux_context =  (VOID *) context_ptr;
+    }
+
+    getcontext(&context_ptr -> tx_linux_context);
+    context_ptr -> tx_linux_context.uc_stack.ss_sp =    context_ptr -> tx_linux_stack;
+    context_ptr -> tx_linux_context.uc_stack.ss_size =  TX_LINUX_THREAD_STACK_SIZE;
+    context_ptr -> tx_linux_context.uc_link =           &_tx_linux_scheduler_context;
+    makecontext(&context_ptr -> tx_linux_context, function_ptr, 0);
+
+    /* The target stack is never used, point to its end as the initial stack frame.  */
+    thread_ptr -> tx_thread_stack_ptr =  thread_ptr -> tx_thread_stack_end;
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_linux_thread_context_free                   Linux/GCC (host)    */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function releases the host context of a deleted thread.       */
+/*                                                                        */
+/**************************************************************************/
+VOID   _tx_linux_thread_context_free(TX_THREAD *thread_ptr)
+{
+
+TX_LINUX_CONTEXT    *context_ptr;
+
+
+    context_ptr =  (TX_LINUX_CONTEXT *) thread_ptr -> tx_thread_linux_context;
+    if (context_ptr != TX_NULL)
+    {
+        free(context_ptr -> tx_linux_stack);
+        free(context_ptr);
+        thread_ptr -> tx_thread_linux_context =  TX_NULL;
+    }
+}
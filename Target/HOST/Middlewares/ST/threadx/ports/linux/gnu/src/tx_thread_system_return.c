@@ -0,0 +1,73 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** ThreadX Component                                                     */
+/**                                                                       */
+/**   Thread                                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define TX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "tx_api.h"
+#include "tx_thread.h"
+#include "tx_timer.h"
+#include "tx_linux.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _tx_thread_system_return                        Linux/GCC (host)    */
+/*                                                           6.1.10       */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is target processor specific.  It is used to transfer */
+/*    control from a thread back to the system. The thread context stays  */
+/*    in its ucontext until the scheduler selects the thread again.       */
+/*                                                                        */
+/**************************************************************************/
+VOID   _tx_thread_system_return(VOID)
+{
+
+TX_THREAD           *thread_ptr;
+TX_LINUX_CONTEXT    *context_ptr;
+
+
+    thread_ptr =  _tx_thread_current_ptr;
+
+    /* Save the remaining time-slice and disable it.  */
+    if (_tx_timer_time_slice)
+    {
+        thread_ptr -> tx_thread_time_slice =  _tx_timer_time_slice;
+        _tx_timer_time_slice =  0;
+    }
+
+    /* Clear the current thread pointer, the thread is no longer executing.  */
+    _tx_thread_current_ptr =  TX_NULL;
+
+    /* Switch to the scheduler. Completed and terminated threads never come back.  */
+    context_ptr =  (TX_LINUX_CONTEXT *) thread_ptr -> tx_thread_linux_context;
+    swapcontext(&context_ptr -> tx_linux_context, &_tx_linux_scheduler_context);
+
+    /* The thread has been resumed by the scheduler, interrupts are enabled again.  */
+    _tx_linux_interrupt_posture =  TX_INT_ENABLE;
+}
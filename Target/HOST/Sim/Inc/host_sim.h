@@ -0,0 +1,119 @@
+/**
+ * @file host_sim.h
+ * @brief Virtual time core of the HOST target.
+ *        This file provides functions to manage the following
+ *        functionalities of the host simulator:
+ *            + Virtual clock and event queue
+ *            + Interrupt delivery into the ThreadX host port
+ *            + Latency configuration of simulated peripherals
+ *        ### How the host simulator works ###
+ *     ThreadX threads execute in zero virtual time. Whenever no thread is ready the scheduler calls the
+ *     idle hook, which advances the clock to the next armed event and runs its handler as an interrupt.
+ *     Peripheral models arm events for their completions, so a DMA transfer or a radio packet takes
+ *     exactly the configured time whatever the host load is.
+ *     + Busy waits (HAL_Delay, polling) call HOST_Spin(), which advances the clock in thread context
+ *     + With --sim-realtime the clock is paced to the wall clock and stdin is fed to the console UART
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#ifndef HOST_SIM_H
+#define HOST_SIM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define HOST_NS_PER_US (1000ULL)
+#define HOST_NS_PER_MS (1000000ULL)
+#define HOST_NS_PER_S  (1000000000ULL)
+
+/* time of _n transfer units (bits, bytes...) at _hz units per second, ns */
+#define HOST_XFER_NS(_n, _hz) (((uint64_t) (_n) *HOST_NS_PER_S + (_hz) -1) / (_hz))
+
+typedef struct host_event host_event_t;
+
+typedef void (*host_event_fn_t)(host_event_t *ev);
+
+/**
+ * @brief Simulated interrupt source.
+ * @note Embed it into the model state and get the owner back with HOST_CONTAINER_OF().
+ */
+struct host_event {
+    uint64_t        time;
+    uint64_t        seq;
+    host_event_fn_t fn;
+    int32_t         slot; /* position in the queue, -1 when disarmed */
+};
+
+#define HOST_CONTAINER_OF(_p, _t, _m) ((_t *) ((char *) (_p) -offsetof(_t, _m)))
+
+/**
+ * @brief Latencies of simulated peripherals.
+ * Transfer time is computed from the clock of the bus plus the fixed part.
+ */
+typedef struct {
+    uint32_t irq_ns;  /* interrupt entry latency added to every completion */
+    uint32_t dma_ns;  /* DMA setup time of every transfer */
+    uint32_t exti_ns; /* EXTI line latency */
+    uint32_t spi_hz;  /* SPI SCK */
+    uint32_t i2c_hz;  /* I2C SCL */
+    uint32_t ospi_hz; /* OCTOSPI CLK (per line) */
+} host_latency_t;
+
+extern host_latency_t HOST_Latency;
+
+/**
+ * @brief Parse --sim-* options and prepare the clock
+ * @param argc Arguments count
+ * @param argv Arguments, recognised options are removed
+ * @return New arguments count
+ */
+int HOST_SimInit(int argc, char **argv);
+
+/**
+ * @brief Current virtual time
+ * @return Time since start, ns
+ */
+uint64_t HOST_Now(void);
+
+void    HOST_EventInit(host_event_t *ev, host_event_fn_t fn);
+void    HOST_EventArm(host_event_t *ev, uint64_t time);
+void    HOST_EventArmIn(host_event_t *ev, uint64_t delay);
+void    HOST_EventDisarm(host_event_t *ev);
+uint8_t HOST_EventArmed(const host_event_t *ev);
+
+/**
+ * @brief Busy wait in thread context. Interrupts due in the meantime are delivered
+ * and may preempt the caller.
+ * @param ns Time to spin, ns
+ */
+void HOST_Spin(uint64_t ns);
+
+/**
+ * @brief Register function called before and after the clock advances.
+ * Models use it to notice register writes done by plain stores and to
+ * update registers that follow the clock.
+ */
+void HOST_SyncRegister(void (*fn)(void));
+
+/**
+ * @brief Register consumer of console input (stdin in realtime mode).
+ */
+void HOST_InputRegister(void (*fn)(const uint8_t *data, size_t len));
+
+/**
+ * @brief Stop simulation at the given virtual time
+ * @param time Absolute time, ns. 0 - never
+ */
+void HOST_StopAt(uint64_t time);
+
+/**
+ * @brief End the simulation
+ * @param code Process exit code
+ */
+void HOST_Exit(int code);
+
+#endif    // HOST_SIM_H
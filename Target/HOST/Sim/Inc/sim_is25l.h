@@ -0,0 +1,56 @@
+/**
+ * @file sim_is25l.h
+ * @brief IS25LP032D NOR flash model for the host simulator.
+ *        Attached to the OCTOSPI of the host HAL, keeps the whole array in RAM.
+ *        Program only clears bits, erase sets them, busy time follows the datasheet
+ *        typical values and is reported through the WIP bit. Programs and erases of
+ *        blocks under the BP bits of the status register are ignored.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#ifndef SIM_IS25L_H
+#define SIM_IS25L_H
+
+#include <stdint.h>
+
+#include "host_hal.h"
+
+#define SIM_IS25L_SIZE        (4U * 1024U * 1024U)
+#define SIM_IS25L_PAGE_SIZE   (256U)
+#define SIM_IS25L_SECTOR_SIZE (4096U)
+#define SIM_IS25L_SECTORS     (SIM_IS25L_SIZE / SIM_IS25L_SECTOR_SIZE)
+
+/**
+ * @brief Operation counters of the model
+ */
+typedef struct {
+    uint32_t page_programs;
+    uint64_t bytes_programmed;
+    uint32_t sector_erases;
+    uint32_t block_erases;
+    uint32_t chip_erases;
+    uint64_t bytes_read;                       /* by commands, loads of memory-mapped mode are not counted */
+    uint32_t maps;                             /* switches to memory-mapped mode */
+    uint64_t busy_ns;                          /* time spent in program/erase */
+    uint32_t sector_wear[SIM_IS25L_SECTORS];  /* erase cycles of every sector */
+} sim_is25l_stats_t;
+
+/**
+ * @brief Attach the model to the interface
+ * @param hospi Interface
+ * @param qe Initial state of the non-volatile QE bit
+ */
+void SIM_IS25L_Attach(OSPI_HandleTypeDef *hospi, uint8_t qe);
+
+/**
+ * @brief Direct access to the array (backdoor for tools, bypasses timing and counters)
+ */
+uint8_t *SIM_IS25L_Memory(void);
+
+const sim_is25l_stats_t *SIM_IS25L_Stats(void);
+void                     SIM_IS25L_ResetStats(void);
+
+#endif    // SIM_IS25L_H
@@ -0,0 +1,60 @@
+/**
+ * @file sim_node.h
+ * @brief Simulated GEODE nodes of the HOST target.
+ *        Every node is a private copy of GEODE linked with the simulated RFM
+ *        backend, its own GOD_TIM and device ID. The build makes all symbols
+ *        of a copy local, so nodes are reached only through the pointer to its
+ *        descriptor every copy puts into the SIM_NODE_SECTION section.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#ifndef SIM_NODE_H
+#define SIM_NODE_H
+
+#include "geode.h"
+#include "sim_radio.h"
+
+#define SIM_NODE_SECTION "sim_node"
+
+/* word 0 of the device ID, master uses it as sync word */
+#define SIM_NODE_UID0(_id) (0x00480000U | (_id))
+
+typedef struct {
+    /**
+     * @brief Bring up the board of the node
+     * @param id Node number, also goes to the device ID
+     * @param ppm Deviation of the node clock
+     */
+    void (*init)(uint16_t id, int32_t ppm);
+
+    god_stat_t (*god_init)(void);
+    god_stat_t (*set_profile)(god_profile_t prof);
+    god_stat_t (*start)(god_node_t nt, void *args);
+    god_stat_t (*relay)(void);
+    god_stat_t (*write)(uint8_t *data, uint16_t size);
+    god_stat_t (*printf)(char *data, ...);
+    god_stat_t (*read)(uint8_t slot, uint8_t *data, uint16_t size, god_mode_t mode);
+    god_stat_t (*send_msg)(uint8_t *data, uint16_t size);
+    god_stat_t (*recv_msg)(uint8_t slot, uint8_t *data, uint16_t size, uint16_t *len, god_mode_t mode);
+    god_stat_t (*announce)(uint32_t time, uint8_t *text);
+    uint8_t *(*scan)(uint32_t time);
+    god_stat_t (*mem_usage)(god_mem_t *mem);
+    god_stat_t (*link_stat)(uint8_t slot, god_link_stat_t *stat);
+    god_stat_t (*tx_stat)(god_tx_stat_t *stat);
+    god_stat_t (*radio_stat)(god_radio_stat_t *stat);
+
+    sim_radio_t       *radio;
+    TIM_HandleTypeDef *tim;
+    uint8_t            window; /* GOD_WND_SIZE the copy is built with */
+} sim_node_t;
+
+extern const sim_node_t *const __start_sim_node[];
+extern const sim_node_t *const __stop_sim_node[];
+
+#define SIM_NODES      (__start_sim_node)
+#define SIM_NODE_COUNT ((uint16_t) (__stop_sim_node - __start_sim_node))
+
+#endif    // SIM_NODE_H
@@ -0,0 +1,133 @@
+/**
+ * @file sim_radio.h
+ * @brief Virtual radio medium of the HOST target.
+ *        This file provides functions to manage the following
+ *        functionalities of the simulated air:
+ *            + Airtime of packets from modem settings
+ *            + Collisions of packets overlapping on a channel
+ *            + Zones of range, for relaying
+ *            + Random packet loss
+ *        ### How the medium works ###
+ *     Every simulated transceiver owns a sim_radio_t attached with SIM_RadioAttach().
+ *     A packet occupies its channel (frequency) from the start of the preamble to the
+ *     end of CRC. It is received by every radio that:
+ *     + listens on the same frequency since at least SIM_Medium.detect_bits of preamble
+ *       before the sync word and until the end of the packet
+ *     + has the same sync word and payload length (in variable length mode not above it)
+ *     + is in the zone of the sender or in a neighbouring one
+ *     + was not hit by another packet on the channel heard in its zone and passed the loss
+ *       draw (including the one of an interferer on its channel)
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#ifndef SIM_RADIO_H
+#define SIM_RADIO_H
+
+#include <stdint.h>
+
+#include "host_sim.h"
+
+#define SIM_RADIO_MAX_PKT  (255U)
+#define SIM_RADIO_SYNC_MAX (4U)
+#define SIM_RADIO_ZONES    (7U) /* zone of a radio, 0 by default */
+
+typedef enum {
+    SIM_RADIO_IDLE,
+    SIM_RADIO_RX,
+    SIM_RADIO_TX
+} sim_radio_state_t;
+
+typedef struct {
+    uint32_t tx;       /* packets sent */
+    uint32_t rx;       /* packets received */
+    uint32_t collided; /* packets lost in collisions */
+    uint32_t lost;     /* packets dropped by the loss model */
+    uint32_t crc;      /* packets of other or too big length (CRC error on the chip) */
+    uint64_t tx_ns;    /* time on air */
+    uint64_t rx_ns;    /* time listening */
+} sim_radio_stats_t;
+
+typedef struct sim_radio sim_radio_t;
+
+/**
+ * @brief Transceiver as seen by the medium.
+ * Modem fields are written by the backend the same way it writes chip properties.
+ */
+struct sim_radio {
+    uint32_t frequency;
+    uint32_t baud_rate;
+    uint16_t preamble_len; /* bytes */
+    uint8_t  sync_word[SIM_RADIO_SYNC_MAX];
+    uint8_t  sync_len;
+    uint8_t  crc_len;
+    uint8_t  payload_len;
+    uint8_t  variable; /* length byte precedes the payload */
+    uint32_t loss_ppm; /* receive loss of this radio on top of SIM_Medium.loss_ppm */
+    uint8_t  zone;     /* below SIM_RADIO_ZONES, radios of zones farther than the next one do not hear each other */
+
+    /* completions, called in interrupt context */
+    void (*tx_done)(sim_radio_t *radio);
+    void (*rx_done)(sim_radio_t *radio, const uint8_t *data, uint8_t size);
+
+    uint16_t          id;
+    sim_radio_state_t state;
+    uint64_t          since; /* time the current state was entered */
+    sim_radio_stats_t stats;
+    sim_radio_t      *next;
+};
+
+/**
+ * @brief Parameters of the medium, may be changed at any time
+ */
+typedef struct {
+    uint32_t loss_ppm;       /* probability to lose a packet at a receiver */
+    uint32_t jam_frequency;  /* channel of an interferer */
+    uint32_t jam_ppm;        /* loss at receivers on jam_frequency on top of loss_ppm */
+    uint32_t fade_frequency; /* channel of a fade, RSSI drops but packets still come */
+    uint16_t fade_db;        /* RSSI drop on fade_frequency */
+    uint16_t detect_bits;    /* preamble bits needed before the sync word */
+    uint64_t seed;        /* seed of the loss model */
+} sim_medium_t;
+
+extern sim_medium_t SIM_Medium;
+
+/**
+ * @brief Connect radio to the medium
+ */
+void SIM_RadioAttach(sim_radio_t *radio);
+
+/**
+ * @brief Time on air of a packet with the radio settings
+ * @param size Payload size, bytes
+ * @return Airtime, ns
+ */
+uint64_t SIM_RadioAirtime(const sim_radio_t *radio, uint8_t size);
+
+/**
+ * @brief Put packet on air. tx_done is called at the end of the packet.
+ * @param delay Time from now to the first preamble bit (TX tune), ns
+ */
+void SIM_RadioTx(sim_radio_t *radio, const uint8_t *data, uint8_t size, uint64_t delay);
+
+/**
+ * @brief Start listening. rx_done is called at the end of a received packet,
+ * the radio is idle afterwards.
+ * @param delay Time from now the receiver is ready (RX tune), ns
+ */
+void SIM_RadioRx(sim_radio_t *radio, uint64_t delay);
+
+/**
+ * @brief Leave RX or TX. A packet being sent is cut and is not received by anyone.
+ */
+void SIM_RadioIdle(sim_radio_t *radio);
+
+/**
+ * @brief Sum of statistics of all attached radios
+ */
+void SIM_RadioTotals(sim_radio_stats_t *stats);
+
+#endif    // SIM_RADIO_H
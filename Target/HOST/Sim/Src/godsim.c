@@ -0,0 +1,687 @@
+/**
+ * @file godsim.c
+ * @brief GEODE network simulator.
+ *        Runs up to GODSIM_MASTERS_MAX masters and GOD_MAX_CONN slaves of unmodified GEODE
+ *        in one process on the virtual radio medium and reports what the cells deliver:
+ *            + Join time of every slave (scan start to first message at the master)
+ *            + Per slave goodput and offered load
+ *            + Message latency percentiles (GOD_Write on a slave to GOD_Read on the master)
+ *        ### How to run ###
+ *     make -C Target/HOST bench BENCH_ARGS="--slaves=128 --rate=16"
+ *     Slaves join one at a time, as GEODE announces one free slot at a time. Once all
+ *     have joined, traffic is measured for --time seconds of virtual time.
+ *     + Every message carries its sequence number and send time, lost or
+ *       reordered bytes show up as errors
+ *     + --legacy and --legacy-master mix in nodes of single bit ARQ (GOD_WND_SIZE 1)
+ *       that do not pack their streams (GOD_COMPRESS 0)
+ *     + --text fills messages after sequence and time with telemetry text, which packs
+ *     + --msg sends messages by GOD_SendMsg, a blocking GOD_RecvMsg reader per slot gets them
+ *     + --fast runs all nodes on GOD_PROFILE_FAST
+ *     + --masters runs cells side by side, every master scans the ones started before it,
+ *       slaves are spread over cells in turn and join the master of their cell
+ *     + --relay puts the last N slaves out of master range, the first slave relays for them
+ *       (radio zones 0 master and direct slaves, 1 relay, 2 relayed slaves)
+ *     + --sim-* options of host_sim.h apply as well
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "main.h"
+#include "tx_api.h"
+#include "loglib.h"
+#include "host_sim.h"
+#include "sim_radio.h"
+#include "sim_node.h"
+
+#define GODSIM_STACK_SIZE  (1024U)
+#define GODSIM_PRIO_READER (8U)
+#define GODSIM_PRIO_WRITER (9U)
+#define GODSIM_PRIO_CTRL   (10U)
+#define GODSIM_MASTERS_MAX (4U)
+
+/* announcement as returned by GOD_Scan(): sync word, slot, slot time, data size, channel, hop, frames, header offset,
+ * text */
+#define ANN_ENTRY_SIZE (22U) /* ANN_SIZE of geode.c */
+#define ANN_SLOT       (4U)
+#define ANN_TICKS      (180000U) /* covers scan and connect, ~17 periods */
+#define ANN_TRIES      (5U)
+
+/* period of geode.c: MCD_COUNT frames, one per slave and the announced one, FRAME_SIZE slots of ~37.5 ms (full data size),
+ * ~19.2 ms in GOD_PROFILE_FAST */
+#define GEODE_FRAME_MS      (75U)
+#define GEODE_FRAME_FAST_MS (39U)
+#define GEODE_MCD_COUNT (3U)
+#define GEODE_RLY_FRAMES (4U) /* region of a relay at the end of the period */
+
+#define MSG_MIN_SIZE (sizeof(msg_t))
+#define MSG_MAX_SIZE (128U)
+
+#define JOIN_FLAG (1U)
+
+#define NS_TO_MS(_ns) ((double) (_ns) / HOST_NS_PER_MS)
+#define NS_TO_S(_ns)  ((double) (_ns) / HOST_NS_PER_S)
+
+typedef struct {
+    uint32_t seq;
+    uint64_t time; /* virtual time of GOD_Write */
+} __packed msg_t;
+
+typedef struct {
+    const sim_node_t *node;
+    uint8_t           cell; /* index of the master */
+    uint8_t           hop;  /* 0 direct, 1 behind the relay */
+    uint8_t           ann[ANN_ENTRY_SIZE];
+    uint8_t           slot;
+    uint8_t           joined;
+    uint64_t          join_start; /* scan started */
+    uint64_t          join_conn;  /* GOD_Start() */
+    uint64_t          join_done;  /* first message at the master */
+    uint32_t          seq_tx;
+    uint32_t          seq_rx;
+    uint32_t          errors;
+    uint64_t          bytes_tx; /* in the measurement window */
+    uint64_t          bytes_rx;
+    god_radio_stat_t  pwr;    /* at the window start */
+    uint64_t          air_ns; /* rx and tx of the medium at the window start */
+    TX_THREAD         writer;
+    TX_THREAD         reader;
+    uint8_t           writer_stack[GODSIM_STACK_SIZE];
+    uint8_t           reader_stack[GODSIM_STACK_SIZE];
+} slave_t;
+
+static struct {
+    uint32_t masters;
+    uint32_t slaves;
+    uint32_t rate;     /* B/s per slave */
+    uint32_t size;     /* message size */
+    uint32_t time;     /* measurement, s */
+    uint32_t loss;     /* ppm */
+    uint32_t jam;      /* kHz, channel of an interferer */
+    uint32_t jam_loss; /* ppm */
+    uint32_t fade;     /* kHz, channel of a fade */
+    uint32_t fade_db;
+    uint32_t drift;    /* ppm */
+    uint32_t scan;     /* ticks, 0 to fit the period */
+    uint32_t join_to;  /* s */
+    uint32_t seed;
+    uint32_t log;
+    uint32_t verbose;
+    uint32_t legacy;        /* slaves of single bit ARQ */
+    uint32_t legacy_master; /* master of single bit ARQ */
+    uint32_t msg;           /* GOD_SendMsg / GOD_RecvMsg instead of GOD_Write / GOD_Read */
+    uint32_t fast;          /* GOD_PROFILE_FAST */
+    uint32_t relay;         /* slaves behind the relay */
+    uint32_t text;          /* telemetry text after msg_t */
+} opt = {
+    .masters = 1,
+    .slaves = GOD_MAX_CONN,
+    .rate = 16,
+    .size = 16,
+    .time = 120,
+    .scan = 0,
+    .join_to = 180,
+    .seed = 1,
+    .log = LOG_T_WARN,
+    .jam_loss = 500000,
+    .fade_db = 20,
+};
+
+extern log_type_t SIM_LogLevel;
+
+static const sim_node_t *masters[GODSIM_MASTERS_MAX];
+static slave_t          *slaves;
+static uint32_t          joined;
+static uint32_t          cellJoined[GODSIM_MASTERS_MAX];
+
+static uint64_t winBegin = UINT64_MAX;
+static uint64_t winEnd = UINT64_MAX;
+
+static uint64_t *lat[2]; /* of direct and relayed slaves */
+static uint32_t  latCnt[2];
+static uint32_t  latSize[2];
+
+static TX_THREAD            ctrl;
+static TX_EVENT_FLAGS_GROUP efJoin;
+static uint8_t              ctrl_stack[GODSIM_STACK_SIZE];
+static uint8_t              annText[ANN_ENTRY_SIZE] = "godsim";
+
+static inline uint8_t inWindow(uint64_t time) {
+    return time >= winBegin && time < winEnd;
+}
+
+static void addLatency(uint8_t hop, uint64_t ns) {
+    if (latCnt[hop] == latSize[hop]) {
+        latSize[hop] = latSize[hop] ? latSize[hop] * 2 : 1024;
+        if ((lat[hop] = realloc(lat[hop], latSize[hop] * sizeof(*lat[hop]))) == NULL) {
+            abort();
+        }
+    }
+    lat[hop][latCnt[hop]++] = ns;
+}
+
+/* message after msg_t, lines of sensor readings with --text */
+static void fillBody(uint8_t *body, uint32_t size, uint32_t seq) {
+    char line[48];
+    int  len = 0;
+
+    if (opt.text) {
+        len = snprintf(line, sizeof(line), "temp=%u.%02u hum=%u.%02u bat=%umV\r\n", 21U + seq % 3U,
+                       (seq * 37U) % 100U, 40U + seq % 7U, (seq * 13U) % 100U, 3600U + seq % 200U);
+    }
+    for (uint32_t i = 0; i < size; ++i) {
+        body[i] = opt.text ? line[i % len] : (uint8_t) (seq + sizeof(msg_t) + i);
+    }
+}
+
+static void fillMsg(uint8_t *buf, uint32_t seq) {
+    msg_t msg = { .seq = seq, .time = HOST_Now() };
+
+    memcpy(buf, &msg, sizeof(msg));
+    fillBody(buf + sizeof(msg), opt.size - sizeof(msg), seq);
+}
+
+static uint8_t checkMsg(const uint8_t *buf, const msg_t *msg) {
+    uint8_t body[MSG_MAX_SIZE];
+
+    fillBody(body, opt.size - sizeof(*msg), msg->seq);
+    return !memcmp(buf + sizeof(*msg), body, opt.size - sizeof(*msg));
+}
+
+/* master side of the slave stream */
+static void reader(ULONG arg) {
+    slave_t          *s = (slave_t *) arg;
+    const sim_node_t *master = masters[s->cell];
+    uint8_t           buf[MSG_MAX_SIZE];
+    msg_t             msg;
+    uint64_t          now;
+    uint16_t          len = opt.size;
+
+    while (1) {
+        if (opt.msg) {
+            master->recv_msg(s->slot, buf, sizeof(buf), &len, GOD_BLOCK);
+        } else {
+            master->read(s->slot, buf, opt.size, GOD_BLOCK);
+        }
+        now = HOST_Now();
+        memcpy(&msg, buf, sizeof(msg));
+        if (len != opt.size || msg.seq != s->seq_rx || !checkMsg(buf, &msg)) {
+            ++s->errors;
+        }
+        s->seq_rx = msg.seq + 1;
+        if (!s->joined) {
+            s->joined = 1;
+            s->join_done = now;
+            tx_event_flags_set(&efJoin, JOIN_FLAG, TX_OR);
+            continue;
+        }
+        if (inWindow(now)) {
+            s->bytes_rx += opt.size;
+            addLatency(s->hop, now - msg.time);
+        }
+    }
+}
+
+/* application of the slave, first message tells the master it has joined */
+static void writer(ULONG arg) {
+    slave_t       *s = (slave_t *) arg;
+    uint8_t        buf[MSG_MAX_SIZE];
+    const uint32_t interval = (opt.size * TX_TIMER_TICKS_PER_SECOND + opt.rate - 1) / opt.rate;
+    ULONG          next = tx_time_get();
+    ULONG          now;
+
+    while (1) {
+        fillMsg(buf, s->seq_tx++);
+        (opt.msg ? s->node->send_msg : s->node->write)(buf, opt.size);
+        if (inWindow(HOST_Now())) {
+            s->bytes_tx += opt.size;
+        }
+        next += interval;
+        now = tx_time_get();
+        if ((LONG) (next - now) > 0) {
+            tx_thread_sleep(next - now);
+        } else {
+            next = now; /* GOD_Write blocked, the cell does not keep up */
+        }
+    }
+}
+
+/* announcements are on the home channel, one per period */
+static uint32_t scanTime(uint8_t cell) {
+    return opt.scan ? opt.scan : (GEODE_MCD_COUNT + cellJoined[cell] + 2 + (opt.relay ? GEODE_RLY_FRAMES : 0)) *
+                                     (opt.fast ? GEODE_FRAME_FAST_MS : GEODE_FRAME_MS);
+}
+
+/* entry of master or of the relay in GOD_Scan() results, the sync word leads it */
+static const uint8_t *findAnn(const uint8_t *ann, const sim_node_t *master) {
+    const uint32_t sync = SIM_NODE_UID0(master->radio->id);
+
+    for (uint8_t i = 0; ann != NULL && i < ann[0]; ++i) {
+        if (!memcmp((ann + 1) + (i * ANN_ENTRY_SIZE), &sync, sizeof(sync))) {
+            return (ann + 1) + (i * ANN_ENTRY_SIZE);
+        }
+    }
+    return NULL;
+}
+
+/* a master is started after it has heard the ones before it, so it leaves their channels */
+static void startMaster(uint8_t cell) {
+    uint8_t *ann = NULL;
+
+    for (uint8_t i = 0; cell && i < ANN_TRIES && (ann == NULL || ann[0] < cell); ++i) {
+        for (uint8_t k = 0; k < cell; ++k) {
+            masters[k]->announce(ANN_TICKS, annText);
+        }
+        ann = masters[cell]->scan(scanTime(0));
+    }
+    if (cell && (ann == NULL || ann[0] < cell)) {
+        LOG_WARN("godsim: master %u heard %u of %u masters", masters[cell]->radio->id, ann ? ann[0] : 0, cell);
+    }
+    masters[cell]->start(GOD_NODE_MASTER, NULL);
+}
+
+static uint8_t join(slave_t *s) {
+    const uint8_t *ann = NULL;
+    ULONG          flags;
+
+    s->join_start = HOST_Now();
+    for (uint8_t i = 0; i < ANN_TRIES && ann == NULL; ++i) {
+        masters[s->cell]->announce(ANN_TICKS, annText);
+        ann = findAnn(s->node->scan(scanTime(s->cell)), s->hop ? slaves[0].node : masters[s->cell]);
+    }
+    if (ann == NULL) {
+        LOG_ERROR("godsim: node %u found no master", s->node->radio->id);
+        return 0;
+    }
+    memcpy(s->ann, ann, ANN_ENTRY_SIZE);
+    s->slot = s->ann[ANN_SLOT];
+
+    tx_thread_create(&s->reader, "godsim reader", reader, (ULONG) s, s->reader_stack, GODSIM_STACK_SIZE,
+                     GODSIM_PRIO_READER, GODSIM_PRIO_READER, TX_NO_TIME_SLICE, TX_AUTO_START);
+    s->join_conn = HOST_Now();
+    s->node->start(GOD_NODE_SLAVE, s->ann);
+    tx_thread_create(&s->writer, "godsim writer", writer, (ULONG) s, s->writer_stack, GODSIM_STACK_SIZE,
+                     GODSIM_PRIO_WRITER, GODSIM_PRIO_WRITER, TX_NO_TIME_SLICE, TX_AUTO_START);
+
+    if (tx_event_flags_get(&efJoin, JOIN_FLAG, TX_OR_CLEAR, &flags, opt.join_to * TX_TIMER_TICKS_PER_SECOND) !=
+        TX_SUCCESS) {
+        LOG_ERROR("godsim: node %u did not join slot %u", s->node->radio->id, s->slot);
+        return 0;
+    }
+    LOG_INFO("godsim: node %u joined slot %u in %.1f s", s->node->radio->id, s->slot,
+             NS_TO_S(s->join_done - s->join_start));
+    if (opt.relay && s == &slaves[0] && s->node->relay() != GOD_OK) {
+        LOG_ERROR("godsim: node %u can not relay", s->node->radio->id);
+        return 0;
+    }
+    return 1;
+}
+
+static int cmpU64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *) a, y = *(const uint64_t *) b;
+    return (x > y) - (x < y);
+}
+
+/* nearest rank percentile of sorted values */
+static uint64_t percentile(const uint64_t *v, uint32_t n, uint32_t p) {
+    uint32_t rank = (n * p + 99) / 100;
+    return n ? v[(rank ? rank : 1) - 1] : 0;
+}
+
+static void printLatency(const char *label, uint8_t hop) {
+    qsort(lat[hop], latCnt[hop], sizeof(*lat[hop]), cmpU64);
+    printf("%s%u msgs [ms] p50 %.1f p90 %.1f p99 %.1f max %.1f\n", label, latCnt[hop],
+           NS_TO_MS(percentile(lat[hop], latCnt[hop], 50)), NS_TO_MS(percentile(lat[hop], latCnt[hop], 90)),
+           NS_TO_MS(percentile(lat[hop], latCnt[hop], 99)), NS_TO_MS(percentile(lat[hop], latCnt[hop], 100)));
+}
+
+/* upper bound of the bin holding p percent of GEODE histogram, ticks */
+static uint32_t histPercentile(const uint32_t *hist, uint32_t p) {
+    uint64_t total = 0, sum = 0;
+    uint8_t  i;
+
+    for (i = 0; i < GOD_HIST_BINS; ++i) {
+        total += hist[i];
+    }
+    for (i = 0; i < GOD_HIST_BINS - 1U && (sum += hist[i]) * 100U < total * p; ++i) {
+    }
+    return 1U << i;
+}
+
+/* radio duty and current of slaves in the window, GEODE accounting against the medium */
+static void printPower(void) {
+    double           duty = 0, air = 0, sleep = 0, current = 0;
+    god_radio_stat_t pwr;
+
+    for (uint32_t i = 0; i < joined; ++i) {
+        const sim_radio_t *radio = slaves[i].node->radio;
+        slaves[i].node->radio_stat(&pwr);
+        const double on = (double) (pwr.rx_us - slaves[i].pwr.rx_us + pwr.tx_us - slaves[i].pwr.tx_us);
+        const double all = on + (double) (pwr.idle_us - slaves[i].pwr.idle_us + pwr.sleep_us - slaves[i].pwr.sleep_us);
+        if (all > 0) {
+            duty += on / all;
+            sleep += (pwr.sleep_us - slaves[i].pwr.sleep_us) / all;
+        }
+        air += (double) (radio->stats.rx_ns + radio->stats.tx_ns - slaves[i].air_ns) / (winEnd - winBegin);
+        current += pwr.current_ua;
+    }
+    if (joined) {
+        printf("power:   slave radio duty [%%] avg %.2f (medium %.2f), sleep avg %.1f, current since start avg %.0f uA\n",
+               100.0 * duty / joined, 100.0 * air / joined, 100.0 * sleep / joined, current / joined);
+    }
+}
+
+static void report(void) {
+    const double      window = NS_TO_S(winEnd - winBegin);
+    uint64_t         *join = malloc((joined + 1) * sizeof(*join));
+    double            rx, rx_min = 0, rx_max = 0, rx_sum = 0, tx_sum = 0, cell[GODSIM_MASTERS_MAX] = {}, hop[2] = {};
+    uint64_t          air = 0;
+    uint32_t          direct = 0, hops[2] = {};
+    uint32_t          errors = 0;
+    sim_radio_stats_t radio;
+    god_mem_t         mem;
+    god_link_stat_t   link, links = {};
+    god_tx_stat_t     tx, txs = {};
+
+    printf("godsim: %u master%s + %u slaves, %u B messages at %u B/s per slave, loss %u ppm, drift +-%u ppm\n",
+           opt.masters, opt.masters > 1 ? "s" : "", opt.slaves, opt.size, opt.rate, opt.loss, opt.drift);
+    if (opt.msg) {
+        printf("api:     GOD_SendMsg / GOD_RecvMsg\n");
+    }
+    if (opt.fast) {
+        printf("profile: GOD_PROFILE_FAST\n");
+    }
+    if (opt.jam) {
+        printf("jam:     %u kHz, loss %u ppm\n", opt.jam, opt.jam_loss);
+    }
+    if (opt.fade) {
+        printf("fade:    %u kHz, %u dB\n", opt.fade, opt.fade_db);
+    }
+    if (opt.legacy || opt.legacy_master) {
+        printf("arq:     master window %u, %u slaves single bit\n", masters[0]->window, opt.legacy);
+    }
+
+    for (uint32_t i = 0; i < joined; ++i) {
+        join[i] = slaves[i].join_done - slaves[i].join_start;
+    }
+    qsort(join, joined, sizeof(*join), cmpU64);
+    printf("join:    %u/%u slaves, per slave [s] p50 %.1f p90 %.1f p99 %.1f max %.1f\n", joined, opt.slaves,
+           NS_TO_S(percentile(join, joined, 50)), NS_TO_S(percentile(join, joined, 90)),
+           NS_TO_S(percentile(join, joined, 99)), NS_TO_S(percentile(join, joined, 100)));
+    for (uint32_t i = 0; i < joined; ++i) {
+        join[i] = slaves[i].join_done - slaves[i].join_conn;
+    }
+    qsort(join, joined, sizeof(*join), cmpU64);
+    printf("connect: GOD_Start to first message [ms] p50 %.1f p90 %.1f p99 %.1f max %.1f\n",
+           NS_TO_MS(percentile(join, joined, 50)), NS_TO_MS(percentile(join, joined, 90)),
+           NS_TO_MS(percentile(join, joined, 99)), NS_TO_MS(percentile(join, joined, 100)));
+    free(join);
+
+    for (uint32_t i = 0; i < joined; ++i) {
+        rx = slaves[i].bytes_rx / window;
+        rx_min = (i == 0 || rx < rx_min) ? rx : rx_min;
+        rx_max = (rx > rx_max) ? rx : rx_max;
+        rx_sum += rx;
+        cell[slaves[i].cell] += rx;
+        hop[slaves[i].hop] += rx;
+        ++hops[slaves[i].hop];
+        tx_sum += slaves[i].bytes_tx / window;
+        errors += slaves[i].errors;
+    }
+    printf("goodput: %.0f s window, per slave [B/s] min %.2f avg %.2f max %.2f, written avg %.2f, cell %.1f\n",
+           window, rx_min, joined ? rx_sum / joined : 0, rx_max, joined ? tx_sum / joined : 0, rx_sum);
+    if (opt.masters > 1) {
+        printf("cells:   [B/s]");
+        for (uint32_t k = 0; k < opt.masters; ++k) {
+            printf(" %.1f (%u slaves)", cell[k], cellJoined[k]);
+        }
+        printf("\n");
+    }
+
+    if (opt.relay) {
+        /* the relay is a direct slave, airtime of the rest tells what relaying costs it */
+        for (uint32_t i = 1; i < joined; ++i) {
+            air += slaves[i].hop ? 0 : slaves[i].node->radio->stats.tx_ns;
+            direct += !slaves[i].hop;
+        }
+        printf("relay:   node %u, per slave [B/s] direct %.2f relayed %.2f, airtime %.1f s, direct slave avg %.1f s\n",
+               slaves[0].node->radio->id, hops[0] ? hop[0] / hops[0] : 0, hops[1] ? hop[1] / hops[1] : 0,
+               NS_TO_S(slaves[0].node->radio->stats.tx_ns), direct ? NS_TO_S(air / direct) : 0);
+        printLatency("latency: direct ", 0);
+        printLatency("latency: relayed ", 1);
+    } else {
+        printLatency("latency: ", 0);
+    }
+
+    printPower();
+
+    SIM_RadioTotals(&radio);
+    printf("radio:   tx %u rx %u collided %u lost %u crc %u, airtime %.1f s\n", radio.tx, radio.rx, radio.collided,
+           radio.lost, radio.crc, NS_TO_S(radio.tx_ns));
+    for (uint32_t i = 0; i < joined; ++i) {
+        if (masters[slaves[i].cell]->link_stat(slaves[i].slot, &link) == GOD_OK) {
+            links.rx += link.rx;
+            links.dup += link.dup;
+            links.lost += link.lost;
+            links.bytes += link.bytes;
+            links.packed += link.packed;
+        }
+        if (slaves[i].node->tx_stat(&tx) == GOD_OK) {
+            txs.tx += tx.tx;
+            txs.retx += tx.retx;
+            txs.bytes += tx.bytes;
+            txs.packed += tx.packed;
+            for (uint8_t b = 0; b < GOD_HIST_BINS; ++b) {
+                txs.queue[b] += tx.queue[b];
+                txs.delivery[b] += tx.delivery[b];
+            }
+        }
+    }
+    printf("links:   master rx %u dup %u lost %u, slaves tx %u retx %u\n", links.rx, links.dup, links.lost, txs.tx,
+           txs.retx);
+    printf("pack:    slaves wrote %u B to %u B of streams, master got %u B in %u B, ratio %.2f, goodput gain x%.2f\n",
+           txs.bytes, txs.packed, links.bytes, links.packed, links.bytes ? (double) links.packed / links.bytes : 0,
+           links.packed ? (double) links.bytes / links.packed : 0);
+    printf("stats:   GEODE histograms [ms] queue p50 <%u p99 <%u, delivery p50 <%u p99 <%u\n",
+           histPercentile(txs.queue, 50), histPercentile(txs.queue, 99), histPercentile(txs.delivery, 50),
+           histPercentile(txs.delivery, 99));
+    for (uint32_t k = 0; k < opt.masters; ++k) {
+        if (masters[k]->mem_usage(&mem) == GOD_OK) {
+            printf("memory:  rx pool %u x %u B blocks, used %u peak %u, %u slots\n", mem.blks, mem.blk_size,
+                   mem.used, mem.peak, mem.slots);
+        }
+    }
+    printf("errors:  %u messages out of order or corrupted\n", errors);
+
+    if (opt.verbose) {
+        printf("\n  node cell slot  arq   join[s]  written[B/s]  goodput[B/s]  errors\n");
+        for (uint32_t i = 0; i < joined; ++i) {
+            printf("  %4u %4u %4u %4u %9.1f %13.2f %13.2f %7u\n", slaves[i].node->radio->id, slaves[i].cell,
+                   slaves[i].slot,
+                   slaves[i].node->window, NS_TO_S(slaves[i].join_done - slaves[i].join_start),
+                   slaves[i].bytes_tx / window,
+                   slaves[i].bytes_rx / window, slaves[i].errors);
+        }
+    }
+    fflush(stdout);
+}
+
+/* clock deviation of node in [-drift, drift] */
+static int32_t drift(uint16_t id) {
+    uint32_t x = (id + 1) * 2654435761U ^ opt.seed;
+    x ^= x >> 15;
+    x *= 0x2C1B3C6DU;
+    x ^= x >> 12;
+    return opt.drift ? (int32_t) (x % (2 * opt.drift + 1)) - (int32_t) opt.drift : 0;
+}
+
+/* nodes of the section in turn, windowed or single bit ones */
+static uint16_t countNodes(uint8_t legacy) {
+    uint16_t n = 0;
+    for (uint16_t i = 0; i < SIM_NODE_COUNT; ++i) {
+        n += (SIM_NODES[i]->window == 1) == legacy;
+    }
+    return n;
+}
+
+static const sim_node_t *bringUp(uint8_t legacy) {
+    static uint16_t next[2];
+    static uint16_t id;
+
+    while ((SIM_NODES[next[legacy]]->window == 1) != legacy) {
+        ++next[legacy];
+    }
+    const sim_node_t *node = SIM_NODES[next[legacy]++];
+    node->init(id, drift(id));
+    if (node->god_init() != GOD_OK || (opt.fast && node->set_profile(GOD_PROFILE_FAST) != GOD_OK)) {
+        LOG_ERROR("godsim: node %u init failed", id);
+        HOST_Exit(EXIT_FAILURE);
+    }
+    ++id;
+    return node;
+}
+
+static void control(ULONG arg) {
+    UNUSED(arg);
+
+    for (uint32_t k = 0; k < opt.masters; ++k) {
+        masters[k] = bringUp(k == 0 && opt.legacy_master);
+    }
+    for (uint32_t i = 0; i < opt.slaves; ++i) {
+        slaves[i].node = bringUp(i < opt.legacy);
+        slaves[i].cell = i % opt.masters;
+        slaves[i].hop = i >= opt.slaves - opt.relay;
+        slaves[i].node->radio->zone = (opt.relay && i == 0) ? 1 : slaves[i].hop * 2;
+    }
+    for (uint32_t k = 0; k < opt.masters; ++k) {
+        startMaster(k);
+    }
+
+    for (uint32_t i = 0; i < opt.slaves; ++i) {
+        if (!join(&slaves[i])) {
+            break;
+        }
+        ++joined;
+        ++cellJoined[slaves[i].cell];
+    }
+
+    winBegin = HOST_Now();
+    winEnd = winBegin + opt.time * HOST_NS_PER_S;
+    for (uint32_t i = 0; i < joined; ++i) {
+        slaves[i].node->radio_stat(&slaves[i].pwr);
+        slaves[i].air_ns = slaves[i].node->radio->stats.rx_ns + slaves[i].node->radio->stats.tx_ns;
+    }
+    tx_thread_sleep(opt.time * TX_TIMER_TICKS_PER_SECOND);
+
+    report();
+    HOST_Exit(joined == opt.slaves ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+void tx_application_define(VOID *first_unused_memory) {
+    UNUSED(first_unused_memory);
+
+    if (tx_event_flags_create(&efJoin, "godsim join") != TX_SUCCESS ||
+        tx_thread_create(&ctrl, "godsim", control, 0, ctrl_stack, GODSIM_STACK_SIZE, GODSIM_PRIO_CTRL,
+                         GODSIM_PRIO_CTRL, TX_NO_TIME_SLICE, TX_AUTO_START) != TX_SUCCESS) {
+        Error_Handler();
+    }
+}
+
+static uint8_t option(const char *arg, const char *name, uint32_t *value) {
+    size_t len = strlen(name);
+    if (strncmp(arg, name, len) || arg[len] != '=') {
+        return 0;
+    }
+    *value = strtoul(arg + len + 1, NULL, 0);
+    return 1;
+}
+
+static void usage(const char *arg) {
+    fprintf(stderr,
+            "godsim: unknown option %s\n"
+            "  --masters=N    cells side by side (up to %u)\n"
+            "  --slaves=N     slaves of all cells (up to %u)\n"
+            "  --rate=B       bytes per second written by every slave\n"
+            "  --size=B       message size, %u..%u\n"
+            "  --time=S       measurement time after all slaves joined, s\n"
+            "  --loss=PPM     packet loss at every receiver\n"
+            "  --drift=PPM    clock deviation of nodes, random in +-PPM\n"
+            "  --jam=KHZ      interferer on the channel\n"
+            "  --jam-loss=PPM packet loss at receivers on the jammed channel\n"
+            "  --fade=KHZ     RSSI drop on the channel, no loss\n"
+            "  --fade-db=DB   RSSI drop on the faded channel\n"
+            "  --scan=MS      GOD_Scan() time of joining slave, 0 fits the period\n"
+            "  --join-to=S    join timeout\n"
+            "  --seed=N       seed of loss and drift\n"
+            "  --log=N        log level, 0 debug .. 4 quiet\n"
+            "  --legacy=N     first N slaves run single bit ARQ (up to %u)\n"
+            "  --legacy-master first master runs single bit ARQ\n"
+            "  --relay=N      last N slaves are reached through the first one (one master)\n"
+            "  --msg          message API\n"
+            "  --text         telemetry text in messages\n"
+            "  --fast         fast radio profile\n"
+            "  --verbose      per slave table\n",
+            arg, GODSIM_MASTERS_MAX, SIM_NODE_COUNT - 1, (unsigned) MSG_MIN_SIZE, MSG_MAX_SIZE, countNodes(1));
+    HOST_Exit(EXIT_FAILURE);
+}
+
+int main(int argc, char **argv) {
+    argc = HOST_SimInit(argc, argv);
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        if (!strcmp(arg, "--verbose")) {
+            opt.verbose = 1;
+        } else if (!strcmp(arg, "--legacy-master")) {
+            opt.legacy_master = 1;
+        } else if (!strcmp(arg, "--msg")) {
+            opt.msg = 1;
+        } else if (!strcmp(arg, "--fast")) {
+            opt.fast = 1;
+        } else if (!strcmp(arg, "--text")) {
+            opt.text = 1;
+        } else if (!option(arg, "--masters", &opt.masters) && !option(arg, "--slaves", &opt.slaves) && !option(arg, "--rate", &opt.rate) &&
+                   !option(arg, "--size", &opt.size) && !option(arg, "--time", &opt.time) &&
+                   !option(arg, "--loss", &opt.loss) && !option(arg, "--drift", &opt.drift) &&
+                   !option(arg, "--jam", &opt.jam) && !option(arg, "--jam-loss", &opt.jam_loss) &&
+                   !option(arg, "--fade", &opt.fade) && !option(arg, "--fade-db", &opt.fade_db) &&
+                   !option(arg, "--scan", &opt.scan) && !option(arg, "--join-to", &opt.join_to) &&
+                   !option(arg, "--seed", &opt.seed) && !option(arg, "--log", &opt.log) &&
+                   !option(arg, "--legacy", &opt.legacy) && !option(arg, "--relay", &opt.relay)) {
+            usage(arg);
+        }
+    }
+    if (opt.masters == 0 || opt.masters > GODSIM_MASTERS_MAX || opt.slaves == 0 || opt.slaves > GOD_MAX_CONN || opt.rate == 0 || opt.size < MSG_MIN_SIZE ||
+        opt.size > MSG_MAX_SIZE || opt.legacy > opt.slaves || opt.legacy + opt.legacy_master > countNodes(1) ||
+        opt.slaves - opt.legacy + opt.masters - opt.legacy_master > countNodes(0) ||
+        (opt.relay && (opt.masters > 1 || opt.relay >= opt.slaves))) {
+        usage("(out of range)");
+    }
+    SIM_LogLevel = opt.log;
+    SIM_Medium.loss_ppm = opt.loss;
+    SIM_Medium.jam_frequency = opt.jam;
+    SIM_Medium.jam_ppm = opt.jam_loss;
+    SIM_Medium.fade_frequency = opt.fade;
+    SIM_Medium.fade_db = (uint16_t) opt.fade_db;
+    SIM_Medium.seed = opt.seed;
+
+    if ((slaves = calloc(opt.slaves, sizeof(*slaves))) == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    HAL_Init();
+    tx_kernel_enter();
+
+    return EXIT_FAILURE;
+}
+
+void Error_Handler(void) {
+    fprintf(stderr, "Error_Handler at %llu ns\n", (unsigned long long) HOST_Now());
+    HOST_Exit(EXIT_FAILURE);
+}
@@ -0,0 +1,305 @@
+/**
+ * @file host_sim.c
+ * @brief Virtual time core of the HOST target
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/select.h>
+
+#include "main.h"
+#include "host_sim.h"
+#include "tx_api.h"
+
+#define SIM_OPT_PREFIX "--sim-"
+#define SIM_SYNC_MAX   (16)
+#define SIM_INPUT_SIZE (64)
+#define SIM_TICK_NS    (HOST_NS_PER_S / TX_TIMER_TICKS_PER_SECOND)
+
+/* ThreadX host port entries */
+VOID _tx_timer_interrupt(VOID);
+VOID _tx_thread_context_save(VOID);
+VOID _tx_thread_context_restore(VOID);
+
+extern UINT _tx_linux_interrupt_posture;
+
+host_latency_t HOST_Latency = {
+    .irq_ns = 1000,
+    .dma_ns = 2000,
+    .exti_ns = 500,
+    .spi_hz = 10000000,
+    .i2c_hz = 400000,
+    .ospi_hz = 40000000,
+};
+
+static uint64_t now;
+static uint64_t seq;
+static uint64_t stop_at;
+static uint8_t  realtime;
+
+static host_event_t **queue;
+static uint32_t       queue_len;
+static uint32_t       queue_size;
+
+static void (*sync_fn[SIM_SYNC_MAX])(void);
+static uint8_t sync_cnt;
+
+static void (*input_fn)(const uint8_t *data, size_t len);
+
+static host_event_t    tick;
+static struct timespec wall_start;
+
+static inline uint8_t earlier(const host_event_t *a, const host_event_t *b) {
+    return a->time < b->time || (a->time == b->time && a->seq < b->seq);
+}
+
+static inline void place(host_event_t *ev, uint32_t slot) {
+    queue[slot] = ev;
+    ev->slot = slot;
+}
+
+static void siftUp(uint32_t slot) {
+    host_event_t *ev = queue[slot];
+    while (slot && earlier(ev, queue[(slot - 1) / 2])) {
+        place(queue[(slot - 1) / 2], slot);
+        slot = (slot - 1) / 2;
+    }
+    place(ev, slot);
+}
+
+static void siftDown(uint32_t slot) {
+    host_event_t *ev = queue[slot];
+    uint32_t      child;
+    while ((child = 2 * slot + 1) < queue_len) {
+        if (child + 1 < queue_len && earlier(queue[child + 1], queue[child])) {
+            ++child;
+        }
+        if (!earlier(queue[child], ev)) {
+            break;
+        }
+        place(queue[child], slot);
+        slot = child;
+    }
+    place(ev, slot);
+}
+
+void HOST_EventInit(host_event_t *ev, host_event_fn_t fn) {
+    ev->fn = fn;
+    ev->slot = -1;
+    ev->time = 0;
+}
+
+void HOST_EventArm(host_event_t *ev, uint64_t time) {
+    HOST_EventDisarm(ev);
+    if (queue_len == queue_size) {
+        queue_size = queue_size ? queue_size * 2 : 64;
+        queue = realloc(queue, queue_size * sizeof(*queue));
+        if (queue == NULL) {
+            abort();
+        }
+    }
+    ev->time = (time < now) ? now : time;
+    ev->seq = seq++;
+    place(ev, queue_len++);
+    siftUp(ev->slot);
+}
+
+void HOST_EventArmIn(host_event_t *ev, uint64_t delay) {
+    HOST_EventArm(ev, now + delay);
+}
+
+void HOST_EventDisarm(host_event_t *ev) {
+    uint32_t slot = ev->slot;
+    if (ev->slot < 0) {
+        return;
+    }
+    ev->slot = -1;
+    if (slot == --queue_len) {
+        return;
+    }
+    place(queue[queue_len], slot);
+    if (slot && earlier(queue[slot], queue[(slot - 1) / 2])) {
+        siftUp(slot);
+    } else {
+        siftDown(slot);
+    }
+}
+
+uint8_t HOST_EventArmed(const host_event_t *ev) {
+    return ev->slot >= 0;
+}
+
+uint64_t HOST_Now(void) {
+    return now;
+}
+
+ULONG64 _tx_linux_time_stamp_get(VOID) {
+    return now;
+}
+
+void HOST_SyncRegister(void (*fn)(void)) {
+    if (sync_cnt == SIM_SYNC_MAX) {
+        abort();
+    }
+    sync_fn[sync_cnt++] = fn;
+}
+
+void HOST_InputRegister(void (*fn)(const uint8_t *data, size_t len)) {
+    input_fn = fn;
+}
+
+void HOST_StopAt(uint64_t time) {
+    stop_at = time;
+}
+
+void HOST_Exit(int code) {
+    fflush(stdout);
+    exit(code);
+}
+
+static void syncAll(void) {
+    for (uint8_t i = 0; i < sync_cnt; ++i) {
+        sync_fn[i]();
+    }
+}
+
+/* runs the first event of the queue as an interrupt */
+static void dispatch(void) {
+    host_event_t *ev = queue[0];
+    HOST_EventDisarm(ev);
+    if (ev->time > now) {
+        now = ev->time;
+        syncAll(); /* clock based registers */
+    }
+    _tx_thread_context_save();
+    ev->fn(ev);
+    _tx_thread_context_restore();
+}
+
+static uint64_t wallElapsed(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec - wall_start.tv_sec) * HOST_NS_PER_S + ts.tv_nsec - wall_start.tv_nsec;
+}
+
+/* sleeps until the event is due, returns 0 if console input came first */
+static uint8_t pace(uint64_t time) {
+    uint64_t wall;
+    while ((wall = wallElapsed()) < time) {
+        uint64_t       left = time - wall;
+        fd_set         fds;
+        struct timeval tv = { .tv_sec = left / HOST_NS_PER_S, .tv_usec = (left % HOST_NS_PER_S) / HOST_NS_PER_US };
+        FD_ZERO(&fds);
+        FD_SET(STDIN_FILENO, &fds);
+        if (select(STDIN_FILENO + 1, input_fn ? &fds : NULL, NULL, NULL, &tv) > 0) {
+            uint8_t buf[SIM_INPUT_SIZE];
+            ssize_t len = read(STDIN_FILENO, buf, sizeof(buf));
+            if (len <= 0) {
+                input_fn = NULL; /* EOF, keep running without console */
+                continue;
+            }
+            if (wall > now) {
+                now = wall;
+            }
+            _tx_thread_context_save();
+            input_fn(buf, len);
+            _tx_thread_context_restore();
+            return 0;
+        }
+    }
+    return 1;
+}
+
+VOID _tx_linux_idle(VOID) {
+    syncAll();
+    if (queue_len == 0) {
+        fprintf(stderr, "sim: nothing to run at %llu ns\n", (unsigned long long) now);
+        HOST_Exit(EXIT_FAILURE);
+    }
+    if (stop_at && queue[0]->time > stop_at) {
+        now = stop_at;
+        HOST_Exit(EXIT_SUCCESS);
+    }
+    if (realtime && !pace(queue[0]->time)) {
+        return;
+    }
+    dispatch();
+}
+
+void HOST_Spin(uint64_t ns) {
+    uint64_t deadline = now + ns;
+    while (1) {
+        syncAll();
+        if (!queue_len || queue[0]->time > deadline || _tx_linux_interrupt_posture != TX_INT_ENABLE) {
+            break;
+        }
+        dispatch();
+    }
+    if (now < deadline) {
+        now = deadline;
+    }
+}
+
+static void tickHandler(host_event_t *ev) {
+    HOST_EventArm(ev, ev->time + SIM_TICK_NS);
+    HAL_IncTick();
+    _tx_timer_interrupt();
+}
+
+static uint8_t option(const char *arg, const char *name, uint32_t *value) {
+    size_t len = strlen(name);
+    if (strncmp(arg, name, len) || arg[len] != '=') {
+        return 0;
+    }
+    *value = strtoul(arg + len + 1, NULL, 0);
+    return 1;
+}
+
+int HOST_SimInit(int argc, char **argv) {
+    int      out = 1;
+    uint32_t sec;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        if (strncmp(arg, SIM_OPT_PREFIX, strlen(SIM_OPT_PREFIX))) {
+            argv[out++] = argv[i];
+            continue;
+        }
+        arg += strlen(SIM_OPT_PREFIX);
+        if (!strcmp(arg, "realtime")) {
+            realtime = 1;
+        } else if (option(arg, "time", &sec)) {
+            stop_at = sec * HOST_NS_PER_S;
+        } else if (!option(arg, "irq-ns", &HOST_Latency.irq_ns) && !option(arg, "dma-ns", &HOST_Latency.dma_ns) &&
+                   !option(arg, "exti-ns", &HOST_Latency.exti_ns) && !option(arg, "spi-hz", &HOST_Latency.spi_hz) &&
+                   !option(arg, "i2c-hz", &HOST_Latency.i2c_hz) && !option(arg, "ospi-hz", &HOST_Latency.ospi_hz)) {
+            fprintf(stderr,
+                    "sim: unknown option %s\n"
+                    "  --sim-realtime      pace virtual time to wall clock, stdin feeds the console\n"
+                    "  --sim-time=S        stop after S seconds of virtual time\n"
+                    "  --sim-irq-ns=N      interrupt latency\n"
+                    "  --sim-dma-ns=N      DMA setup time\n"
+                    "  --sim-exti-ns=N     EXTI latency\n"
+                    "  --sim-spi-hz=N      SPI clock\n"
+                    "  --sim-i2c-hz=N      I2C clock\n"
+                    "  --sim-ospi-hz=N     OCTOSPI clock\n",
+                    argv[i]);
+            HOST_Exit(EXIT_FAILURE);
+        }
+    }
+    argv[out] = NULL;
+
+    clock_gettime(CLOCK_MONOTONIC, &wall_start);
+    HOST_EventInit(&tick, tickHandler);
+    HOST_EventArm(&tick, SIM_TICK_NS);
+
+    return out;
+}
@@ -0,0 +1,347 @@
+/**
+ * @file kvbench.c
+ * @brief KV store benchmark.
+ *        Runs the unmodified KV store, FLASH module and IS25L driver on the flash model and reports:
+ *            + Put latency, write amplification (bytes programmed per byte of values) and erases
+ *            + Erase counts of sectors of the region, how even wear leveling keeps them
+ *            + Mount time of a blank region and of the region after the run
+ *            + The same updates done as apps do them, FLASH_Erase() and FLASH_Write() at fixed addresses
+ *        ### How to run ###
+ *     make -C Target/HOST kvbench KVBENCH_ARGS="--updates=20000 --size=48"
+ *     Cold keys are written once, the rest are updated in random order --period ms apart, so the background
+ *     compaction runs in between. Every --del-th update deletes a key instead. After the run the store is
+ *     mounted again and every key is checked against the values written, mismatches show up as errors.
+ *     The last put before that is torn in the flash model, as by power loss, so mount has to drop it
+ *     + --sim-* options of host_sim.h apply as well
+ *
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ *  (c) 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "main.h"
+#include "tx_api.h"
+#include "octospi.h"
+#include "loglib.h"
+#include "host_sim.h"
+#include "sim_is25l.h"
+#include "flash.h"
+#include "kv.h"
+
+#define KVBENCH_STACK_SIZE (2048U)
+#define KVBENCH_PRIO       (10U)
+#define LEGACY_ADDR        (0x200000U) /* fixed addresses of the legacy run */
+
+#define NS_TO_MS(_ns) ((double) (_ns) / HOST_NS_PER_MS)
+
+static struct {
+    uint32_t keys;
+    uint32_t cold;    /* keys written once */
+    uint32_t size;    /* value size */
+    uint32_t updates;
+    uint32_t period;  /* ms */
+    uint32_t del;     /* every del-th update is a delete, 0 - none */
+    uint32_t legacy;  /* updates of the legacy run */
+    uint32_t seed;
+    uint32_t log;
+} opt = {
+    .keys = 32,
+    .cold = 16,
+    .size = 48,
+    .updates = 20000,
+    .period = 10,
+    .del = 50,
+    .legacy = 1000,
+    .seed = 1,
+    .log = LOG_T_WARN,
+};
+
+extern log_type_t SIM_LogLevel;
+
+static TX_THREAD ctrl;
+static uint8_t   ctrl_stack[KVBENCH_STACK_SIZE];
+static uint32_t  version[KV_KEYS_MAX]; /* 0 - deleted */
+static uint8_t   value[KV_VALUE_MAX];
+static uint8_t   check[KV_VALUE_MAX];
+static uint64_t *lat;
+static uint32_t  errors;
+static uint64_t  rnd;
+
+static uint32_t random32(void) {
+    rnd ^= rnd << 13;
+    rnd ^= rnd >> 7;
+    rnd ^= rnd << 17;
+    return rnd >> 32;
+}
+
+/* value of a key at a version, so it is checked without keeping it */
+static void fillValue(uint8_t *buf, uint32_t key, uint32_t ver) {
+    uint32_t x = key * 2654435761U ^ ver * 40503U;
+    for (uint32_t i = 0; i < opt.size; ++i) {
+        x = x * 1103515245U + 12345U;
+        buf[i] = x >> 24;
+    }
+}
+
+static int cmpU64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *) a, y = *(const uint64_t *) b;
+    return (x > y) - (x < y);
+}
+
+/* nearest rank percentile of sorted values */
+static uint64_t percentile(const uint64_t *v, uint32_t n, uint32_t p) {
+    uint32_t rank = (n * p + 99) / 100;
+    return n ? v[(rank ? rank : 1) - 1] : 0;
+}
+
+static void wearSpread(uint32_t addr, uint32_t sectors, uint32_t *lo, uint32_t *hi) {
+    const sim_is25l_stats_t *fs = SIM_IS25L_Stats();
+
+    *lo = UINT32_MAX;
+    *hi = 0;
+    for (uint32_t s = addr / SIM_IS25L_SECTOR_SIZE; s < addr / SIM_IS25L_SECTOR_SIZE + sectors; ++s) {
+        *lo = (fs->sector_wear[s] < *lo) ? fs->sector_wear[s] : *lo;
+        *hi = (fs->sector_wear[s] > *hi) ? fs->sector_wear[s] : *hi;
+    }
+}
+
+static uint64_t mount(void) {
+    uint64_t start = HOST_Now();
+
+    if (KV_Init() != KV_OK) {
+        printf("kvbench: KV_Init failed\n");
+        HOST_Exit(EXIT_FAILURE);
+    }
+    return HOST_Now() - start;
+}
+
+static void verify(void) {
+    for (uint32_t k = 0; k < opt.keys; ++k) {
+        uint16_t   len;
+        kv_state_t state = KV_Get(k, check, sizeof(check), &len);
+
+        if (!version[k]) {
+            errors += state != KV_NOT_FOUND;
+            continue;
+        }
+        fillValue(value, k, version[k]);
+        errors += state != KV_OK || len != opt.size || memcmp(value, check, opt.size);
+    }
+}
+
+/* unprograms the last byte of the value in the flash if nothing was written after it */
+static uint8_t tornLast(void) {
+    uint8_t *const region = SIM_IS25L_Memory() + KV_ADDR;
+    uint8_t       *rec = memmem(region, KV_SECTORS * SIM_IS25L_SECTOR_SIZE, value, opt.size);
+    uint32_t       end, i;
+
+    if (rec == NULL) {
+        return 0;
+    }
+    end = (rec - region) + opt.size;
+    for (i = end; i % SIM_IS25L_SECTOR_SIZE && i < end + 8U && rec[i - (rec - region)] == 0xFF; ++i) {
+    }
+    if (i % SIM_IS25L_SECTOR_SIZE && i < end + 8U) {
+        return 0; /* a compaction copied records after it */
+    }
+    for (i = opt.size; i && rec[i - 1] == 0xFF; --i) {
+    }
+    if (!i) {
+        return 0;
+    }
+    rec[i - 1] = 0xFF;
+    return 1;
+}
+
+static void control(ULONG arg) {
+    kv_stats_t st;
+    uint32_t   lo, hi, puts = 0, dels = 0;
+    uint8_t    torn;
+    uint64_t   mountBlank, mountFull, bytes = 0, programmed;
+
+    UNUSED(arg);
+
+    if (FLASH_Init() != FLASH_OK) {
+        printf("kvbench: FLASH_Init failed\n");
+        HOST_Exit(EXIT_FAILURE);
+    }
+    mountBlank = mount();
+
+    SIM_IS25L_ResetStats();
+    for (uint32_t i = 0; i < opt.keys + opt.updates; ++i) {
+        /* every key once, then hot ones */
+        const uint32_t k = (i < opt.keys) ? i : opt.cold + random32() % (opt.keys - opt.cold);
+        const uint64_t start = HOST_Now();
+        kv_state_t     state;
+
+        if (i >= opt.keys && opt.del && !(i % opt.del) && version[k]) {
+            state = KV_Delete(k);
+            version[k] = 0;
+            ++dels;
+        } else {
+            fillValue(value, k, ++version[k]);
+            state = KV_Put(k, value, opt.size);
+            bytes += opt.size;
+            lat[puts++] = HOST_Now() - start;
+        }
+        if (state != KV_OK) {
+            printf("kvbench: update %u of key %u failed: %d\n", i, k, state);
+            ++errors;
+        }
+        tx_thread_sleep(opt.period);
+    }
+    KV_GetStats(&st);
+    programmed = SIM_IS25L_Stats()->bytes_programmed;
+    wearSpread(KV_ADDR, KV_SECTORS, &lo, &hi);
+    verify();
+
+    /* power loss in the last put: the end of its value is left unprogrammed, mount keeps the previous one */
+    tx_thread_sleep(TX_TIMER_TICKS_PER_SECOND);
+    fillValue(value, opt.cold, UINT32_MAX);
+    errors += KV_Put(opt.cold, value, opt.size) != KV_OK;
+    KV_Deinit();
+    torn = tornLast();
+    if (!torn) {
+        version[opt.cold] = UINT32_MAX;
+    }
+    mountFull = mount();
+    verify();
+
+    qsort(lat, puts, sizeof(*lat), cmpU64);
+    printf("kvbench: %u keys (%u cold) of %u B, %u updates every %u ms, delete every %u, region %u x 4 KB at 0x%06X\n",
+           opt.keys, opt.cold, opt.size, opt.updates, opt.period, opt.del, KV_SECTORS, KV_ADDR);
+    printf("put:     %u puts [ms] p50 %.2f p99 %.2f max %.2f, %u deletes\n", puts, NS_TO_MS(percentile(lat, puts, 50)),
+           NS_TO_MS(percentile(lat, puts, 99)), NS_TO_MS(percentile(lat, puts, 100)), dels);
+    printf("write:   %.1f KB of values, %.1f KB programmed, write amplification %.2f, copied %.1f KB\n", bytes / 1024.0,
+           programmed / 1024.0, bytes ? (double) programmed / bytes : 0, st.copied / 1024.0);
+    printf("erase:   %u sectors, %.4f per update, compactions %u (background %u, wear %u)\n", st.erases,
+           (double) st.erases / (puts + dels), st.compactions, st.background, st.wear);
+    printf("wear:    sector erases min %u max %u, %u free sectors\n", lo, hi, st.free);
+    printf("mount:   blank region %.2f ms, after the run %.2f ms, %s\n", NS_TO_MS(mountBlank), NS_TO_MS(mountFull),
+           torn ? "torn last put dropped" : "torn put not checked, compaction went after it");
+
+    /* the same updates at fixed addresses */
+    SIM_IS25L_ResetStats();
+    const uint64_t start = HOST_Now();
+    for (uint32_t i = 0; i < opt.legacy; ++i) {
+        const uint32_t k = opt.cold + random32() % (opt.keys - opt.cold);
+        const uint32_t addr = LEGACY_ADDR + k * opt.size;
+
+        fillValue(value, k, i + 1);
+        if (FLASH_Erase(addr, opt.size) != FLASH_OK || FLASH_Write(value, addr, opt.size) != FLASH_OK) {
+            ++errors;
+        }
+    }
+    if (opt.legacy) {
+        const sim_is25l_stats_t *fs = SIM_IS25L_Stats();
+        wearSpread(LEGACY_ADDR, (opt.keys * opt.size + SIM_IS25L_SECTOR_SIZE - 1) / SIM_IS25L_SECTOR_SIZE, &lo, &hi);
+        printf("legacy:  FLASH_Erase+FLASH_Write, %u updates %.2f ms each, write amplification %.2f, %.2f erases per "
+               "update, sector erases max %u\n",
+               opt.legacy, NS_TO_MS(HOST_Now() - start) / opt.legacy,
+               (double) fs->bytes_programmed / ((uint64_t) opt.legacy * opt.size),
+               (double) fs->sector_erases / opt.legacy, hi);
+    }
+    printf("errors:  %u\n", errors);
+
+    HOST_Exit(errors ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+void tx_application_define(VOID *first_unused_memory) {
+    UNUSED(first_unused_memory);
+
+    if (tx_thread_create(&ctrl, "kvbench", control, 0, ctrl_stack, KVBENCH_STACK_SIZE, KVBENCH_PRIO, KVBENCH_PRIO,
+                         TX_NO_TIME_SLICE, TX_AUTO_START) != TX_SUCCESS) {
+        Error_Handler();
+    }
+}
+
+static uint8_t option(const char *arg, const char *name, uint32_t *value) {
+    size_t len = strlen(name);
+    if (strncmp(arg, name, len) || arg[len] != '=') {
+        return 0;
+    }
+    *value = strtoul(arg + len + 1, NULL, 0);
+    return 1;
+}
+
+static void usage(const char *arg) {
+    fprintf(stderr,
+            "kvbench: unknown option %s\n"
+            "  --keys=N       keys, up to %u\n"
+            "  --cold=N       first N keys are written once\n"
+            "  --size=B       value size, up to %u\n"
+            "  --updates=N    updates of hot keys\n"
+            "  --period=MS    time between updates\n"
+            "  --del=N        every N-th update deletes the key, 0 - none\n"
+            "  --legacy=N     updates of the FLASH_Erase+FLASH_Write run, 0 - none\n"
+            "  --seed=N       seed of key order\n"
+            "  --log=N        log level, 0 debug .. 4 quiet\n",
+            arg, KV_KEYS_MAX, KV_VALUE_MAX);
+    HOST_Exit(EXIT_FAILURE);
+}
+
+int main(int argc, char **argv) {
+    argc = HOST_SimInit(argc, argv);
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        if (!option(arg, "--keys", &opt.keys) && !option(arg, "--cold", &opt.cold) &&
+            !option(arg, "--size", &opt.size) && !option(arg, "--updates", &opt.updates) &&
+            !option(arg, "--period", &opt.period) && !option(arg, "--del", &opt.del) &&
+            !option(arg, "--legacy", &opt.legacy) && !option(arg, "--seed", &opt.seed) &&
+            !option(arg, "--log", &opt.log)) {
+            usage(arg);
+        }
+    }
+    if (opt.keys == 0 || opt.keys > KV_KEYS_MAX || opt.cold >= opt.keys || opt.size == 0 ||
+        opt.size > KV_VALUE_MAX || opt.keys * opt.size > LEGACY_ADDR) {
+        usage("(out of range)");
+    }
+    SIM_LogLevel = opt.log;
+    rnd = opt.seed * 0x9E3779B97F4A7C15ULL + 1U;
+
+    if ((lat = calloc(opt.keys + opt.updates, sizeof(*lat))) == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    HAL_Init();
+    MX_OCTOSPI1_Init();
+    SIM_IS25L_Attach(&FLASH_QSPI, 1);
+    tx_kernel_enter();
+
+    return EXIT_FAILURE;
+}
+
+void HAL_OSPI_StatusMatchCallback(OSPI_HandleTypeDef *hospi) {
+    if (hospi == &FLASH_QSPI) {
+        IS25L_StatusMatchCallback();
+    }
+}
+
+void HAL_OSPI_RxCpltCallback(OSPI_HandleTypeDef *hospi) {
+    if (hospi == &FLASH_QSPI) {
+        IS25L_RxCompleteCallback();
+    }
+}
+
+void HAL_OSPI_TxCpltCallback(OSPI_HandleTypeDef *hospi) {
+    if (hospi == &FLASH_QSPI) {
+        IS25L_TxCompleteCallback();
+    }
+}
+
+void HAL_OSPI_CmdCpltCallback(OSPI_HandleTypeDef *hospi) {
+    if (hospi == &FLASH_QSPI) {
+        IS25L_CmdCompleteCallback();
+    }
+}
+
+void Error_Handler(void) {
+    fprintf(stderr, "Error_Handler at %llu ns\n", (unsigned long long) HOST_Now());
+    HOST_Exit(EXIT_FAILURE);
+}
@@ -0,0 +1,229 @@
+/**
+ * @file sim_is25l.c
+ * @brief IS25LP032D NOR flash model
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#include <string.h>
+
+#include "sim_is25l.h"
+
+#define STATUS_WIP (0x01U)
+#define STATUS_WEL (0x02U)
+#define STATUS_QE  (0x40U)
+#define STATUS_NV  (0xFCU) /* bits kept by WRSR */
+#define STATUS_BP  (0x3CU) /* block protection */
+
+#define BLOCK_SIZE (64U * 1024U)
+
+/* typical timings of the datasheet, ns */
+#define T_PP  (200ULL * HOST_NS_PER_US)
+#define T_W   (2ULL * HOST_NS_PER_MS)
+#define T_SE  (45ULL * HOST_NS_PER_MS)
+#define T_BE1 (140ULL * HOST_NS_PER_MS)
+#define T_BE2 (170ULL * HOST_NS_PER_MS)
+#define T_CE  (10ULL * HOST_NS_PER_S)
+
+#define ID_MANUFACTURER (0x9DU)
+#define ID_TYPE         (0x60U)
+#define ID_CAPACITY     (0x16U)
+
+typedef struct {
+    host_ospi_dev_t   dev;
+    uint8_t           status;
+    uint64_t          busy_until;
+    sim_is25l_stats_t stats;
+    uint8_t           mem[SIM_IS25L_SIZE];
+} sim_is25l_t;
+
+static sim_is25l_t flash;
+
+static uint8_t busy(void) {
+    return HOST_Now() < flash.busy_until;
+}
+
+static void startOp(uint64_t duration) {
+    flash.status &= ~STATUS_WEL;
+    flash.busy_until = HOST_Now() + duration;
+    flash.stats.busy_ns += duration;
+}
+
+/* blocks the BP bits protect with TBS of the default top: the first and the one after the last */
+static const uint8_t protection[16][2] = {
+    { 0, 0 },  { 63, 64 }, { 62, 64 }, { 60, 64 }, { 56, 64 }, { 48, 64 }, { 32, 64 }, { 0, 64 },
+    { 0, 64 }, { 0, 32 },  { 0, 16 },  { 0, 8 },   { 0, 4 },   { 0, 2 },   { 0, 1 },   { 0, 64 },
+};
+
+/* programs and erases touching a protected block are ignored */
+static uint8_t writable(uint32_t addr, uint32_t size) {
+    const uint8_t *blocks = protection[(flash.status & STATUS_BP) >> 2];
+
+    addr &= ~(size - 1) & (SIM_IS25L_SIZE - 1);
+    if (addr / BLOCK_SIZE < blocks[1] && blocks[0] <= (addr + size - 1) / BLOCK_SIZE) {
+        flash.status &= ~STATUS_WEL;
+        return 0;
+    }
+    return 1;
+}
+
+static void erase(uint32_t addr, uint32_t size, uint64_t duration) {
+    addr &= ~(size - 1) & (SIM_IS25L_SIZE - 1);
+    memset(flash.mem + addr, 0xFF, size);
+    for (uint32_t s = addr / SIM_IS25L_SECTOR_SIZE; s < (addr + size) / SIM_IS25L_SECTOR_SIZE; ++s) {
+        ++flash.stats.sector_wear[s];
+    }
+    startOp(duration);
+}
+
+/* data wraps inside the page like on the chip */
+static void program(uint32_t addr, const uint8_t *data, uint32_t size) {
+    uint32_t page = addr & ~(SIM_IS25L_PAGE_SIZE - 1) & (SIM_IS25L_SIZE - 1);
+
+    if (size > SIM_IS25L_PAGE_SIZE) {
+        data += size - SIM_IS25L_PAGE_SIZE;
+        size = SIM_IS25L_PAGE_SIZE;
+    }
+    for (uint32_t i = 0; i < size; ++i) {
+        flash.mem[page + ((addr + i) & (SIM_IS25L_PAGE_SIZE - 1))] &= data[i];
+    }
+    ++flash.stats.page_programs;
+    flash.stats.bytes_programmed += size;
+    startOp(T_PP);
+}
+
+static void read(uint32_t addr, uint8_t *rx, uint32_t size) {
+    for (uint32_t i = 0; i < size; ++i) {
+        rx[i] = flash.mem[(addr + i) & (SIM_IS25L_SIZE - 1)];
+    }
+    flash.stats.bytes_read += size;
+}
+
+static void exec(host_ospi_dev_t *dev, const OSPI_RegularCmdTypeDef *cmd, const uint8_t *tx, uint8_t *rx) {
+    uint8_t quad = (cmd->DataMode == HAL_OSPI_DATA_4_LINES) || (cmd->AddressMode == HAL_OSPI_ADDRESS_4_LINES);
+
+    (void) dev;
+    if (cmd->Instruction == 0x05) {
+        if (rx != NULL) {
+            memset(rx, flash.status | (busy() ? STATUS_WIP : 0), cmd->NbData);
+        }
+        return;
+    }
+    /* the chip ignores everything but RDSR while busy, quad commands need QE */
+    if (busy() || (quad && !(flash.status & STATUS_QE))) {
+        return;
+    }
+
+    switch (cmd->Instruction) {
+        case 0x9F:
+            if (rx != NULL) {
+                const uint8_t id[] = { ID_MANUFACTURER, ID_TYPE, ID_CAPACITY };
+                memcpy(rx, id, (cmd->NbData < sizeof(id)) ? cmd->NbData : sizeof(id));
+            }
+            break;
+        case 0x03:
+        case 0x0B:
+        case 0x6B:
+        case 0xEB:
+            if (rx != NULL) {
+                read(cmd->Address, rx, cmd->NbData);
+            }
+            break;
+        case 0x06:
+            flash.status |= STATUS_WEL;
+            break;
+        case 0x04:
+            flash.status &= ~STATUS_WEL;
+            break;
+        case 0x01:
+            if ((flash.status & STATUS_WEL) && tx != NULL && cmd->NbData) {
+                flash.status = (flash.status & ~STATUS_NV) | (tx[0] & STATUS_NV);
+                startOp(T_W);
+            }
+            break;
+        case 0x02:
+        case 0x32:
+        case 0x38:
+            if ((flash.status & STATUS_WEL) && tx != NULL && cmd->NbData &&
+                writable(cmd->Address, SIM_IS25L_PAGE_SIZE)) {
+                program(cmd->Address, tx, cmd->NbData);
+            }
+            break;
+        case 0x20:
+        case 0xD7:
+            if ((flash.status & STATUS_WEL) && writable(cmd->Address, SIM_IS25L_SECTOR_SIZE)) {
+                ++flash.stats.sector_erases;
+                erase(cmd->Address, SIM_IS25L_SECTOR_SIZE, T_SE);
+            }
+            break;
+        case 0x52:
+            if ((flash.status & STATUS_WEL) && writable(cmd->Address, 32U * 1024U)) {
+                ++flash.stats.block_erases;
+                erase(cmd->Address, 32U * 1024U, T_BE1);
+            }
+            break;
+        case 0xD8:
+            if ((flash.status & STATUS_WEL) && writable(cmd->Address, BLOCK_SIZE)) {
+                ++flash.stats.block_erases;
+                erase(cmd->Address, BLOCK_SIZE, T_BE2);
+            }
+            break;
+        case 0x60:
+        case 0xC7:
+            if ((flash.status & STATUS_WEL) && writable(0, SIM_IS25L_SIZE)) {
+                ++flash.stats.chip_erases;
+                erase(0, SIM_IS25L_SIZE, T_CE);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static uint64_t nextChange(host_ospi_dev_t *dev) {
+    (void) dev;
+    return busy() ? flash.busy_until : 0;
+}
+
+/* reads of a busy chip return its status, the map is taken only by a read the chip accepts */
+static uint8_t *map(host_ospi_dev_t *dev, const OSPI_RegularCmdTypeDef *cmd) {
+    uint8_t quad = (cmd->DataMode == HAL_OSPI_DATA_4_LINES) || (cmd->AddressMode == HAL_OSPI_ADDRESS_4_LINES);
+
+    (void) dev;
+    if (busy() || (quad && !(flash.status & STATUS_QE))) {
+        return NULL;
+    }
+    switch (cmd->Instruction) {
+        case 0x03:
+        case 0x0B:
+        case 0x6B:
+        case 0xEB:
+            ++flash.stats.maps;
+            return flash.mem;
+        default:
+            return NULL;
+    }
+}
+
+void SIM_IS25L_Attach(OSPI_HandleTypeDef *hospi, uint8_t qe) {
+    flash.dev.exec = exec;
+    flash.dev.next_change = nextChange;
+    flash.dev.map = map;
+    flash.status = qe ? STATUS_QE : 0;
+    memset(flash.mem, 0xFF, sizeof(flash.mem));
+    HOST_OSPI_Attach(hospi, &flash.dev);
+}
+
+uint8_t *SIM_IS25L_Memory(void) {
+    return flash.mem;
+}
+
+const sim_is25l_stats_t *SIM_IS25L_Stats(void) {
+    return &flash.stats;
+}
+
+void SIM_IS25L_ResetStats(void) {
+    memset(&flash.stats, 0, sizeof(flash.stats));
+}
@@ -0,0 +1,67 @@
+/**
+ * @file sim_log.c
+ * @brief loglib for simulator tools of the HOST target.
+ *        Messages go straight to stderr with virtual time stamps,
+ *        there is no console thread and no UART, so terminal commands
+ *        of modules are not registered.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+
+#include "loglib.h"
+#include "parser.h"
+#include "host_sim.h"
+
+log_type_t SIM_LogLevel = LOG_T_WARN;
+
+static const char *logtypeTable[LOG_TYPES_MAX] = { "[DEBUG]", "[INFO]", "[WARN]", "[ERROR]" };
+
+log_state_t LOG_Init(void *memoryPoolPtr) {
+    (void) memoryPoolPtr;
+    return LOG_S_OK;
+}
+
+log_state_t LOG_Printf(char *logMessage, ...) {
+    va_list arg;
+
+    va_start(arg, logMessage);
+    vfprintf(stderr, logMessage, arg);
+    va_end(arg);
+    return LOG_S_OK;
+}
+
+log_state_t LOG_Put(log_type_t logType, log_module_t logModule, char *logMessage, ...) {
+    uint64_t now = HOST_Now();
+    va_list  arg;
+
+    (void) logModule;
+    if (logType < SIM_LogLevel) {
+        return LOG_S_ERR;
+    }
+    fprintf(stderr, "%llu.%06llu %s: ", (unsigned long long) (now / HOST_NS_PER_S),
+            (unsigned long long) (now % HOST_NS_PER_S / HOST_NS_PER_US), logtypeTable[logType]);
+    va_start(arg, logMessage);
+    vfprintf(stderr, logMessage, arg);
+    va_end(arg);
+    fputc('\n', stderr);
+    return LOG_S_OK;
+}
+
+void LOG_Setup(uint8_t argc, void **argv) {
+    (void) argc;
+    (void) argv;
+}
+
+void LOG_TxCpltCallback(void) {
+}
+
+parser_retVal_t PARSER_AddCommand(void (*userFunc)(uint8_t, void **), char *argString) {
+    (void) userFunc;
+    (void) argString;
+    return PARSER_ERR;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file sim_node.c
+ * @brief Board of a simulated GEODE node, linked into every node copy
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#include "main.h"
+#include "host_ll_utils.h"
+#include "sim_node.h"
+
+extern sim_radio_t     SIM_RFM_Radio;
+extern const rfm_ops_t SIM_RFM_Ops;
+
+TIM_HandleTypeDef htim7;
+uint32_t          HOST_UID[3];
+
+static TIM_TypeDef tim7 = { .width = 16 };
+
+/* MX_TIM7_Init() of DEVBOARD */
+static void init(uint16_t id, int32_t ppm) {
+    HOST_UID[0] = SIM_NODE_UID0(id);
+    HOST_UID[1] = 0x31325111U;
+    HOST_UID[2] = 0x34383730U;
+
+    htim7.Instance = &tim7;
+    htim7.Init.Prescaler = 99;
+    htim7.Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim7.Init.Period = 63999;
+    htim7.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+    htim7.ppm = ppm;
+    if (HAL_TIM_Base_Init(&htim7) != HAL_OK) {
+        Error_Handler();
+    }
+    HAL_TIM_RegisterCallback(&htim7, HAL_TIM_CB_PERIOD_ELAPSED, GOD_TIM_Callback);
+
+    SIM_RFM_Radio.id = id;
+}
+
+static god_stat_t godInit(void) {
+    return GOD_Init(&SIM_RFM_Ops);
+}
+
+static const sim_node_t node = {
+    .init = init,
+    .god_init = godInit,
+    .set_profile = GOD_SetProfile,
+    .start = GOD_Start,
+    .relay = GOD_Relay,
+    .write = GOD_Write,
+    .printf = GOD_Printf,
+    .read = GOD_Read,
+    .send_msg = GOD_SendMsg,
+    .recv_msg = GOD_RecvMsg,
+    .announce = GOD_Announce,
+    .scan = GOD_Scan,
+    .mem_usage = GOD_MemUsage,
+    .link_stat = GOD_GetLinkStat,
+    .tx_stat = GOD_GetTxStat,
+    .radio_stat = GOD_GetRadioStat,
+    .radio = &SIM_RFM_Radio,
+    .tim = &htim7,
+    .window = GOD_WND_SIZE,
+};
+
+/* pointers, the compiler may pad the descriptor itself */
+static const sim_node_t *const nodeRef __attribute__((used, section(SIM_NODE_SECTION))) = &node;
@@ -0,0 +1,211 @@
+/**
+ * @file sim_radio.c
+ * @brief Virtual radio medium of the HOST target
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim_radio.h"
+
+#define PPM (1000000U)
+
+/* zones a radio of zone _z is heard in */
+#define REACH(_z) ((uint8_t) (7U << (_z) >> 1))
+
+typedef struct sim_pkt sim_pkt_t;
+
+struct sim_pkt {
+    host_event_t end;
+    sim_radio_t *src;
+    uint32_t     frequency;
+    uint64_t     start; /* first preamble bit */
+    uint64_t     sync;  /* first sync word bit */
+    uint64_t     stop;
+    uint8_t      sync_word[SIM_RADIO_SYNC_MAX];
+    uint8_t      sync_len;
+    uint8_t      zone;
+    uint8_t      hit; /* zones another packet overlapping it is heard in */
+    uint8_t      size;
+    uint8_t      data[SIM_RADIO_MAX_PKT];
+    sim_pkt_t   *next;
+};
+
+sim_medium_t SIM_Medium = {
+    .loss_ppm = 0,
+    .detect_bits = 20,
+    .seed = 1,
+};
+
+static sim_radio_t *radios;
+static sim_pkt_t   *air; /* packets on air and about to start */
+static uint64_t     rng;
+
+/* xorshift64*, the loss model must not disturb rand() of the firmware */
+static uint32_t random32(void) {
+    if (rng == 0) {
+        rng = SIM_Medium.seed ? SIM_Medium.seed : 1;
+    }
+    rng ^= rng >> 12;
+    rng ^= rng << 25;
+    rng ^= rng >> 27;
+    return (uint32_t) ((rng * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+static inline uint64_t bitsTime(const sim_radio_t *radio, uint32_t bits) {
+    return HOST_XFER_NS(bits, radio->baud_rate);
+}
+
+uint64_t SIM_RadioAirtime(const sim_radio_t *radio, uint8_t size) {
+    return bitsTime(radio, 8U * (radio->preamble_len + radio->sync_len + radio->variable + size + radio->crc_len));
+}
+
+void SIM_RadioAttach(sim_radio_t *radio) {
+    radio->state = SIM_RADIO_IDLE;
+    radio->since = HOST_Now();
+    radio->next = radios;
+    radios = radio;
+}
+
+/* closes accounting of the current state */
+static void leave(sim_radio_t *radio) {
+    uint64_t now = HOST_Now();
+
+    if (radio->state == SIM_RADIO_RX && now > radio->since) {
+        radio->stats.rx_ns += now - radio->since;
+    }
+    radio->state = SIM_RADIO_IDLE;
+    radio->since = now;
+}
+
+static uint8_t lost(const sim_radio_t *radio) {
+    uint32_t ppm = SIM_Medium.loss_ppm + radio->loss_ppm;
+    if (radio->frequency == SIM_Medium.jam_frequency) {
+        ppm += SIM_Medium.jam_ppm;
+    }
+    return ppm && (random32() % PPM) < ppm;
+}
+
+static void receive(sim_radio_t *radio, sim_pkt_t *pkt) {
+    if (radio->state != SIM_RADIO_RX || !(REACH(pkt->zone) & (1U << radio->zone)) ||
+        radio->frequency != pkt->frequency || radio->sync_len != pkt->sync_len ||
+        memcmp(radio->sync_word, pkt->sync_word, pkt->sync_len) ||
+        radio->since + bitsTime(radio, SIM_Medium.detect_bits) > pkt->sync) {
+        return;
+    }
+    if (pkt->hit & (1U << radio->zone)) {
+        ++radio->stats.collided;
+        return;
+    }
+    if (lost(radio)) {
+        ++radio->stats.lost;
+        return;
+    }
+    if (radio->variable ? (radio->payload_len < pkt->size) : (radio->payload_len != pkt->size)) {
+        ++radio->stats.crc;
+        return;
+    }
+    leave(radio);
+    ++radio->stats.rx;
+    radio->rx_done(radio, pkt->data, pkt->size);
+}
+
+static void unlink(sim_pkt_t *pkt) {
+    for (sim_pkt_t **p = &air; *p != NULL; p = &(*p)->next) {
+        if (*p == pkt) {
+            *p = pkt->next;
+            return;
+        }
+    }
+}
+
+static void end(host_event_t *ev) {
+    sim_pkt_t   *pkt = HOST_CONTAINER_OF(ev, sim_pkt_t, end);
+    sim_radio_t *src = pkt->src;
+
+    unlink(pkt);
+    for (sim_radio_t *radio = radios; radio != NULL; radio = radio->next) {
+        if (radio != src) {
+            receive(radio, pkt);
+        }
+    }
+    if (src != NULL) {
+        src->stats.tx_ns += pkt->stop - pkt->start;
+        leave(src);
+        src->tx_done(src);
+    }
+    free(pkt);
+}
+
+void SIM_RadioTx(sim_radio_t *radio, const uint8_t *data, uint8_t size, uint64_t delay) {
+    sim_pkt_t *pkt = calloc(1, sizeof(*pkt));
+
+    if (pkt == NULL) {
+        abort();
+    }
+    SIM_RadioIdle(radio);
+    radio->state = SIM_RADIO_TX;
+
+    pkt->src = radio;
+    pkt->frequency = radio->frequency;
+    pkt->start = HOST_Now() + delay;
+    pkt->sync = pkt->start + bitsTime(radio, 8U * radio->preamble_len);
+    pkt->stop = pkt->start + SIM_RadioAirtime(radio, size);
+    pkt->sync_len = radio->sync_len;
+    pkt->zone = radio->zone;
+    pkt->size = size;
+    memcpy(pkt->sync_word, radio->sync_word, radio->sync_len);
+    memcpy(pkt->data, data, size);
+
+    for (sim_pkt_t *other = air; other != NULL; other = other->next) {
+        if (other->frequency == pkt->frequency && other->start < pkt->stop && pkt->start < other->stop) {
+            other->hit |= REACH(pkt->zone);
+            pkt->hit |= REACH(other->zone);
+        }
+    }
+    pkt->next = air;
+    air = pkt;
+
+    ++radio->stats.tx;
+    HOST_EventInit(&pkt->end, end);
+    HOST_EventArm(&pkt->end, pkt->stop);
+}
+
+void SIM_RadioRx(sim_radio_t *radio, uint64_t delay) {
+    SIM_RadioIdle(radio);
+    radio->state = SIM_RADIO_RX;
+    radio->since = HOST_Now() + delay;
+}
+
+void SIM_RadioIdle(sim_radio_t *radio) {
+    if (radio->state == SIM_RADIO_TX) {
+        for (sim_pkt_t *pkt = air; pkt != NULL; pkt = pkt->next) {
+            if (pkt->src == radio) {
+                /* the rest of the packet is never sent, nobody gets it */
+                pkt->hit = 0xFFU;
+                pkt->stop = HOST_Now() > pkt->start ? HOST_Now() : pkt->start;
+                pkt->src = NULL;
+                radio->stats.tx_ns += pkt->stop - pkt->start;
+                HOST_EventArm(&pkt->end, pkt->stop);
+            }
+        }
+    }
+    leave(radio);
+}
+
+void SIM_RadioTotals(sim_radio_stats_t *stats) {
+    memset(stats, 0, sizeof(*stats));
+    for (sim_radio_t *radio = radios; radio != NULL; radio = radio->next) {
+        stats->tx += radio->stats.tx;
+        stats->rx += radio->stats.rx;
+        stats->collided += radio->stats.collided;
+        stats->lost += radio->stats.lost;
+        stats->crc += radio->stats.crc;
+        stats->tx_ns += radio->stats.tx_ns;
+        stats->rx_ns += radio->stats.rx_ns;
+    }
+}
@@ -0,0 +1,529 @@
+/**
+ * @file sim_rfm.c
+ * @brief Simulated RFM66A (Si4463) backend of the HOST target.
+ *        Implements rfm66a.h on top of the virtual radio medium. SPI transfers,
+ *        command responses and synthesizer tuning take the time they take with
+ *        the driver on the board, so protocol timing stays the same.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ *  (c) 2026
+ */
+
+#include <string.h>
+
+#include "main.h"
+#include "rfm66a.h"
+#include "rfm66a_defs.h"
+#include "tx_api.h"
+#include "sim_radio.h"
+#include "extm.h"
+
+/* Si4463 timings */
+#define SIM_RFM_CTS_NS     (20000U)  /* command to CTS */
+#define SIM_RFM_TUNE_NS    (100000U) /* READY to TX/RX */
+#define SIM_RFM_WAKE_NS    (440000U) /* SLEEP to READY, crystal start delays CTS */
+#define SIM_RFM_CONF_SLEEP (15U)     /* delay after every configuration command of the driver, ticks */
+#define SIM_RFM_RSSI       (-70)     /* no path loss, every packet at the same level but on SIM_Medium.fade_frequency */
+
+/* command frames of the driver, bytes */
+#define CMD_CHANGE_STATE_LEN (2U)
+#define CMD_START_RX_LEN     (8U)
+#define CMD_START_TX_LEN     (7U)
+#define CMD_SET_PROPERTY_LEN (4U)
+
+sim_radio_t SIM_RFM_Radio;
+
+static TX_SEMAPHORE semRFM;
+static TX_SEMAPHORE semRFM_SPI;
+static host_event_t spi;
+static host_event_t irq;
+
+static uint8_t rxBuf[SIM_RADIO_MAX_PKT];
+static uint8_t rxSize;
+static uint8_t txBuf[SIM_RADIO_MAX_PKT]; /* TX FIFO */
+static uint8_t txSize;
+
+/* async operation of the driver, steps are run by spi and irq events */
+typedef enum {
+    ASYNC_IDLE,
+    ASYNC_TX_CMD,
+    ASYNC_TX_CTS,
+    ASYNC_TX,
+    ASYNC_RX_CMD,
+    ASYNC_RX_CTS,
+    ASYNC_RX,
+    ASYNC_RX_DATA,
+    ASYNC_ABORT,
+} sim_async_state_t;
+
+static struct {
+    sim_async_state_t state;
+    rfm_cb_t          cb;
+    uint8_t          *data;
+    uint8_t          *size;
+} async;
+
+static rfm_stat_t syncStat;
+static uint8_t    asleep;
+
+static const uint8_t rfmconf[] = RADIO_CONFIGURATION_DATA_ARRAY;
+
+/* property shadow of the driver, bytes hold the setter values instead of the chip encoding of them, so writes are
+ * skipped and runs are sent the same way */
+#define SHADOW_PROPS (16U)
+#define SHADOW_GAP   (3U)
+#define SHADOW_RUN   (12U)
+
+static const uint8_t shadowGroup[] = { PROP_GROUP_PREAMBLE, PROP_GROUP_SYNC, PROP_GROUP_PKT, PROP_GROUP_MODEM,
+                                       PROP_GROUP_FREQ_CONTROL };
+
+static struct {
+    uint8_t  val[countof(shadowGroup)][SHADOW_PROPS];
+    uint16_t valid[countof(shadowGroup)];
+    uint16_t dirty[countof(shadowGroup)];
+    uint8_t  open;
+} shadow;
+
+static void asyncDone(rfm_stat_t stat) {
+    rfm_cb_t cb = async.cb;
+    async.state = ASYNC_IDLE;
+    cb(stat);
+}
+
+static void armSpi(uint16_t size) {
+    HOST_EventArmIn(&spi, HOST_Latency.dma_ns + HOST_XFER_NS(8U * size, HOST_Latency.spi_hz) + HOST_Latency.irq_ns);
+}
+
+static void armCts(void) {
+    HOST_EventArmIn(&irq, SIM_RFM_CTS_NS + HOST_Latency.exti_ns + HOST_Latency.irq_ns);
+}
+
+static void spiDone(host_event_t *ev) {
+    UNUSED(ev);
+    switch (async.state) {
+        case ASYNC_TX_CMD:
+            async.state = ASYNC_TX_CTS;
+            armCts();
+            break;
+        case ASYNC_RX_CMD:
+            async.state = ASYNC_RX_CTS;
+            armCts();
+            break;
+        case ASYNC_ABORT:
+            armCts();
+            break;
+        case ASYNC_RX_DATA:
+            *async.size = (SIM_RFM_Radio.variable) ? (rxSize) : (SIM_RFM_Radio.payload_len);
+            memcpy(async.data, rxBuf, *async.size);
+            asyncDone(RFM_OK);
+            break;
+        default:
+            tx_semaphore_put(&semRFM_SPI);
+            break;
+    }
+}
+
+static void irqDone(host_event_t *ev) {
+    UNUSED(ev);
+    switch (async.state) {
+        case ASYNC_TX_CTS:
+            async.state = ASYNC_TX;
+            SIM_RadioTx(&SIM_RFM_Radio, txBuf, txSize, SIM_RFM_TUNE_NS);
+            break;
+        case ASYNC_RX_CTS:
+            async.state = ASYNC_RX;
+            SIM_RadioRx(&SIM_RFM_Radio, SIM_RFM_TUNE_NS);
+            break;
+        case ASYNC_TX:
+            asyncDone(RFM_OK);
+            break;
+        case ASYNC_RX:
+            async.state = ASYNC_RX_DATA;
+            armSpi(1 + SIM_RFM_Radio.variable + ((SIM_RFM_Radio.variable) ? (rxSize) : (SIM_RFM_Radio.payload_len)));
+            break;
+        case ASYNC_ABORT:
+            async.state = ASYNC_IDLE;
+            tx_semaphore_put(&semRFM);
+            break;
+        default:
+            tx_semaphore_put(&semRFM);
+            break;
+    }
+}
+
+static void syncCb(rfm_stat_t stat) {
+    syncStat = stat;
+    tx_semaphore_put(&semRFM);
+}
+
+/* SPI DMA transfer of the driver, NSS toggling included */
+static rfm_stat_t spiXch(uint16_t size) {
+    armSpi(size);
+    tx_semaphore_get(&semRFM_SPI, TX_WAIT_FOREVER);
+    return RFM_OK;
+}
+
+/* command with CTS */
+static rfm_stat_t command(uint16_t size) {
+    spiXch(size);
+    armCts();
+    tx_semaphore_get(&semRFM, TX_WAIT_FOREVER);
+    return RFM_OK;
+}
+
+static rfm_stat_t shadowFlush(void) {
+    for (uint8_t g = 0; g < countof(shadowGroup); ++g) {
+        while (shadow.dirty[g]) {
+            const uint8_t first = ctz(shadow.dirty[g]);
+            uint8_t       last = first;
+            for (uint8_t i = first + 1; i < SHADOW_PROPS && i - first < SHADOW_RUN; ++i) {
+                if (shadow.dirty[g] & (1U << i)) {
+                    last = i;
+                } else if (!(shadow.valid[g] & (1U << i)) || i - last > SHADOW_GAP) {
+                    break;
+                }
+            }
+            shadow.dirty[g] &= ~(((1U << (last + 1U)) - 1U) & ~((1U << first) - 1U));
+            command(CMD_SET_PROPERTY_LEN + last - first + 1U);
+        }
+    }
+    return RFM_OK;
+}
+
+/* value goes little endian to num properties */
+static rfm_stat_t setProp(uint8_t group, uint8_t offset, uint64_t value, uint8_t num) {
+    uint8_t g = 0;
+    while (shadowGroup[g] != group) {
+        ++g;
+    }
+    for (uint8_t i = 0; i < num; ++i, value >>= 8) {
+        const uint16_t bit = 1U << (offset + i);
+        if (!(shadow.valid[g] & bit) || shadow.val[g][offset + i] != (uint8_t) value) {
+            shadow.val[g][offset + i] = (uint8_t) value;
+            shadow.valid[g] |= bit;
+            shadow.dirty[g] |= bit;
+        }
+    }
+    return (shadow.open) ? (RFM_OK) : (shadowFlush());
+}
+
+static void txDone(sim_radio_t *radio) {
+    UNUSED(radio);
+    HOST_EventArmIn(&irq, HOST_Latency.exti_ns + HOST_Latency.irq_ns);
+}
+
+static void rxDone(sim_radio_t *radio, const uint8_t *data, uint8_t size) {
+    UNUSED(radio);
+    memcpy(rxBuf, data, size);
+    rxSize = size;
+    HOST_EventArmIn(&irq, HOST_Latency.exti_ns + HOST_Latency.irq_ns);
+}
+
+rfm_stat_t RFM_Init() {
+    if ((tx_semaphore_create(&semRFM, NULL, 0) != TX_SUCCESS) ||
+        (tx_semaphore_create(&semRFM_SPI, NULL, 0) != TX_SUCCESS)) {
+        return RFM_ERR;
+    }
+    memset(&shadow, 0, sizeof(shadow));
+    HOST_EventInit(&spi, spiDone);
+    HOST_EventInit(&irq, irqDone);
+
+    SIM_RFM_Radio.tx_done = txDone;
+    SIM_RFM_Radio.rx_done = rxDone;
+    SIM_RFM_Radio.payload_len = 0x12;
+    SIM_RadioAttach(&SIM_RFM_Radio);
+
+    for (const uint8_t *ptr = rfmconf; *ptr; ptr += *ptr + 1) {
+        command(*ptr);
+        tx_thread_sleep(SIM_RFM_CONF_SLEEP);
+    }
+    return RFM_OK;
+}
+
+rfm_stat_t RFM_Config(rfm_config_t *config) {
+    rfm_stat_t stat = RFM_OK;
+
+    stat |= RFM_ConfigBegin();
+    stat |= RFM_SetFrequency(config->frequency);
+    stat |= RFM_SetDeviation(config->deviation);
+    stat |= (config->variablePkt) ? (RFM_SetVarPktMode()) : (RFM_SetPayloadLen(config->payload_len));
+    stat |= RFM_SetBaudRate(config->baud_rate);
+    stat |= RFM_SetPreambleLen(config->preamble_len);
+    stat |= RFM_SetPayloadLen(config->payload_len);
+    stat |= RFM_SetModulation(config->modulation);
+    stat |= RFM_SetSyncWord(config->sync_word, config->sync_len);
+    stat |= RFM_SelectCRC(config->crc);
+    stat |= RFM_ConfigCommit();
+
+    return stat;
+}
+
+rfm_stat_t RFM_ConfigBegin(void) {
+    ++shadow.open;
+    return RFM_OK;
+}
+
+rfm_stat_t RFM_ConfigCommit(void) {
+    if (!shadow.open) {
+        return RFM_ERR;
+    }
+    return (--shadow.open) ? (RFM_OK) : (shadowFlush());
+}
+
+rfm_stat_t RFM_SetFrequency(uint32_t frequency) {
+    SIM_RFM_Radio.frequency = frequency;
+    return setProp(PROP_GROUP_FREQ_CONTROL, 0x00, frequency, 4);
+}
+
+rfm_stat_t RFM_SetDeviation(uint32_t deviation) {
+    return setProp(PROP_GROUP_MODEM, 0x0A, deviation, 3);
+}
+
+rfm_stat_t RFM_SetBaudRate(uint32_t baud_rate) {
+    SIM_RFM_Radio.baud_rate = baud_rate;
+    return setProp(PROP_GROUP_MODEM, 0x03, baud_rate, 7);
+}
+
+rfm_stat_t RFM_SetModulation(rfm_mod_t mod) {
+    return setProp(PROP_GROUP_MODEM, 0x00, mod & 0x07, 1);
+}
+
+rfm_stat_t RFM_SetPayloadLen(uint8_t payload_len) {
+    SIM_RFM_Radio.payload_len = payload_len;
+    return setProp(PROP_GROUP_PKT, 0x0C, payload_len | ((uint32_t) payload_len << 16), 3);
+}
+
+rfm_stat_t RFM_SetPreambleLen(uint8_t len) {
+    SIM_RFM_Radio.preamble_len = len;
+    return setProp(PROP_GROUP_PREAMBLE, 0x00, len, 1);
+}
+
+rfm_stat_t RFM_SelectCRC(rfm_crc_t crc) {
+    switch (crc) {
+        case NO_CRC:
+            SIM_RFM_Radio.crc_len = 0;
+            break;
+        case ITU_T_CRC8:
+            SIM_RFM_Radio.crc_len = 1;
+            break;
+        case KOOPMAN:
+        case IEEE_802_3:
+        case CASTAGNOLI:
+            SIM_RFM_Radio.crc_len = 4;
+            break;
+        default:
+            SIM_RFM_Radio.crc_len = 2;
+            break;
+    }
+    return setProp(PROP_GROUP_PKT, 0x00, crc & 0x0f, 1);
+}
+
+rfm_stat_t RFM_SetSyncWord(const uint8_t *sync_word, uint8_t sync_len) {
+    if (sync_len == 0 || sync_len > SIM_RADIO_SYNC_MAX) {
+        return RFM_ERR;
+    }
+    memcpy(SIM_RFM_Radio.sync_word, sync_word, sync_len);
+    SIM_RFM_Radio.sync_len = sync_len;
+    uint64_t value = (sync_len - 1) & 0x03;
+    for (uint8_t i = 0; i < sync_len; ++i) {
+        value |= (uint64_t) sync_word[i] << (8 * (i + 1));
+    }
+    return setProp(PROP_GROUP_SYNC, 0x00, value, 5);
+}
+
+rfm_stat_t RFM_SetVarPktMode() {
+    SIM_RFM_Radio.variable = 1;
+    return setProp(PROP_GROUP_PKT, 0x06, 0x010A0000, 4);
+}
+
+rfm_stat_t RFM_TxLoad(const void *hdr, uint8_t hdr_size, const void *data, uint8_t size) {
+    if ((hdr_size + size > SIM_RADIO_MAX_PKT) || (async.state != ASYNC_IDLE)) {
+        return RFM_ERR;
+    }
+    if (hdr_size) {
+        memcpy(txBuf, hdr, hdr_size);
+    }
+    if (size) {
+        memcpy(txBuf + hdr_size, data, size);
+    }
+    txSize = hdr_size + size;
+    spiXch(1 + SIM_RFM_Radio.variable + txSize); /* WRITE_TX_FIFO */
+
+    return RFM_OK;
+}
+
+static rfm_stat_t asyncStart(sim_async_state_t state, uint16_t size, rfm_cb_t cb) {
+    if (async.state != ASYNC_IDLE) {
+        return RFM_ERR;
+    }
+    async.state = state;
+    async.cb = cb;
+    armSpi(size);
+
+    return RFM_OK;
+}
+
+rfm_stat_t RFM_TxAsync(rfm_cb_t cb) {
+    return asyncStart(ASYNC_TX_CMD, CMD_START_TX_LEN, cb);
+}
+
+rfm_stat_t RFM_TxStart(void) {
+    rfm_stat_t stat = RFM_TxAsync(syncCb);
+    if (stat != RFM_OK) {
+        return stat;
+    }
+    tx_semaphore_get(&semRFM, TX_WAIT_FOREVER);
+
+    return syncStat;
+}
+
+rfm_stat_t RFM_Tx(const void *data, uint8_t size) {
+    return RFM_TxLoad(data, size, NULL, 0) | RFM_TxStart();
+}
+
+rfm_stat_t RFM_RxAsync(void *data, uint8_t *size, rfm_cb_t cb) {
+    async.data = data;
+    async.size = size;
+    return asyncStart(ASYNC_RX_CMD, CMD_START_RX_LEN, cb);
+}
+
+rfm_stat_t RFM_RxAbort(void) {
+    switch (async.state) {
+        case ASYNC_RX:
+            if (HOST_EventArmed(&irq)) {
+                /* packet is in, its interrupt is pending */
+                return RFM_ERR;
+            }
+            async.state = ASYNC_IDLE;
+            SIM_RadioIdle(&SIM_RFM_Radio);
+            break;
+        case ASYNC_RX_CMD:
+        case ASYNC_RX_CTS:
+            async.state = ASYNC_ABORT;
+            tx_semaphore_get(&semRFM, TX_WAIT_FOREVER);
+            break;
+        case ASYNC_IDLE:
+            return RFM_OK;
+        default:
+            return RFM_ERR;
+    }
+    return RFM_SetMode(RFM_MODE_READY);
+}
+
+rfm_stat_t RFM_Rx(void *data, uint8_t *size, uint32_t timeout) {
+    rfm_stat_t stat = RFM_RxAsync(data, size, syncCb);
+    if (stat != RFM_OK) {
+        return stat;
+    }
+    if (tx_semaphore_get(&semRFM, timeout) != TX_SUCCESS) {
+        if (RFM_RxAbort() != RFM_ERR) {
+            return RFM_ERR_TIMEOUT;
+        }
+        /* packet came in right before the timeout */
+        tx_semaphore_get(&semRFM, TX_WAIT_FOREVER);
+    }
+
+    return syncStat;
+}
+
+rfm_stat_t RFM_SetMode(rfm_mode_t mode) {
+    if (asleep && mode != RFM_MODE_SLEEP) {
+        asleep = 0;
+        spiXch(CMD_CHANGE_STATE_LEN);
+        HOST_EventArmIn(&irq, SIM_RFM_WAKE_NS + HOST_Latency.exti_ns + HOST_Latency.irq_ns);
+        tx_semaphore_get(&semRFM, TX_WAIT_FOREVER);
+    } else {
+        command(CMD_CHANGE_STATE_LEN);
+    }
+    switch (mode) {
+        case RFM_MODE_SLEEP:
+            asleep = 1;
+            SIM_RadioIdle(&SIM_RFM_Radio);
+            break;
+        case RFM_MODE_RX:
+            SIM_RadioRx(&SIM_RFM_Radio, SIM_RFM_TUNE_NS);
+            break;
+        case RFM_MODE_TX:
+        case RFM_MODE_TX_TUNE:
+        case RFM_MODE_RX_TUNE:
+            break;
+        default:
+            SIM_RadioIdle(&SIM_RFM_Radio);
+            break;
+    }
+    return RFM_OK;
+}
+
+rfm_stat_t RFM_GetRssi(int16_t *rssi) {
+    command(2);
+    *rssi = SIM_RFM_RSSI;
+    if (SIM_RFM_Radio.frequency == SIM_Medium.fade_frequency) {
+        *rssi -= SIM_Medium.fade_db;
+    }
+    return spiXch(6); /* READ_CMD_BUFF and the response */
+}
+
+rfm_stat_t RFM_GetChipStatus(uint8_t *status) {
+    spiXch(1);
+    memset(status, 0, 5);
+    return command(CMD_CHANGE_STATE_LEN);
+}
+
+void RFM_SPI_SemRelease() {
+    tx_semaphore_put(&semRFM_SPI);
+}
+
+void RFM_SemRelease() {
+    tx_semaphore_put(&semRFM);
+}
+
+static rfm_stat_t opsConfig(const rfm_settings_t *set) {
+    rfm_config_t config = {
+        .frequency = set->frequency,
+        .deviation = set->deviation,
+        .baud_rate = set->baud_rate,
+        .preamble_len = set->preamble_len,
+        .payload_len = set->payload_len,
+        .sync_len = set->sync_len,
+        .modulation = set->gfsk ? RFM_MOD_2GFSK : RFM_MOD_2FSK,
+        .crc = CCITT_16,
+        .variablePkt = set->variable,
+    };
+    memcpy(config.sync_word, set->sync_word, set->sync_len);
+    return RFM_Config(&config);
+}
+
+/* medium has no RX filter */
+static rfm_stat_t opsSetRate(uint32_t baud_rate, uint32_t deviation, uint32_t bandwidth) {
+    UNUSED(bandwidth);
+    return RFM_ConfigBegin() | RFM_SetBaudRate(baud_rate) | RFM_SetDeviation(deviation) | RFM_ConfigCommit();
+}
+
+static rfm_stat_t opsStandby(void) {
+    return RFM_SetMode(RFM_MODE_READY);
+}
+
+static rfm_stat_t opsSleep(void) {
+    return RFM_SetMode(RFM_MODE_SLEEP);
+}
+
+const rfm_ops_t SIM_RFM_Ops = {
+    .init = RFM_Init,
+    .config = opsConfig,
+    .set_freq = RFM_SetFrequency,
+    .set_sync = RFM_SetSyncWord,
+    .set_rate = opsSetRate,
+    .config_begin = RFM_ConfigBegin,
+    .config_commit = RFM_ConfigCommit,
+    .tx_load = RFM_TxLoad,
+    .tx_start = RFM_TxStart,
+    .tx_async = RFM_TxAsync,
+    .tx = RFM_Tx,
+    .rx = RFM_Rx,
+    .rx_async = RFM_RxAsync,
+    .rx_abort = RFM_RxAbort,
+    .standby = opsStandby,
+    .sleep = opsSleep,
+    .get_rssi = RFM_GetRssi,
+};
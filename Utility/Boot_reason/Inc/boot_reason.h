@@ -17,7 +17,7 @@
 #define RESET_S_POWER                (RCC_CSR_BORRSTF)
 #define RESET_S_EXTERNAL             (RCC_CSR_PINRSTF)
 
-#ifdef TARGET_DEVBOARD
+#if defined(TARGET_DEVBOARD) || defined(TARGET_HOST)
 #define RESET_S_OPTION_BYTE_LOADER (RCC_CSR_OBLRSTF)
 #endif
 
@@ -36,7 +36,7 @@ typedef struct {
     I2C_HandleTypeDef    *hi2c;
     TX_MUTEX             *mutex;
     TX_EVENT_FLAGS_GROUP *ef;
-    uint32_t              flags;
+    ULONG                 flags;
     uint32_t              inited : 1;
 } i2c_bus_t;
 